@@ -11,8 +11,8 @@
 #define SILK_IMPLEMENTATION
 #include "../../silk.h"
 
-i32 ConsoleBlit(pixel* buf) {
-    if(buf == NULL) {
+i32 ConsoleBlit(silk_canvas* canvas) {
+    if(canvas == NULL) {
         silkLogErr("Raylib: Passed a NULL parameter: buffer.");
 
         return SILK_FAILURE;
@@ -21,9 +21,9 @@ i32 ConsoleBlit(pixel* buf) {
     for(int y = 0; y < SILK_PIXELBUFFER_HEIGHT; y++) {
         for(int x = 0; x < SILK_PIXELBUFFER_WIDTH; x++) {
             pixel pix = silkGetPixel(
-                buf, 
+                (pixel*) canvas->data, 
                 (vec2i) { x, y }, 
-                SILK_PIXELBUFFER_WIDTH
+                canvas->stride / sizeof(pixel)
             );
 
             if(pix == 0x00000000) {
@@ -48,15 +48,13 @@ i32 ConsoleBlit(pixel* buf) {
 }
 
 i32 main(int argc, const string argv[]) {
-    pixel buffer[SILK_PIXELBUFFER_WIDTH * SILK_PIXELBUFFER_HEIGHT];
+    silk_canvas canvas = silkLoadCanvas((vec2i) { SILK_PIXELBUFFER_WIDTH, SILK_PIXELBUFFER_HEIGHT });
     i32 rotation = 0.0f;
 
     while(true) {
-        silkClearPixelBuffer(buffer);
+        silkClearPixelBuffer(&canvas);
         silkDrawRectPro(
-            buffer, 
-            (vec2i) { SILK_PIXELBUFFER_WIDTH, SILK_PIXELBUFFER_HEIGHT },
-            SILK_PIXELBUFFER_WIDTH, 
+            &canvas,
             (vec2i) { SILK_PIXELBUFFER_WIDTH / 2, SILK_PIXELBUFFER_HEIGHT / 2 }, 
             (vec2i) { SILK_PIXELBUFFER_HEIGHT / 4, SILK_PIXELBUFFER_HEIGHT / 4 }, 
             rotation++,
@@ -64,10 +62,12 @@ i32 main(int argc, const string argv[]) {
             0xffffffff
         );
 
-        ConsoleBlit(buffer);
+        ConsoleBlit(&canvas);
 
         usleep(1000 / 60);
     }
 
+    silkUnloadCanvas(&canvas);
+
     return 0;
 }
\ No newline at end of file
@@ -10,7 +10,7 @@
 #include "../../silk.h"
 
 int main(int argc, const string argv[]) {
-    pixel buffer[SILK_PIXELBUFFER_WIDTH * SILK_PIXELBUFFER_HEIGHT];
+    silk_canvas canvas = silkLoadCanvas((vec2i) { SILK_PIXELBUFFER_WIDTH, SILK_PIXELBUFFER_HEIGHT });
 
     i32 rotation = 45;
     
@@ -18,12 +18,10 @@ int main(int argc, const string argv[]) {
     const i32 text_size = 4;
     const i32 text_spacing = 1;
 
-    silkClearPixelBufferColor(buffer, 0xffffffff);
+    silkClearPixelBufferColor(&canvas, 0xffffffff);
 
     silkDrawRectPro(
-        buffer, 
-        (vec2i) { SILK_PIXELBUFFER_WIDTH, SILK_PIXELBUFFER_HEIGHT },
-        SILK_PIXELBUFFER_WIDTH, 
+        &canvas,
         (vec2i) {
             SILK_PIXELBUFFER_CENTER_X,
             SILK_PIXELBUFFER_CENTER_Y
@@ -41,9 +39,7 @@ int main(int argc, const string argv[]) {
     );
 
     silkDrawTextDefault(
-        buffer, 
-        (vec2i) { SILK_PIXELBUFFER_WIDTH, SILK_PIXELBUFFER_HEIGHT },
-        SILK_PIXELBUFFER_WIDTH,
+        &canvas,
         text, 
         (vec2i) { 
             SILK_PIXELBUFFER_CENTER_X - silkMeasureText(text, text_size, text_spacing).x / 2, 
@@ -54,9 +50,10 @@ int main(int argc, const string argv[]) {
         0xff000000
     );
     
-    image canvas_image = silkBufferToImage(buffer, (vec2i) { SILK_PIXELBUFFER_WIDTH, SILK_PIXELBUFFER_HEIGHT });
+    image canvas_image = silkCanvasToImage(&canvas);
     silkSaveImage("output.ppm", &canvas_image);
     silkUnloadBuffer(canvas_image.data);
+    silkUnloadCanvas(&canvas);
 
     return 0;
 }
\ No newline at end of file
@@ -48,9 +48,9 @@ i32 RaylibSetup(Texture* texture) {
     return SILK_SUCCESS;
 }
 
-i32 RaylibBlit(pixel* buffer, Texture* texture) {
-    if(buffer == NULL) {
-        silkLogErr("Raylib: Passed a NULL parameter: buffer.");
+i32 RaylibBlit(silk_canvas* canvas, Texture* texture) {
+    if(canvas == NULL) {
+        silkLogErr("Raylib: Passed a NULL parameter: canvas.");
 
         return SILK_FAILURE;
     } if(texture == NULL) {
@@ -59,7 +59,23 @@ i32 RaylibBlit(pixel* buffer, Texture* texture) {
         return SILK_FAILURE;
     }
 
-    UpdateTexture(*texture, buffer);
+    // Only the areas changed since the last frame are uploaded. 'UpdateTextureRec' expects tightly packed rows,
+    // so only the full-width rectangles of an unpadded canvas go in one call, the other ones are uploaded row by row.
+    for(i32 i = 0; i < silkGetDirtyRectCount(canvas); i++) {
+        silk_rect dirty = silkGetDirtyRect(canvas, i);
+
+        if(dirty.w == canvas->size.x && canvas->stride == canvas->size.x * (i32) sizeof(pixel)) {
+            UpdateTextureRec(*texture, (Rectangle) { 0, dirty.y, dirty.w, dirty.h }, canvas->data + dirty.y * canvas->stride);
+
+            continue;
+        }
+
+        for(i32 y = dirty.y; y < dirty.y + dirty.h; y++) {
+            UpdateTextureRec(*texture, (Rectangle) { dirty.x, y, dirty.w, 1 }, canvas->data + y * canvas->stride + dirty.x * (i32) sizeof(pixel));
+        }
+    }
+
+    silkResetDirtyRects(canvas);
 
     BeginDrawing();
     DrawTexture(*texture, 0, 0, WHITE);
@@ -82,8 +98,8 @@ i32 RaylibClose(Texture* texture) {
 }
 
 int main(int argc, const string argv[]) {
-    // Silk's pixel buffer
-    pixel buffer[SILK_PIXELBUFFER_WIDTH * SILK_PIXELBUFFER_HEIGHT] = { 0 };
+    // Silk's canvas (pixel buffer)
+    silk_canvas canvas = silkLoadCanvas((vec2i) { SILK_PIXELBUFFER_WIDTH, SILK_PIXELBUFFER_HEIGHT });
 
     i32 rotation = 0;
     
@@ -103,12 +119,10 @@ int main(int argc, const string argv[]) {
     // Update-Render loop
     while(!WindowShouldClose()) {
         // Clearing the silk's pixel buffer
-        silkClearPixelBufferColorRegion(buffer, (vec2i) { GetScreenWidth(), GetScreenHeight() }, SILK_PIXELBUFFER_WIDTH, 0xffffffff);
+        silkClearPixelBufferColorRegion(&canvas, (vec2i) { GetScreenWidth(), GetScreenHeight() }, 0xffffffff);
     
 		silkDrawPolygon(
-			buffer,
-            (vec2i) { SILK_PIXELBUFFER_WIDTH, SILK_PIXELBUFFER_HEIGHT },
-            SILK_PIXELBUFFER_WIDTH,
+			&canvas,
             (vec2i) {
                 GetScreenWidth() / 2,
                 GetScreenHeight() / 2
@@ -120,9 +134,7 @@ int main(int argc, const string argv[]) {
 		);		
 		   	
         silkDrawTextDefault(
-            buffer, 
-            (vec2i) { SILK_PIXELBUFFER_WIDTH, SILK_PIXELBUFFER_HEIGHT },
-            SILK_PIXELBUFFER_WIDTH,
+            &canvas,
             text, 
             (vec2i) { 
                 GetScreenWidth() / 2 - silkMeasureText(text, text_size, text_spacing).x / 2, 
@@ -135,13 +147,14 @@ int main(int argc, const string argv[]) {
 
         // Displaying the graphics on the window
         RaylibBlit(
-            buffer,
+            &canvas,
             &raylib_texture
         );
     }
 
     // Closing Raylib
     RaylibClose(&raylib_texture);
+    silkUnloadCanvas(&canvas);
 
     return 0;
 }
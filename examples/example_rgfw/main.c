@@ -32,6 +32,13 @@ int main(int argc, const string argv[]) {
 
     RGFW_window_setIcon(window, icon, RGFW_AREA(3, 3), 4);
     screenWidth = RGFW_getScreenSize().w;
+
+    // Silk's canvas wraps the window's own (tightly packed) buffer
+    silk_canvas canvas = silkCanvasFromBuffer(
+        window->buffer, 
+        (vec2i) { SILK_PIXELBUFFER_WIDTH, SILK_PIXELBUFFER_HEIGHT }, 
+        SILK_PIXELBUFFER_WIDTH * sizeof(pixel)
+    );
     
     // check blend status
     silkLogAlphaBlendStatus();
@@ -85,19 +92,17 @@ int main(int argc, const string argv[]) {
                         angleDir = (angleDir == 1) ? -1 : 1;
                     }
 
-                    silkDrawStar((pixel*)window->buffer, (vec2i) { SILK_PIXELBUFFER_WIDTH, SILK_PIXELBUFFER_HEIGHT }, SILK_PIXELBUFFER_WIDTH, (vec2i){window->event.point.x, window->event.point.y}, 10, 0, 8, 0xffeaddca);
+                    silkDrawStar(&canvas, (vec2i){window->event.point.x, window->event.point.y}, 10, 0, 8, 0xffeaddca);
                 }
             }
         }
 
         // Clearing the silk's pixel buffer
-        silkClearPixelBufferColor((pixel*)window->buffer, 0xff333333);
+        silkClearPixelBufferColor(&canvas, 0xff333333);
         
         // Draw the rectangle at the middle of the screen
         silkDrawRectPro(
-            (pixel*)window->buffer, 
-            (vec2i) { SILK_PIXELBUFFER_WIDTH, SILK_PIXELBUFFER_HEIGHT },
-            SILK_PIXELBUFFER_WIDTH,
+            &canvas, 
             (vec2i) { (window->r.w / 2), SILK_PIXELBUFFER_CENTER_Y}, 
             (vec2i) { 128, 128 }, 
             angle,
@@ -106,15 +111,15 @@ int main(int argc, const string argv[]) {
         );
         angle += angleDir;
 
-        silkDrawCircle((pixel*)window->buffer, (vec2i) { SILK_PIXELBUFFER_WIDTH, SILK_PIXELBUFFER_HEIGHT }, SILK_PIXELBUFFER_WIDTH, circlePoint, 20, 0xff00ff00);
+        silkDrawCircle(&canvas, circlePoint, 20, 0xff00ff00);
 
         RGFW_vector v = RGFW_window_getMousePoint(window);
         if (star == 1) {
-            silkDrawStar((pixel*)window->buffer, (vec2i) { SILK_PIXELBUFFER_WIDTH, SILK_PIXELBUFFER_HEIGHT }, SILK_PIXELBUFFER_WIDTH, (vec2i){v.x, v.y}, 10, 0, 5, 0xff00FFFF);
+            silkDrawStar(&canvas, (vec2i){v.x, v.y}, 10, 0, 5, 0xff00FFFF);
         }
 
         if (star == 3)
-            silkDrawImage((pixel*)window->buffer, (vec2i) { SILK_PIXELBUFFER_WIDTH, SILK_PIXELBUFFER_HEIGHT }, SILK_PIXELBUFFER_WIDTH, &img, (vec2i){v.x, v.y});
+            silkDrawImage(&canvas, &img, (vec2i){v.x, v.y});
 
         if (RGFW_isPressedI(window, RGFW_Up))
             circlePoint.y--;
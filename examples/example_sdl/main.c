@@ -60,28 +60,15 @@ if(SDL_Init(SDL_INIT_EVERYTHING) != 0) {
 
     silkLogInfo("SDL: Renderer created successfully.");
 
-#if defined(SILK_BYTEORDER_LITTLE_ENDIAN)
-
-    *texture = SDL_CreateTexture(
-        *renderer, 
-        SDL_PIXELFORMAT_ABGR8888, 
-        SDL_TEXTUREACCESS_STREAMING, 
-        SILK_PIXELBUFFER_WIDTH, 
-        SILK_PIXELBUFFER_HEIGHT
-    );
-
-#elif defined (SILK_BYTEORDER_BIG_ENDIAN)
-
+    // BGRA is the native texture format of most of the renderers (the canvas is converted to it in 'SDLBlit')
     *texture = SDL_CreateTexture(
         *renderer, 
-        SDL_PIXELFORMAT_RGBA8888, 
+        SDL_PIXELFORMAT_BGRA32, 
         SDL_TEXTUREACCESS_STREAMING, 
         SILK_PIXELBUFFER_WIDTH, 
         SILK_PIXELBUFFER_HEIGHT
     );
 
-#endif
-
     if(texture == NULL) {
         silkLogErr("SDL: Couldn't create an SDL Texture.");
         SDL_DestroyRenderer(*renderer);
@@ -95,9 +82,9 @@ if(SDL_Init(SDL_INIT_EVERYTHING) != 0) {
     return SILK_SUCCESS;
 }
 
-i32 SDLBlit(pixel* buffer, SDL_Window* window, SDL_Renderer* renderer, SDL_Texture* texture) {
-    if(buffer == NULL) {
-        silkLogErr("SDL: Passed a NULL parameter: buffer.");
+i32 SDLBlit(silk_canvas* canvas, SDL_Window* window, SDL_Renderer* renderer, SDL_Texture* texture) {
+    if(canvas == NULL) {
+        silkLogErr("SDL: Passed a NULL parameter: canvas.");
 
         return SILK_FAILURE;
     } if(renderer == NULL) {
@@ -120,8 +107,8 @@ i32 SDLBlit(pixel* buffer, SDL_Window* window, SDL_Renderer* renderer, SDL_Textu
     SDL_Rect source_rect = {
         0,
         0,
-        SILK_PIXELBUFFER_WIDTH,
-        SILK_PIXELBUFFER_HEIGHT
+        canvas->size.x,
+        canvas->size.y
     };
 
     SDL_Rect destination_rect = {
@@ -131,12 +118,31 @@ i32 SDLBlit(pixel* buffer, SDL_Window* window, SDL_Renderer* renderer, SDL_Textu
         sdl_window_size.y
     };
 
-    SDL_UpdateTexture(
-        texture,
-        &destination_rect,
-        buffer, 
-        SILK_PIXELBUFFER_WIDTH * sizeof(pixel)
-    );
+    // Only the areas changed since the last frame are converted, straight into the texture memory: one pass, without any intermediate copy.
+    // Locked part of the texture starts at the dirty rectangle, so the canvas is passed from the same corner.
+    for(i32 i = 0; i < silkGetDirtyRectCount(canvas); i++) {
+        silk_rect dirty = silkGetDirtyRect(canvas, i);
+        SDL_Rect dirty_rect = { dirty.x, dirty.y, dirty.w, dirty.h };
+
+        void* texture_pixels = NULL;
+        i32 texture_pitch = 0;
+
+        if(SDL_LockTexture(texture, &dirty_rect, &texture_pixels, &texture_pitch) == 0) {
+            silkConvertPixels(
+                canvas->data + (size_t) dirty.y * canvas->stride + (size_t) dirty.x * silkPixelFormatSize(canvas->format),
+                canvas->format,
+                canvas->stride,
+                texture_pixels,
+                SILK_PIXELFORMAT_BGRA8888,
+                texture_pitch,
+                (silk_rect) { 0, 0, dirty.w, dirty.h }
+            );
+
+            SDL_UnlockTexture(texture);
+        }
+    }
+
+    silkResetDirtyRects(canvas);
     
     SDL_RenderCopyEx(
         renderer, 
@@ -177,8 +183,8 @@ i32 SDLClose(SDL_Window* window, SDL_Renderer* renderer, SDL_Texture* texture) {
 }
 
 int main(int argc, const string argv[]) {
-    // Silk's pixel buffer
-    pixel buffer[SILK_PIXELBUFFER_WIDTH * SILK_PIXELBUFFER_HEIGHT];
+    // Silk's canvas (pixel buffer)
+    silk_canvas canvas = silkLoadCanvas((vec2i) { SILK_PIXELBUFFER_WIDTH, SILK_PIXELBUFFER_HEIGHT });
 
     i32 rotation = 0.0f;
     
@@ -224,12 +230,10 @@ int main(int argc, const string argv[]) {
         SDL_GetWindowSize(sdl_window, &sdl_window_size.x, &sdl_window_size.y);
 
         // Clearing the silk's pixel buffer
-        silkClearPixelBufferColorRegion(buffer, sdl_window_size, SILK_PIXELBUFFER_WIDTH, 0xffffffff);
+        silkClearPixelBufferColorRegion(&canvas, sdl_window_size, 0xffffffff);
 
         silkDrawStar(
-            buffer, 
-            (vec2i) { SILK_PIXELBUFFER_WIDTH, SILK_PIXELBUFFER_HEIGHT },
-            SILK_PIXELBUFFER_WIDTH, 
+            &canvas,
             (vec2i) {
                 sdl_window_size.x / 2,
                 sdl_window_size.y / 2
@@ -241,9 +245,7 @@ int main(int argc, const string argv[]) {
         );
 
         silkDrawTextDefault(
-            buffer, 
-            (vec2i) { SILK_PIXELBUFFER_WIDTH, SILK_PIXELBUFFER_HEIGHT },
-            SILK_PIXELBUFFER_WIDTH,
+            &canvas,
             text, 
             (vec2i) { 
                 sdl_window_size.x / 2 - silkMeasureText(text, text_size, text_spacing).x / 2, 
@@ -256,7 +258,7 @@ int main(int argc, const string argv[]) {
 
         // Displaying the graphics on the window
         SDLBlit(
-            buffer, 
+            &canvas, 
             sdl_window,
             sdl_renderer, 
             sdl_texture
@@ -270,5 +272,7 @@ int main(int argc, const string argv[]) {
         sdl_texture
     );
 
+    silkUnloadCanvas(&canvas);
+
     return 0;
 }
\ No newline at end of file
@@ -17,7 +17,7 @@
 #include "../../silk.h"
 
 int main(int argc, const string argv[]) {
-    pixel buffer[SILK_PIXELBUFFER_WIDTH * SILK_PIXELBUFFER_HEIGHT] = { 0 };
+    silk_canvas canvas = silkLoadCanvas((vec2i) { SILK_PIXELBUFFER_WIDTH, SILK_PIXELBUFFER_HEIGHT });
 
     image img = silkLoadImage("turtle.png");
 
@@ -25,12 +25,10 @@ int main(int argc, const string argv[]) {
     const i32 text_size = 4;
     const i32 text_spacing = 1;
 
-    silkClearPixelBufferColor(buffer, 0xffffffff);
+    silkClearPixelBufferColor(&canvas, 0xffffffff);
 
     silkDrawImagePro(
-        buffer, 
-        (vec2i) { SILK_PIXELBUFFER_WIDTH, SILK_PIXELBUFFER_HEIGHT }, 
-        SILK_PIXELBUFFER_WIDTH, 
+        &canvas,
         &img, 
         (vec2i) { SILK_PIXELBUFFER_CENTER_X, SILK_PIXELBUFFER_CENTER_Y }, 
         (vec2i) { img.size.x / 4, img.size.y / 4 }, 
@@ -39,9 +37,7 @@ int main(int argc, const string argv[]) {
     );
 
     silkDrawTextDefault(
-        buffer, 
-        (vec2i) { SILK_PIXELBUFFER_WIDTH, SILK_PIXELBUFFER_HEIGHT },
-        SILK_PIXELBUFFER_WIDTH,
+        &canvas,
         text, 
         (vec2i) { 
             SILK_PIXELBUFFER_CENTER_X - silkMeasureText(text, text_size, text_spacing).x / 2, 
@@ -52,7 +48,7 @@ int main(int argc, const string argv[]) {
         0xff000000
     );
 
-    image buffer_to_image = silkBufferToImage(buffer, (vec2i) { SILK_PIXELBUFFER_WIDTH, SILK_PIXELBUFFER_HEIGHT });
+    image buffer_to_image = silkCanvasToImage(&canvas);
 
     silkSaveImage("output.png", &buffer_to_image);
     silkSaveImage("output.jpg", &buffer_to_image);
@@ -61,6 +57,7 @@ int main(int argc, const string argv[]) {
     
     silkUnloadBuffer(img.data);
     silkUnloadBuffer(buffer_to_image.data);
+    silkUnloadCanvas(&canvas);
     
     return 0;
 }
\ No newline at end of file
@@ -16,20 +16,18 @@
 #include "../../silk.h"
 
 i32 main(i32 argc, const string argv[]) {
-    // Setting-up the main pixel-buffer
-    pixel buffer[SILK_PIXELBUFFER_WIDTH * SILK_PIXELBUFFER_HEIGHT] = { 0 };
+    // Setting-up the main canvas (pixel-buffer)
+    silk_canvas canvas = silkLoadCanvas((vec2i) { SILK_PIXELBUFFER_WIDTH, SILK_PIXELBUFFER_HEIGHT });
 
     // Set-up your back-end here ...
 
     while(true) {
         // Clearing the pixel-buffer to white (0xffffffff -> #FFFFFFFF -> WHITE)
-        silkClearPixelBufferColor(buffer, 0xffffffff);
+        silkClearPixelBufferColor(&canvas, 0xffffffff);
 
         // Draw the red rectangle at the position in the middle of the pixel-buffer
         silkDrawRect(
-            buffer,                                                             // pixel-buffer
-            (vec2i) { SILK_PIXELBUFFER_WIDTH, SILK_PIXELBUFFER_HEIGHT },        // pixel-buffer size
-            SILK_PIXELBUFFER_WIDTH,                                             // pixel-buffer stride
+            &canvas,                                                            // canvas (pixel-buffer, it's size and stride)
             (vec2i) { SILK_PIXELBUFFER_CENTER_X, SILK_PIXELBUFFER_CENTER_Y },   // The position where we want to draw our red rectangle
             (vec2i) { 64, 64 },                                                 // The size of our red rectangle
             0xff0000ff                                                          // The color of our rectangle (0xff0000ff -> #FF0000FF -> RED)
@@ -40,5 +38,7 @@ i32 main(i32 argc, const string argv[]) {
 
     // ... close your back-end here
 
+    silkUnloadCanvas(&canvas);
+
     return 0;
 }
\ No newline at end of file
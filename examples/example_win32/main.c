@@ -16,8 +16,8 @@
 #define SILK_IMPLEMENTATION
 #include "../../silk.h"
 
-// NOTE(yakub): For some reason pixel buffer must be statically / globaly declared; otherwise the program won't even launch...
-static pixel buffer[SILK_PIXELBUFFER_WIDTH * SILK_PIXELBUFFER_HEIGHT] = { 0 };
+// NOTE(yakub): The canvas lives on the heap (a full-HD frame is too big for the default stack), but it's globaly declared so 'Win32Blit' can reach it
+static silk_canvas canvas = { 0 };
 static bool win32_close_window = false;
 static vec2i win32_window_size = { 0 };
 
@@ -129,8 +129,9 @@ i32 Win32Blit(HWND* window) {
 
     BITMAPINFO win32_bitmap_info = {
         .bmiHeader.biSize = sizeof(win32_bitmap_info.bmiHeader),
-        .bmiHeader.biWidth = SILK_PIXELBUFFER_WIDTH,
-        .bmiHeader.biHeight = -SILK_PIXELBUFFER_HEIGHT,
+        // DIB rows are tightly packed, so the padded canvas row is described as a wider bitmap
+        .bmiHeader.biWidth = canvas.stride / sizeof(pixel),
+        .bmiHeader.biHeight = -canvas.size.y,
         .bmiHeader.biBitCount = 32,
         .bmiHeader.biPlanes = 1,
         .bmiHeader.biCompression = BI_RGB
@@ -142,7 +143,7 @@ i32 Win32Blit(HWND* window) {
         win32_device_context, 
         0, 0, win32_window_size.x, win32_window_size.y, 
         0, 0, win32_window_size.x, win32_window_size.y, 
-        buffer, 
+        canvas.data, 
         &win32_bitmap_info, 
         DIB_RGB_COLORS, 
         SRCCOPY
@@ -168,18 +169,19 @@ i32 WINAPI wWinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, PWSTR pCmdLine
     // Setting-up Win32
     Win32CreateWindow(hInstance, nCmdShow, &win32_window);
 
+    // Setting-up the canvas (32-bit DIBs store the pixels as B, G, R bytes, so the canvas is drawn in that order right away)
+    canvas = silkLoadCanvasFormat((vec2i) { SILK_PIXELBUFFER_WIDTH, SILK_PIXELBUFFER_HEIGHT }, SILK_PIXELFORMAT_BGRA8888);
+
     // Update-Render loop
     while(!win32_close_window) {
         // Dispatching Win32 events
         Win32DispatchEvents(&win32_window, &win32_event_messages);
 
         // Clearing the silk's pixel buffer
-        silkClearPixelBufferColorRegion(buffer, win32_window_size, SILK_PIXELBUFFER_WIDTH, 0xffffffff);
+        silkClearPixelBufferColorRegion(&canvas, win32_window_size, 0xffffffff);
 
         silkDrawTriangleEquilateral(
-            buffer, 
-            (vec2i) { SILK_PIXELBUFFER_WIDTH, SILK_PIXELBUFFER_HEIGHT },
-            SILK_PIXELBUFFER_WIDTH, 
+            &canvas,
             (vec2i) {
                 win32_window_size.x / 2,
                 win32_window_size.y / 2
@@ -190,9 +192,7 @@ i32 WINAPI wWinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, PWSTR pCmdLine
         );
 
         silkDrawTextDefault(
-            buffer, 
-            (vec2i) { SILK_PIXELBUFFER_WIDTH, SILK_PIXELBUFFER_HEIGHT },
-            SILK_PIXELBUFFER_WIDTH,
+            &canvas,
             text, 
             (vec2i) { 
                 win32_window_size.x / 2 - silkMeasureText(text, text_size, text_spacing).x / 2, 
@@ -207,6 +207,8 @@ i32 WINAPI wWinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, PWSTR pCmdLine
         Win32Blit(&win32_window);
     }
 
+    silkUnloadCanvas(&canvas);
+
     return 0;
 }
 
@@ -10,7 +10,7 @@
 #define SILK_IMPLEMENTATION
 #include "../../silk.h"
 
-i32 X11Setup(pixel* buf, Display** display, Window* root, Window* window, XWindowAttributes* attributes, GC* graphics_context, XImage** image, Atom* message_delete_window) {
+i32 X11Setup(silk_canvas* canvas, Display** display, Window* root, Window* window, XWindowAttributes* attributes, GC* graphics_context, XImage** image, Atom* message_delete_window) {
     *display = XOpenDisplay(NULL);
     if(!*display) {
         silkLogErr("X11: Couldn't open the default display.");
@@ -66,11 +66,11 @@ i32 X11Setup(pixel* buf, Display** display, Window* root, Window* window, XWindo
         attributes->depth, 
         ZPixmap, 
         0, 
-        (char*) buf, 
-        SILK_PIXELBUFFER_WIDTH, 
-        SILK_PIXELBUFFER_HEIGHT, 
+        (char*) canvas->data, 
+        canvas->size.x, 
+        canvas->size.y, 
         32, 
-        SILK_PIXELBUFFER_WIDTH * sizeof(pixel)
+        canvas->stride
     );
 
     *graphics_context = XCreateGC(
@@ -98,9 +98,9 @@ i32 X11Setup(pixel* buf, Display** display, Window* root, Window* window, XWindo
     return SILK_SUCCESS;
 }
 
-i32 X11Blit(pixel* buffer, Display* display, Window* window, GC* graphics_context, XImage* image) {
-    if(buffer == NULL) {
-        silkLogErr("X11: Passed a NULL parameter: buffer.");
+i32 X11Blit(silk_canvas* canvas, Display* display, Window* window, GC* graphics_context, XImage* image) {
+    if(canvas == NULL) {
+        silkLogErr("X11: Passed a NULL parameter: canvas.");
 
         return SILK_FAILURE;
     } if(display == NULL) {
@@ -121,18 +121,25 @@ i32 X11Blit(pixel* buffer, Display* display, Window* window, GC* graphics_contex
         return SILK_FAILURE;
     }
 
-    XPutImage(
-        display, 
-        *window, 
-        *graphics_context, 
-        image, 
-        0, 
-        0, 
-        0, 
-        0, 
-        SILK_PIXELBUFFER_WIDTH, 
-        SILK_PIXELBUFFER_HEIGHT
-    );
+    // Only the areas changed since the last frame are sent to the X server
+    for(i32 i = 0; i < silkGetDirtyRectCount(canvas); i++) {
+        silk_rect dirty = silkGetDirtyRect(canvas, i);
+
+        XPutImage(
+            display, 
+            *window, 
+            *graphics_context, 
+            image, 
+            dirty.x, 
+            dirty.y, 
+            dirty.x, 
+            dirty.y, 
+            dirty.w, 
+            dirty.h
+        );
+    }
+
+    silkResetDirtyRects(canvas);
 
     return SILK_SUCCESS;
 }
@@ -154,7 +161,8 @@ i32 X11Close(Display* display, XImage* image) {
 }
 
 i32 main(i32 argc, const string argv[]) {
-    pixel buffer[SILK_PIXELBUFFER_WIDTH * SILK_PIXELBUFFER_HEIGHT];
+    // 24-bit X11 visuals store the pixels as B, G, R, X bytes, so the canvas is drawn in that order right away
+    silk_canvas canvas = silkLoadCanvasFormat((vec2i) { SILK_PIXELBUFFER_WIDTH, SILK_PIXELBUFFER_HEIGHT }, SILK_PIXELFORMAT_XRGB8888);
 
     i32 rotation = 0;
     
@@ -170,7 +178,7 @@ i32 main(i32 argc, const string argv[]) {
     GC x11_graphics_context =                   0;
     Atom wm_delete_window =                     0;
 
-    X11Setup(buffer, &x11_display, &x11_root, &x11_window, &x11_window_attributes, &x11_graphics_context, &x11_render_surface, &wm_delete_window);
+    X11Setup(&canvas, &x11_display, &x11_root, &x11_window, &x11_window_attributes, &x11_graphics_context, &x11_render_surface, &wm_delete_window);
 
     bool quit = false;
     while(!quit) {
@@ -193,12 +201,10 @@ i32 main(i32 argc, const string argv[]) {
             &x11_window_attributes
         );
 
-        silkClearPixelBufferColorRegion(buffer, (vec2i) { x11_window_attributes.width, x11_window_attributes.height }, SILK_PIXELBUFFER_WIDTH, 0xffffffff);
+        silkClearPixelBufferColorRegion(&canvas, (vec2i) { x11_window_attributes.width, x11_window_attributes.height }, 0xffffffff);
 
         silkDrawPolygon(
-            buffer, 
-            (vec2i) { SILK_PIXELBUFFER_WIDTH, SILK_PIXELBUFFER_HEIGHT },
-            SILK_PIXELBUFFER_WIDTH, 
+            &canvas,
             (vec2i) {
                 x11_window_attributes.width / 2,
                 x11_window_attributes.height / 2
@@ -210,9 +216,7 @@ i32 main(i32 argc, const string argv[]) {
         );
 
         silkDrawTextDefault(
-            buffer, 
-            (vec2i) { SILK_PIXELBUFFER_WIDTH, SILK_PIXELBUFFER_HEIGHT },
-            SILK_PIXELBUFFER_WIDTH,
+            &canvas,
             text, 
             (vec2i) { 
                 x11_window_attributes.width / 2 - silkMeasureText(text, text_size, text_spacing).x / 2, 
@@ -223,10 +227,11 @@ i32 main(i32 argc, const string argv[]) {
             0xff000000
         );
 
-        X11Blit(buffer, x11_display, &x11_window, &x11_graphics_context, x11_render_surface);
+        X11Blit(&canvas, x11_display, &x11_window, &x11_graphics_context, x11_render_surface);
     }
 
     X11Close(x11_display, x11_render_surface);
+    silkUnloadCanvas(&canvas);
 
     return 0;
 }
\ No newline at end of file
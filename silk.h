@@ -26,6 +26,11 @@
 // - SILK_ALPHABLEND_DISABLE:
 //      Disables alpha-blending.
 //
+// - SILK_PREMULTIPLIED_ALPHA:
+//      Pixels are stored with the premultiplied alpha (the color channels are already multiplied by the alpha), so the blending is cheaper
+//      and the filtered images have no dark fringes.
+//      NOTE: 'silkColorToPixel' and 'silkLoadImage' premultiply the colors on their own. Pixel literals have to be premultiplied by hand (see: 'silkPixelPremultiply').
+//
 // - SILK_BYTEORDER_LITTLE_ENDIAN:
 //      Byte order is little endian.
 //
@@ -60,9 +65,70 @@
 //      Path to the module's header: stb_image_write.h.
 //      NOTE: Path to the module header MUST be relative to silk.h header.
 //
+// - SILK_INCLUDE_MODULE_STB_TRUETYPE:
+//      Includes the functionality of 3rd-party module: stb_truetype (TrueType fonts, see: 'silkLoadFont').
+//      NOTE: After including the module you should also define the include path to module's header.
+//
+// - SILK_MODULE_STB_TRUETYPE_PATH:
+//      Path to the module's header: stb_truetype.h.
+//      NOTE: Path to the module header MUST be relative to silk.h header.
+//
 //  - SILK_DISABLE_INT_TYPEDEFS:
 //      Disables the interger type definitions.
 //
+// - SILK_SIMD_DISABLE:
+//      Disables all the SIMD kernels (SSE2, SSSE3, AVX2, AVX-512, NEON). Only the scalar code-paths are compiled.
+//
+// - SILK_SIMD_DISABLE_AVX2:
+//      Disables the AVX2 kernels, even if the CPU supports them.
+//
+// - SILK_SIMD_DISABLE_AVX512:
+//      Disables the AVX-512 kernels, even if the CPU supports them.
+//
+// - SILK_NONTEMPORAL_THRESHOLD:
+//      Size (in bytes) from which the buffer clears are done with non-temporal (streaming) stores, bypassing the cache.
+//      NOTE: Default value is 4 MB (a bit less than one Full HD frame).
+//
+// - SILK_CLIP_STACK_SIZE:
+//      Maximum number of the clip rectangles pushed onto one canvas (see: 'silkPushClipRect').
+//      NOTE: Default value is 16.
+//
+// - SILK_DIRTY_RECT_COUNT:
+//      Maximum number of the dirty rectangles tracked by one canvas (see: 'silkGetDirtyRect'). Damage beyond that is merged into them.
+//      NOTE: Default value is 16.
+//
+// - SILK_FONT_ATLAS_SIZE:
+//      Width and height (in pixels) of the A8 atlas holding the rasterized glyphs of the TrueType fonts.
+//      NOTE: Default value is 1024.
+//
+// - SILK_FONT_RUN_CACHE_SIZE:
+//      Number of the laid out strings kept by the TrueType text (see: 'silkDrawTextFont').
+//      NOTE: Default value is 256.
+//
+// - SILK_TEXT_CACHE_SIZE:
+//      Number of the layouts kept by one text cache (see: 'silkLayoutText').
+//      NOTE: Default value is 256.
+//
+// - SILK_SDF_GLYPH_SIZE:
+//      Height (in pixels) the glyphs of the signed distance field fonts are generated at (see: 'silkLoadSDFFont').
+//      NOTE: Default value is 32.
+//
+// - SILK_RASTERIZER_DEFAULT:
+//      Triangle rasterizer used from the start: 'SILK_RASTERIZER_SCANLINE' or 'SILK_RASTERIZER_HALFSPACE'.
+//      NOTE: It can be changed at the run time with 'silkSetRasterizer'.
+//
+// - SILK_THREADS_ENABLE:
+//      Enables the multithreaded 'silkFlush': recorded commands are binned into the screen tiles, which are rendered by the thread pool.
+//      NOTE: Silk links against pthreads then (Win32 threads on Windows). Number of the threads is set with 'silkSetThreadCount'.
+//
+// - SILK_TILE_SIZE:
+//      Width and height (in pixels) of the screen tiles used by the multithreaded 'silkFlush'.
+//      NOTE: Default value is 64.
+//
+// - SILK_MAX_THREADS:
+//      Maximum number of the threads rendering one 'silkFlush' (the calling thread included).
+//      NOTE: Default value is 64.
+//
 // --------------------------------------------------------------------------------------------------------------------------------
 // Licence: MIT
 //
@@ -117,6 +183,8 @@
     #define SILK_ALPHABLEND_ENABLE
 #endif // SILK_ALPHABLEND_ENABLE
 
+// NOTE: Silk itself doesn't depend on these two macros anymore (every canvas carries it's own size, see: 'silk_canvas').
+// They're kept as the handy default canvas size for the applications and the examples.
 #if !defined(SILK_PIXELBUFFER_WIDTH)
     #define SILK_PIXELBUFFER_WIDTH 1920 // SILK_PIXELBUFFER_WIDTH: Default Full HD monitor width
 #endif // SILK_PIXELBUFFER_WIDTH
@@ -136,6 +204,81 @@
     #define SILK_BYTEORDER_BIG_ENDIAN
 #endif // SILK_BYTEORDER_BIG_ENDIAN
 
+#if !defined(SILK_NONTEMPORAL_THRESHOLD)
+    #define SILK_NONTEMPORAL_THRESHOLD (4 * 1024 * 1024) // SILK_NONTEMPORAL_THRESHOLD: Clears bigger than this (in bytes) are streamed past the cache
+#endif // SILK_NONTEMPORAL_THRESHOLD
+
+#define SILK_CANVAS_ALIGNMENT 64 // SILK_CANVAS_ALIGNMENT: Alignment (in bytes) of the canvas memory and of every canvas row (one cache-line)
+
+#if !defined(SILK_CLIP_STACK_SIZE)
+    #define SILK_CLIP_STACK_SIZE 16 // SILK_CLIP_STACK_SIZE: Maximum number of the clip rectangles pushed onto one canvas
+#endif // SILK_CLIP_STACK_SIZE
+
+#if !defined(SILK_DIRTY_RECT_COUNT)
+    #define SILK_DIRTY_RECT_COUNT 16 // SILK_DIRTY_RECT_COUNT: Maximum number of the dirty rectangles tracked by one canvas (more damage is merged into them)
+#endif // SILK_DIRTY_RECT_COUNT
+
+#if !defined(SILK_FONT_ATLAS_SIZE)
+    #define SILK_FONT_ATLAS_SIZE 1024 // SILK_FONT_ATLAS_SIZE: Width and height (in pixels) of the A8 atlas holding the rasterized glyphs of the TrueType fonts
+#endif // SILK_FONT_ATLAS_SIZE
+
+#if !defined(SILK_FONT_RUN_CACHE_SIZE)
+    #define SILK_FONT_RUN_CACHE_SIZE 256 // SILK_FONT_RUN_CACHE_SIZE: Number of the laid out strings kept by the TrueType text
+#endif // SILK_FONT_RUN_CACHE_SIZE
+
+#if !defined(SILK_TEXT_CACHE_SIZE)
+    #define SILK_TEXT_CACHE_SIZE 256 // SILK_TEXT_CACHE_SIZE: Number of the layouts kept by one text cache
+#endif // SILK_TEXT_CACHE_SIZE
+
+#if !defined(SILK_SDF_GLYPH_SIZE)
+    #define SILK_SDF_GLYPH_SIZE 32 // SILK_SDF_GLYPH_SIZE: Height (in pixels) the glyphs of the signed distance field fonts are generated at
+#endif // SILK_SDF_GLYPH_SIZE
+
+#if !defined(SILK_TILE_SIZE)
+    #define SILK_TILE_SIZE 64 // SILK_TILE_SIZE: Width and height (in pixels) of the screen tiles the multithreaded 'silkFlush' bins the commands into
+#endif // SILK_TILE_SIZE
+
+#if !defined(SILK_MAX_THREADS)
+    #define SILK_MAX_THREADS 64 // SILK_MAX_THREADS: Maximum number of the threads rendering one 'silkFlush' (the calling thread included)
+#endif // SILK_MAX_THREADS
+
+#define SILK_PIXELFORMAT_RGBA8888   0 // SILK_PIXELFORMAT_RGBA8888: 32-bit pixel, bytes R, G, B, A in memory (channel order as in 'silkColorToPixel')
+#define SILK_PIXELFORMAT_BGRA8888   1 // SILK_PIXELFORMAT_BGRA8888: 32-bit pixel, bytes B, G, R, A in memory (Win32 DIBs, most of the X11 visuals)
+#define SILK_PIXELFORMAT_XRGB8888   2 // SILK_PIXELFORMAT_XRGB8888: BGRA8888 with the 4th byte ignored by the consumers (DRM, 24-bit X11 visuals); read back as opaque
+#define SILK_PIXELFORMAT_RGB565     3 // SILK_PIXELFORMAT_RGB565: 16-bit pixel (native byte order), 5 bits of red (the top ones), 6 of green and 5 of blue; always opaque
+#define SILK_PIXELFORMAT_A8         4 // SILK_PIXELFORMAT_A8: 8-bit pixel, alpha only (masks)
+#define SILK_PIXELFORMAT_COUNT      5
+
+#define SILK_RASTERIZER_SCANLINE    0 // SILK_RASTERIZER_SCANLINE: Triangles are filled row by row, with the span bounds stepped along the edges
+#define SILK_RASTERIZER_HALFSPACE   1 // SILK_RASTERIZER_HALFSPACE: Triangles are walked in 8x8 tiles with the incremental edge functions
+
+#define SILK_SUBPIXEL_BITS 4                                // SILK_SUBPIXEL_BITS: Fractional bits of the triangle vertices (28.4 fixed-point numbers)
+#define SILK_SUBPIXEL_ONE (1 << SILK_SUBPIXEL_BITS)         // SILK_SUBPIXEL_ONE: One pixel, in the sub-pixel units
+#define SILK_SUBPIXEL(x) ((i32) (x) * SILK_SUBPIXEL_ONE)    // SILK_SUBPIXEL: Converts a whole number of pixels to the sub-pixel units
+
+#define SILK_FILL_RULE_EVEN_ODD     0 // SILK_FILL_RULE_EVEN_ODD: Point is inside of the polygon if a ray from it crosses the outline an odd number of times
+#define SILK_FILL_RULE_NON_ZERO     1 // SILK_FILL_RULE_NON_ZERO: Point is inside of the polygon if the outline winds around it (winding number other than 0)
+
+#define SILK_BLEND_MODE_ALPHA       0 // SILK_BLEND_MODE_ALPHA: "Source-over": the color is laid over the canvas by it's alpha (default)
+#define SILK_BLEND_MODE_ADDITIVE    1 // SILK_BLEND_MODE_ADDITIVE: Color is added to the canvas (saturated at 255)
+#define SILK_BLEND_MODE_MULTIPLY    2 // SILK_BLEND_MODE_MULTIPLY: Canvas is multiplied by the color (darkens, i.e. the shading)
+#define SILK_BLEND_MODE_SCREEN      3 // SILK_BLEND_MODE_SCREEN: Inverted canvas is multiplied by the inverted color (lightens, i.e. the glow)
+#define SILK_BLEND_MODE_MIN         4 // SILK_BLEND_MODE_MIN: Smaller of the two channels (darken)
+#define SILK_BLEND_MODE_MAX         5 // SILK_BLEND_MODE_MAX: Bigger of the two channels (lighten)
+#define SILK_BLEND_MODE_REPLACE     6 // SILK_BLEND_MODE_REPLACE: Color (with it's alpha) simply overwrites the canvas
+#define SILK_BLEND_MODE_COUNT       7
+
+#if !defined(SILK_RASTERIZER_DEFAULT)
+    #define SILK_RASTERIZER_DEFAULT SILK_RASTERIZER_SCANLINE
+#endif // SILK_RASTERIZER_DEFAULT
+
+#define SILK_SIMD_SSE2      (1 << 0) // SILK_SIMD_SSE2: x86 SSE2 kernels
+#define SILK_SIMD_SSSE3     (1 << 1) // SILK_SIMD_SSSE3: x86 SSSE3 kernels
+#define SILK_SIMD_AVX2      (1 << 2) // SILK_SIMD_AVX2: x86 AVX2 kernels
+#define SILK_SIMD_AVX512    (1 << 3) // SILK_SIMD_AVX512: x86 AVX-512 (F + BW) kernels
+#define SILK_SIMD_NEON      (1 << 4) // SILK_SIMD_NEON: ARM NEON kernels
+#define SILK_SIMD_ALL       (0xffffffff)
+
 #if !defined(SILK_MALLOC)
     #include <stdlib.h>
 
@@ -178,13 +321,19 @@
     #include <stdint.h>
 
     typedef uint8_t                                                                     u8;
+    typedef uint16_t                                                                    u16;
     typedef int32_t                                                                     i32;
     typedef uint32_t                                                                    u32;
+    typedef int64_t                                                                     i64;
+    typedef uint64_t                                                                    u64;
     typedef float                                                                       f32;
 #endif
 SILK_STATIC_ASSERT(sizeof(u8)  == 1, "u8 must be one byte long.");
+SILK_STATIC_ASSERT(sizeof(u16) == 2, "u16 must be two bytes long.");
 SILK_STATIC_ASSERT(sizeof(i32) == 4, "i32 must be four bytes long.");
 SILK_STATIC_ASSERT(sizeof(u32) == 4, "u32 must be four bytes long.");
+SILK_STATIC_ASSERT(sizeof(i64) == 8, "i64 must be eight bytes long.");
+SILK_STATIC_ASSERT(sizeof(u64) == 8, "u64 must be eight bytes long.");
 SILK_STATIC_ASSERT(sizeof(f32) == 4, "f32 must be four bytes long.");
 
 typedef char*                                                                           string;
@@ -192,21 +341,145 @@ typedef u8
 typedef u32                                                                             pixel;
 
 typedef struct { i32 x; i32 y; }                                                        vec2i;
+typedef struct { f32 x; f32 y; }                                                        vec2f;
+typedef struct { i32 x; i32 y; i32 w; i32 h; }                                          silk_rect;
 typedef struct { color_channel r; color_channel g; color_channel b; color_channel a; }  color;
 typedef struct { pixel* data; vec2i size; i32 channels; }                               image;
 
+typedef struct {
+    u8* data;       // Arena holding the recorded commands one after another (each one followed by it's payload)
+    i64 size;       // Bytes used
+    i64 capacity;   // Bytes allocated
+    i32 count;      // Number of the recorded commands
+} silk_command_buffer;
+
+typedef struct {
+    u8* data;       // Address of the first pixel
+    vec2i size;     // Width and height (in pixels)
+    i32 stride;     // Distance between the rows (in bytes)
+    i32 format;     // Pixel format (SILK_PIXELFORMAT_*)
+    void* memory;   // Memory block owned by the canvas (NULL if the canvas only wraps the user's buffer)
+
+    silk_rect clip_stack[SILK_CLIP_STACK_SIZE]; // Pushed clip rectangles, each one already intersected with the previous one
+    i32 clip_count;                             // Number of the pushed clip rectangles (0: the whole canvas is drawable)
+
+    i32 blend_mode; // How the draw calls are combined with the canvas (SILK_BLEND_MODE_*)
+
+    silk_rect dirty_rects[SILK_DIRTY_RECT_COUNT];   // Areas changed since the last 'silkResetDirtyRects' (merged, see: 'silkGetDirtyRect')
+    i32 dirty_count;                                // Number of the dirty rectangles
+
+    silk_command_buffer* recording; // Command buffer the draw calls are recorded into (NULL: the draw calls are rasterized right away)
+} silk_canvas;
+
+typedef struct {
+    vec2f* points;          // Outline of every contour, with the curves already flattened into the line segments
+    i32 point_count;
+    i32 point_capacity;
+    i32* contours;          // Index of the first point of every contour
+    i32 contour_count;
+    i32 contour_capacity;
+} silk_path;
+
+typedef struct {
+    const u8* rows;     // Row masks of every glyph, 'glyph_size.y' bytes per glyph: bit 'x' of the row is it's column 'x'
+    vec2i glyph_size;   // Width (1 - 8) and height of the glyphs (in font cells)
+    i32 glyph_count;    // Number of the glyphs (starting with the code 0)
+} silk_bitmap_font;
+
+typedef struct {
+    u32 code;           // Code point (U+FFFD for the malformed UTF-8)
+    vec2i position;     // Top-left corner of the glyph, relative to the position of the text (in pixels)
+} silk_text_glyph;
+
+typedef struct {
+    const silk_bitmap_font* font;
+    i32 font_size;
+    i32 font_spacing;
+    const silk_text_glyph* glyphs;  // Owned by the text cache (valid until it's reset)
+    i32 glyph_count;
+    i32 line_count;
+    vec2i size;         // Size of the laid out text (in pixels)
+} silk_text_layout;
+
+typedef struct {
+    void* blocks;       // Arena holding the laid out glyphs and their strings (NULL: nothing allocated yet)
+    void* entries;      // 'SILK_TEXT_CACHE_SIZE' layouts, found by the hash of the string, the font, the size and the width
+    i32 count;          // Layouts laid out since the last reset
+} silk_text_cache;
+
+typedef struct {
+    u8* data;           // Contents of the font file
+    void* info;         // Parsed font (stbtt_fontinfo)
+    i32 id;             // Unique key of the font's glyphs in the glyph atlas
+    i32 ascent;         // Vertical metrics (in font units)
+    i32 descent;
+    i32 line_gap;
+} silk_font;
+
+typedef struct {
+    vec2i position;     // Rectangle of the glyph's distance field in the atlas
+    vec2i size;
+    vec2f offset;       // Top-left corner of the field, relative to the pen on the baseline (in atlas pixels)
+    f32 advance;        // Distance to the next pen position (in atlas pixels)
+} silk_sdf_glyph;
+
+typedef struct {
+    u8* atlas;          // Signed distance fields of the glyphs (128 is the edge, more is inside)
+    vec2i atlas_size;
+    silk_sdf_glyph* glyphs;
+    u32 first;          // Code point of the first glyph
+    i32 glyph_count;
+    f32 em;             // Atlas pixels drawn at the 'font_size' of 1
+    f32 ascent;         // Distance from the top of the line to the baseline (in atlas pixels)
+    f32 line_height;    // (in atlas pixels)
+} silk_sdf_font;
+
+typedef struct {
+    u64* hashes;        // Hash of every tile in the last compared frame
+    u32* changed;       // Tiles changed by the last compared frame: bit 'tile % 32' of the word 'tile / 32' ('tile = y * tiles.x + x')
+    vec2i size;         // Size of the canvas (in pixels) the hashes were computed for (0: no frame compared yet)
+    vec2i tiles;        // Number of the tiles, horizontally and vertically
+    i32 tile_size;      // Width and height of the tiles (in pixels)
+    i32 changed_count;  // Number of the changed tiles
+} silk_frame_diff;
+
 // --------------------------------------------------------------------------------------------------------------------------------
 // SECTION: API
 // --------------------------------------------------------------------------------------------------------------------------------
 
+// --------------------------------------------------------------------------------------------------------------------------------
+// SECTION MODULE: Canvas
+// --------------------------------------------------------------------------------------------------------------------------------
+
+SILK_API silk_canvas silkLoadCanvas(vec2i size);
+SILK_API silk_canvas silkLoadCanvasFormat(vec2i size, i32 format);
+SILK_API silk_canvas silkCanvasFromBuffer(void* buffer, vec2i size, i32 stride);
+SILK_API silk_canvas silkCanvasFromBufferFormat(void* buffer, vec2i size, i32 stride, i32 format);
+SILK_API i32 silkPixelFormatSize(i32 format);
+SILK_API i32 silkConvertPixels(const void* src, i32 src_format, i32 src_stride, void* dest, i32 dest_format, i32 dest_stride, silk_rect rect);
+SILK_API image silkCanvasToImage(silk_canvas* canvas);
+SILK_API i32 silkUnloadCanvas(silk_canvas* canvas);
+
+SILK_API i32 silkPushClipRect(silk_canvas* canvas, silk_rect rect);
+SILK_API i32 silkPopClipRect(silk_canvas* canvas);
+SILK_API silk_rect silkGetClipRect(silk_canvas* canvas);
+
+SILK_API i32 silkSetBlendMode(silk_canvas* canvas, i32 mode);
+SILK_API i32 silkGetBlendMode(silk_canvas* canvas);
+
+SILK_API i32 silkGetDirtyRectCount(silk_canvas* canvas);
+SILK_API silk_rect silkGetDirtyRect(silk_canvas* canvas, i32 index);
+SILK_API i32 silkAddDirtyRect(silk_canvas* canvas, silk_rect rect);
+SILK_API i32 silkResetDirtyRects(silk_canvas* canvas);
+
 // --------------------------------------------------------------------------------------------------------------------------------
 // SECTION MODULE: Pixel buffer
 // --------------------------------------------------------------------------------------------------------------------------------
 
-SILK_API i32 silkClearPixelBuffer(pixel* buffer);
-SILK_API i32 silkClearPixelBufferRegion(pixel* buffer, vec2i region, i32 stride);
-SILK_API i32 silkClearPixelBufferColor(pixel* buffer, pixel pix);
-SILK_API i32 silkClearPixelBufferColorRegion(pixel* buffer, vec2i region, i32 stride, pixel pix);
+SILK_API i32 silkClearPixelBuffer(silk_canvas* canvas);
+SILK_API i32 silkClearPixelBufferRegion(silk_canvas* canvas, vec2i region);
+SILK_API i32 silkClearPixelBufferColor(silk_canvas* canvas, pixel pix);
+SILK_API i32 silkClearPixelBufferColorRegion(silk_canvas* canvas, vec2i region, pixel pix);
 
 SILK_API pixel silkGetPixel(pixel* buffer, vec2i position, i32 stride);
 SILK_API i32 silkSetPixel(pixel* buffer, vec2i position, i32 stride, pixel pix);
@@ -222,6 +495,8 @@ SILK_API pixel silkColorToPixel(color col);
 SILK_API pixel silkAlphaBlend(pixel base_pixel, pixel return_pixel, color_channel value);
 SILK_API pixel silkPixelFade(pixel pix, f32 factor);
 SILK_API pixel silkPixelTint(pixel pix, pixel tint);
+SILK_API pixel silkPixelPremultiply(pixel pix);
+SILK_API pixel silkPixelUnpremultiply(pixel pix);
 SILK_API color_channel silkPixelChannelRed(pixel pix);
 SILK_API color_channel silkPixelChannelGreen(pixel pix);
 SILK_API color_channel silkPixelChannelBlue(pixel pix);
@@ -231,36 +506,123 @@ SILK_API color_channel silkPixelChannelAlpha(pixel pix);
 // SECTION MODULE: Rendering
 // --------------------------------------------------------------------------------------------------------------------------------
 
-SILK_API i32 silkDrawPixel(pixel* buffer, vec2i buf_size, i32 buf_stride, vec2i position, pixel pix);
+SILK_API i32 silkDrawPixel(silk_canvas* canvas, vec2i position, pixel pix);
+
+SILK_API i32 silkDrawLine(silk_canvas* canvas, vec2i start, vec2i end, pixel pix);
+SILK_API i32 silkDrawLineAA(silk_canvas* canvas, vec2f start, vec2f end, pixel pix);
+
+SILK_API i32 silkDrawRect(silk_canvas* canvas, vec2i position, vec2i size, pixel pix);
+SILK_API i32 silkDrawRectPro(silk_canvas* canvas, vec2i position, vec2i size, i32 angle, vec2i offset, pixel pix);
+SILK_API i32 silkDrawRectLines(silk_canvas* canvas, vec2i position, vec2i size, i32 angle, vec2i offset, pixel pix);
+
+SILK_API i32 silkDrawCircle(silk_canvas* canvas, vec2i position, i32 radius, pixel pix);
+SILK_API i32 silkDrawCircleAA(silk_canvas* canvas, vec2f position, f32 radius, pixel pix);
+SILK_API i32 silkDrawCircleLines(silk_canvas* canvas, vec2i position, i32 radius, pixel pix);
+
+SILK_API i32 silkDrawEllipse(silk_canvas* canvas, vec2i position, vec2i radius, pixel pix);
+
+SILK_API i32 silkSetRasterizer(i32 rasterizer);
+SILK_API i32 silkGetRasterizer(void);
+
+SILK_API i32 silkDrawTriangle(silk_canvas* canvas, vec2i point_a, vec2i point_b, vec2i point_c, pixel pix);
+SILK_API i32 silkDrawTriangleFloat(silk_canvas* canvas, vec2f point_a, vec2f point_b, vec2f point_c, pixel pix);
+SILK_API i32 silkDrawTriangleFixed(silk_canvas* canvas, vec2i point_a, vec2i point_b, vec2i point_c, pixel pix);
+SILK_API i32 silkDrawTriangleLines(silk_canvas* canvas, vec2i point_a, vec2i point_b, vec2i point_c, pixel pix);
+SILK_API i32 silkDrawTriangleEquilateral(silk_canvas* canvas, vec2i position, i32 radius, i32 angle, pixel pix);
+SILK_API i32 silkDrawTriangleEquilateralLines(silk_canvas* canvas, vec2i position, i32 radius, i32 angle, pixel pix);
+
+SILK_API i32 silkDrawPolygon(silk_canvas* canvas, vec2i position, i32 radius, i32 angle, i32 n, pixel pix);
+SILK_API i32 silkDrawPolygonPoints(silk_canvas* canvas, const vec2f* points, i32 count, i32 fill_rule, pixel pix);
+SILK_API i32 silkDrawStar(silk_canvas* canvas, vec2i position, i32 radius, i32 angle, i32 n, pixel pix);
+
+SILK_API i32 silkDrawImage(silk_canvas* canvas, image* img, vec2i position);
+SILK_API i32 silkDrawImageScaled(silk_canvas* canvas, image* img, vec2i position, vec2i size_dest);
+SILK_API i32 silkDrawImagePro(silk_canvas* canvas, image* img, vec2i position, vec2i offset, vec2i size_dest, pixel tint);
+
+SILK_API i32 silkDrawTextDefault(silk_canvas* canvas, const char* text, vec2i position, i32 font_size, i32 font_spacing, pixel pix);
+SILK_API i32 silkDrawTextBitmap(silk_canvas* canvas, const silk_bitmap_font* font, const char* text, vec2i position, i32 font_size, i32 font_spacing, pixel pix);
+SILK_API const silk_bitmap_font* silkGetDefaultFont(void);
+
+// --------------------------------------------------------------------------------------------------------------------------------
+// SECTION MODULE: Paths
+// --------------------------------------------------------------------------------------------------------------------------------
+
+SILK_API silk_path silkLoadPath(void);
+SILK_API i32 silkUnloadPath(silk_path* path);
+SILK_API i32 silkPathReset(silk_path* path);
+
+SILK_API i32 silkPathMoveTo(silk_path* path, vec2f point);
+SILK_API i32 silkPathLineTo(silk_path* path, vec2f point);
+SILK_API i32 silkPathQuadTo(silk_path* path, vec2f control, vec2f point);
+SILK_API i32 silkPathCubicTo(silk_path* path, vec2f control_a, vec2f control_b, vec2f point);
+SILK_API i32 silkPathClose(silk_path* path);
 
-SILK_API i32 silkDrawLine(pixel* buffer, vec2i buf_size, i32 buf_stride, vec2i start, vec2i end, pixel pix);
+SILK_API i32 silkDrawPath(silk_canvas* canvas, silk_path* path, i32 fill_rule, pixel pix);
 
-SILK_API i32 silkDrawRect(pixel* buffer, vec2i buf_size, i32 buf_stride, vec2i position, vec2i size, pixel pix);
-SILK_API i32 silkDrawRectPro(pixel* buffer, vec2i buf_size, i32 buf_stride, vec2i position, vec2i size, i32 angle, vec2i offset, pixel pix);
-SILK_API i32 silkDrawRectLines(pixel* buffer, vec2i buf_size, i32 buf_stride, vec2i position, vec2i size, i32 angle, vec2i offset, pixel pix);
+// --------------------------------------------------------------------------------------------------------------------------------
+// SECTION MODULE: Command buffer
+// --------------------------------------------------------------------------------------------------------------------------------
 
-SILK_API i32 silkDrawCircle(pixel* buffer, vec2i buf_size, i32 buf_stride, vec2i position, i32 radius, pixel pix);
-SILK_API i32 silkDrawCircleLines(pixel* buffer, vec2i buf_size, i32 buf_stride, vec2i position, i32 radius, pixel pix);
+SILK_API silk_command_buffer silkLoadCommandBuffer(void);
+SILK_API i32 silkUnloadCommandBuffer(silk_command_buffer* commands);
+SILK_API i32 silkResetCommandBuffer(silk_command_buffer* commands);
 
-SILK_API i32 silkDrawTriangle(pixel* buffer, vec2i buf_size, i32 buf_stride, vec2i point_a, vec2i point_b, vec2i point_c, pixel pix);
-SILK_API i32 silkDrawTriangleLines(pixel* buffer, vec2i buf_size, i32 buf_stride, vec2i point_a, vec2i point_b, vec2i point_c, pixel pix);
-SILK_API i32 silkDrawTriangleEquilateral(pixel* buffer, vec2i buf_size, i32 buf_stride, vec2i position, i32 radius, i32 angle, pixel pix);
-SILK_API i32 silkDrawTriangleEquilateralLines(pixel* buffer, vec2i buf_size, i32 buf_stride, vec2i position, i32 radius, i32 angle, pixel pix);
+SILK_API i32 silkBeginRecording(silk_canvas* canvas, silk_command_buffer* commands);
+SILK_API i32 silkEndRecording(silk_canvas* canvas);
+SILK_API i32 silkFlush(silk_canvas* canvas, silk_command_buffer* commands);
 
-SILK_API i32 silkDrawPolygon(pixel* buffer, vec2i buf_size, i32 buf_stride, vec2i position, i32 radius, i32 angle, i32 n, pixel pix);
-SILK_API i32 silkDrawStar(pixel* buffer, vec2i buf_size, i32 buf_stride, vec2i position, i32 radius, i32 angle, i32 n, pixel pix);
+SILK_API i32 silkSetThreadCount(i32 count);
+SILK_API i32 silkGetThreadCount(void);
 
-SILK_API i32 silkDrawImage(pixel* buffer, vec2i buf_size, i32 buf_stride, image* img, vec2i position);
-SILK_API i32 silkDrawImageScaled(pixel* buffer, vec2i buf_size, i32 buf_stride, image* img, vec2i position, vec2i size_dest);
-SILK_API i32 silkDrawImagePro(pixel* buffer, vec2i buf_size, i32 buf_stride, image* img, vec2i position, vec2i offset, vec2i size_dest, pixel tint);
+// --------------------------------------------------------------------------------------------------------------------------------
+// SECTION MODULE: Frame differencing
+// --------------------------------------------------------------------------------------------------------------------------------
 
-SILK_API i32 silkDrawTextDefault(pixel* buffer, vec2i buf_size, i32 buf_stride, const char* text, vec2i position, i32 font_size, i32 font_spacing, pixel pix);
+SILK_API silk_frame_diff silkLoadFrameDiff(i32 tile_size);
+SILK_API i32 silkUnloadFrameDiff(silk_frame_diff* diff);
+SILK_API i32 silkCompareFrame(silk_frame_diff* diff, silk_canvas* canvas);
+SILK_API i32 silkTileChanged(silk_frame_diff* diff, vec2i tile);
 
 // --------------------------------------------------------------------------------------------------------------------------------
 // SECTION MODULE: Text Measurements
 // --------------------------------------------------------------------------------------------------------------------------------
 
 SILK_API vec2i silkMeasureText(const char* text, i32 font_size, i32 font_spacing);
+SILK_API vec2i silkMeasureTextBitmap(const silk_bitmap_font* font, const char* text, i32 font_size, i32 font_spacing);
+
+// --------------------------------------------------------------------------------------------------------------------------------
+// SECTION MODULE: Text Layout
+// --------------------------------------------------------------------------------------------------------------------------------
+
+SILK_API silk_text_cache silkLoadTextCache(void);
+SILK_API i32 silkUnloadTextCache(silk_text_cache* cache);
+SILK_API i32 silkResetTextCache(silk_text_cache* cache);
+
+SILK_API silk_text_layout silkLayoutText(silk_text_cache* cache, const silk_bitmap_font* font, const char* text, i32 font_size, i32 font_spacing, i32 max_width);
+SILK_API i32 silkDrawTextLayout(silk_canvas* canvas, const silk_text_layout* layout, vec2i position, pixel pix);
+
+// --------------------------------------------------------------------------------------------------------------------------------
+// SECTION MODULE: Fonts
+// --------------------------------------------------------------------------------------------------------------------------------
+
+SILK_API silk_font silkLoadFont(const string path);
+SILK_API silk_font silkLoadFontFromMemory(const u8* data, i32 size);
+SILK_API i32 silkUnloadFont(silk_font* font);
+
+SILK_API i32 silkDrawTextFont(silk_canvas* canvas, silk_font* font, const char* text, vec2i position, i32 font_size, pixel pix);
+SILK_API vec2i silkMeasureTextFont(silk_font* font, const char* text, i32 font_size);
+SILK_API i32 silkResetFontCache(void);
+
+// --------------------------------------------------------------------------------------------------------------------------------
+// SECTION MODULE: SDF Text
+// --------------------------------------------------------------------------------------------------------------------------------
+
+SILK_API silk_sdf_font silkLoadSDFFontBitmap(const silk_bitmap_font* font);
+SILK_API silk_sdf_font silkLoadSDFFont(silk_font* font, u32 first, i32 count);
+SILK_API i32 silkUnloadSDFFont(silk_sdf_font* font);
+
+SILK_API i32 silkDrawTextSDF(silk_canvas* canvas, const silk_sdf_font* font, const char* text, vec2f position, f32 font_size, pixel pix);
+SILK_API vec2f silkMeasureTextSDF(const silk_sdf_font* font, const char* text, f32 font_size);
 
 // --------------------------------------------------------------------------------------------------------------------------------
 // SECTION MODULE: Logging
@@ -272,6 +634,14 @@ SILK_API i32 silkLogErr(const string text, ...);
 
 SILK_API i32 silkLogAlphaBlendStatus(void);
 SILK_API i32 silkLogByteOrderStatus(void);
+SILK_API i32 silkLogSimdStatus(void);
+
+// --------------------------------------------------------------------------------------------------------------------------------
+// SECTION MODULE: CPU Features
+// --------------------------------------------------------------------------------------------------------------------------------
+
+SILK_API u32 silkGetSimdFeatures(void);
+SILK_API i32 silkSetSimdFeatures(u32 features);
 
 // --------------------------------------------------------------------------------------------------------------------------------
 // SECTION MODULE: Math
@@ -293,6 +663,7 @@ SILK_API string silkGetFilePathExtension(const string path);
 SILK_API image silkGenImageColor(vec2i size, pixel pix);
 SILK_API image silkGenImageCheckerboard(vec2i size, i32 checker_size, pixel a, pixel b);
 SILK_API image silkScaleImage(image* source, vec2i dest_size);
+SILK_API image silkScaleImageFiltered(image* source, vec2i dest_size);
 SILK_API image silkBufferToImage(pixel* buf, vec2i size);
 SILK_API image silkLoadImage(const string path);
 SILK_API i32 silkSaveImage(const string path, image* img);
@@ -314,19 +685,82 @@ SILK_API string silkGetError(void);
 // --------------------------------------------------------------------------------------------------------------------------------
 
 #include <stdarg.h>
+#include <stdint.h>
 #include <stdbool.h>
 #include <string.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <math.h>
 
+#if !defined(SILK_SIMD_DISABLE)
+    #if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+        #define SILK_SIMD_X86
+
+        #include <immintrin.h>
+
+        #if defined(_MSC_VER)
+            #include <intrin.h>
+        #else
+            #include <cpuid.h>
+        #endif // _MSC_VER
+    #elif defined(__aarch64__) || defined(_M_ARM64) || defined(__ARM_NEON)
+        #define SILK_SIMD_ARM
+
+        #include <arm_neon.h>
+    #endif // SILK_SIMD_X86 / SILK_SIMD_ARM
+#endif // SILK_SIMD_DISABLE
+
+#if defined(SILK_THREADS_ENABLE)
+    #if defined(_WIN32)
+        #if !defined(WIN32_LEAN_AND_MEAN)
+            #define WIN32_LEAN_AND_MEAN
+        #endif // WIN32_LEAN_AND_MEAN
+
+        #include <windows.h>
+    #else
+        #include <pthread.h>
+    #endif // _WIN32
+#endif // SILK_THREADS_ENABLE
+
 // --------------------------------------------------------------------------------------------------------------------------------
 // SECTION: Macro Definitions
 // --------------------------------------------------------------------------------------------------------------------------------
 
 #define SILK_TEXT_BUFFER_SIZE 256
+#define SILK_SPAN_CHUNK 256 // SILK_SPAN_CHUNK: Size (in pixels) of the scratch row used to gather the scaled / tinted image pixels before blending them
+
+#if defined(SILK_BYTEORDER_BIG_ENDIAN)
+    #define SILK_PIXEL_RED_SHIFT 24
+    #define SILK_PIXEL_GREEN_SHIFT 16
+    #define SILK_PIXEL_BLUE_SHIFT 8
+    #define SILK_PIXEL_ALPHA_SHIFT 0
+#else
+    #define SILK_PIXEL_RED_SHIFT 0
+    #define SILK_PIXEL_GREEN_SHIFT 8
+    #define SILK_PIXEL_BLUE_SHIFT 16
+    #define SILK_PIXEL_ALPHA_SHIFT 24
+#endif // SILK_BYTEORDER_BIG_ENDIAN
+
+#define SILK_PIXEL_ALPHA_MASK ((pixel) 0xff << SILK_PIXEL_ALPHA_SHIFT)
+
+#define SILK_RASTER_TILE_SIZE 8                         // SILK_RASTER_TILE_SIZE: Size (in pixels) of the tiles walked by the half-space rasterizer
+#define SILK_RASTER_GUARD_BAND (1 << 15)                // SILK_RASTER_GUARD_BAND: Vertices further than this (in pixels) fall back to the scanline rasterizer
+#define SILK_RASTER_MAX_COORD (1 << 23)                 // SILK_RASTER_MAX_COORD: Vertices further than this (in pixels) are rejected (the 64-bit edge functions would overflow)
+#define SILK_RASTER_MAX_RADIUS (1 << 14)                // SILK_RASTER_MAX_RADIUS: Circles and ellipses bigger than this (in pixels) are rejected (the 64-bit span test would overflow)
+#define SILK_POLYGON_STACK_EDGES 64                     // SILK_POLYGON_STACK_EDGES: Polygons with up to this many edges don't allocate any memory
+#define SILK_PATH_TOLERANCE 0.25f                       // SILK_PATH_TOLERANCE: Maximum distance (in pixels) between the curve and it's flattened line segments
+#define SILK_PATH_MAX_SEGMENTS 1024                     // SILK_PATH_MAX_SEGMENTS: Maximum number of the line segments of one flattened curve
+#define SILK_PATH_BAND_HEIGHT 16                        // SILK_PATH_BAND_HEIGHT: Rows of the path's accumulation buffer (the path is filled one band at a time)
+#define SILK_PATH_COVERAGE_ONE (1 << 16)                // SILK_PATH_COVERAGE_ONE: Fully covered pixel, in the fixed-point units of the accumulation buffer
 #define SILK_DEFAULT_FONT_CHAR_WIDTH 3
 #define SILK_DEFAULT_FONT_CHAR_HEIGHT 5
+#define SILK_FONT_SHELF_ROUNDING 4                      // SILK_FONT_SHELF_ROUNDING: Heights of the glyph atlas shelves are rounded up to the multiples of this
+#define SILK_FONT_GLYPH_CAPACITY 4096                   // SILK_FONT_GLYPH_CAPACITY: Maximum number of the glyphs in the atlas at once
+#define SILK_FONT_BATCH_SIZE 8192                       // SILK_FONT_BATCH_SIZE: Coverage (in bytes) copied out of the atlas at once (bigger glyphs aren't cached)
+#define SILK_FONT_BATCH_GLYPHS 128                      // SILK_FONT_BATCH_GLYPHS: Maximum number of the glyphs copied out of the atlas at once
+#define SILK_SDF_SPREAD 4                               // SILK_SDF_SPREAD: Distance (in atlas pixels) covered by the signed distance fields on both sides of the edge
+#define SILK_TEXT_BLOCK_SIZE 16384                      // SILK_TEXT_BLOCK_SIZE: Size (in bytes) of the first block of the text cache's arena
+#define SILK_SDF_ATLAS_WIDTH 512                        // SILK_SDF_ATLAS_WIDTH: Width (in pixels) of the signed distance field atlases
 
 // --------------------------------------------------------------------------------------------------------------------------------
 // SECTION MODULE: 3rd-Party Modules
@@ -370,6 +804,18 @@ SILK_API string silkGetError(void);
 
 #endif // SILK_INCLUDE_MODULE_STB_IMAGE_WRITE
 
+// Including module: stb_truetype.h
+// Purpose: rasterizing the glyphs of the TrueType fonts.
+#if defined(SILK_INCLUDE_MODULE_STB_TRUETYPE)
+    #if !defined(SILK_MODULE_STB_TRUETYPE_PATH)
+        #define SILK_MODULE_STB_TRUETYPE_PATH "stb_truetype.h"
+    #endif // SILK_MODULE_STB_TRUETYPE_PATH
+
+    #define STB_TRUETYPE_IMPLEMENTATION
+    #include SILK_MODULE_STB_TRUETYPE_PATH
+
+#endif // SILK_INCLUDE_MODULE_STB_TRUETYPE
+
 // --------------------------------------------------------------------------------------------------------------------------------
 // SECTION MODULE: Error Messages
 // --------------------------------------------------------------------------------------------------------------------------------
@@ -389,703 +835,159 @@ SILK_API string silkGetError(void);
 #define SILK_ERR_IMAGE_INVALID_FILE_EXT "Invalid file extension provided."
 #define SILK_ERR_ALLOCATION_FAIL "Memory allocation failure."
 #define SILK_ERR_OUT_OF_BOUNDS "Index out of bounds."
+#define SILK_ERR_CANVAS_INVALID_SIZE "Invalid canvas size."
+#define SILK_ERR_RASTERIZER_INVALID "Invalid rasterizer."
+#define SILK_ERR_CLIP_STACK_OVERFLOW "Clip stack overflow."
+#define SILK_ERR_CLIP_STACK_UNDERFLOW "Clip stack underflow."
+#define SILK_ERR_FILL_RULE_INVALID "Invalid fill rule."
+#define SILK_ERR_COMMAND_BUFFER_RECORDING "Command buffer is being recorded."
+#define SILK_ERR_BLEND_MODE_INVALID "Invalid blend mode."
+#define SILK_ERR_PIXEL_FORMAT_INVALID "Invalid pixel format."
+#define SILK_ERR_THREADS_DISABLED "Multithreading disabled (define 'SILK_THREADS_ENABLE')."
+#define SILK_ERR_THREAD_CREATE_FAIL "Couldn't create a thread."
+#define SILK_ERR_FONT_LOAD_FAIL "Couldn't load a font."
+#define SILK_ERR_FONT_INVALID "Passed the invalid font."
 
 // --------------------------------------------------------------------------------------------------------------------------------
 // SECTION: Charset
 // --------------------------------------------------------------------------------------------------------------------------------
 
-static u8 silk_charset[128][SILK_DEFAULT_FONT_CHAR_HEIGHT][SILK_DEFAULT_FONT_CHAR_WIDTH] = {
-    { 0 }, // NUL
-    { 0 }, // SOH
-    { 0 }, // SXT
-    { 0 }, // EXT
-    { 0 }, // EOT
-    { 0 }, // ENQ
-    { 0 }, // ACK
-    { 0 }, // BEL
-    { 0 }, // BS
-    { 0 }, // HT
-    { 0 }, // LF
-    { 0 }, // VT
-    { 0 }, // FF
-    { 0 }, // CR
-    { 0 }, // SO
-    { 0 }, // SI
-    { 0 }, // DLE
-    { 0 }, // DC1
-    { 0 }, // DC2
-    { 0 }, // DC3
-    { 0 }, // DC4
-    { 0 }, // NAK
-    { 0 }, // SYN
-    { 0 }, // ETB
-    { 0 }, // CAN
-    { 0 }, // EM
-    { 0 }, // SUB
-    { 0 }, // ESC
-    { 0 }, // FS
-    { 0 }, // GS
-    { 0 }, // RS
-    { 0 }, // US
-    {
-        {0,0,0},
-        {0,0,0},
-        {0,0,0},
-        {0,0,0},
-        {0,0,0},
-    },
-    {
-        {0,1,0},
-        {0,1,0},
-        {0,1,0},
-        {0,0,0},
-        {0,1,0},
-    },
-    {
-        {1,0,1},
-        {1,0,1},
-        {0,0,0},
-        {0,0,0},
-        {0,0,0},
-    },
-    {
-        {1,0,1},
-        {1,1,1},
-        {1,0,1},
-        {1,1,1},
-        {1,0,1},
-    },
-
-    { 0 }, // $
-
-    {
-        {1,0,1},
-        {0,0,1},
-        {0,1,0},
-        {1,0,0},
-        {1,0,1},
-    },
-    {
-        {1,1,0},
-        {1,1,0},
-        {1,1,1},
-        {1,0,1},
-        {1,1,1},
-    },
-    {
-        {0,1,0},
-        {0,1,0},
-        {0,0,0},
-        {0,0,0},
-        {0,0,0},
-    },
-    {
-        {0,1,0},
-        {1,0,0},
-        {1,0,0},
-        {1,0,0},
-        {0,1,0},
-    },
-    {
-        {0,1,0},
-        {0,0,1},
-        {0,0,1},
-        {0,0,1},
-        {0,1,0},
-    },
-    {
-        {1,0,1},
-        {0,1,0},
-        {1,0,1},
-        {0,0,0},
-        {0,0,0},
-    },
-    {
-        {0,0,0},
-        {0,1,0},
-        {1,1,1},
-        {0,1,0},
-        {0,0,0},
-    },
-    {
-        {0,0,0},
-        {0,0,0},
-        {0,0,0},
-        {0,1,0},
-        {0,1,0},
-    },
-    {
-        {0,0,0},
-        {0,0,0},
-        {1,1,1},
-        {0,0,0},
-        {0,0,0},
-    },
-    {
-        {0,0,0},
-        {0,0,0},
-        {0,0,0},
-        {0,0,0},
-        {0,1,0},
-    },
-    {
-        {0,0,1},
-        {0,1,0},
-        {0,1,0},
-        {0,1,0},
-        {1,0,0},
-    },
-    {
-        {1,1,1},
-        {1,0,1},
-        {1,0,1},
-        {1,0,1},
-        {1,1,1},
-    },
-    {
-        {1,1,0},
-        {0,1,0},
-        {0,1,0},
-        {0,1,0},
-        {1,1,1},
-    },
-    {
-        {1,1,1},
-        {0,0,1},
-        {1,1,1},
-        {1,0,0},
-        {1,1,1},
-    },
-    {
-        {1,1,1},
-        {0,0,1},
-        {0,1,1},
-        {0,0,1},
-        {1,1,1},
-    },
-    {
-        {1,0,0},
-        {1,0,1},
-        {1,1,1},
-        {0,0,1},
-        {0,0,1},
-    },
-    {
-        {1,1,1},
-        {1,0,0},
-        {1,1,1},
-        {0,0,1},
-        {1,1,1},
-    },
-    {
-        {1,1,1},
-        {1,0,0},
-        {1,1,1},
-        {1,0,1},
-        {1,1,1},
-    },
-    {
-        {1,1,1},
-        {0,0,1},
-        {0,1,1},
-        {0,0,1},
-        {0,0,1},
-    },
-    {
-        {1,1,1},
-        {1,0,1},
-        {1,1,1},
-        {1,0,1},
-        {1,1,1},
-    },
-    {
-        {1,1,1},
-        {1,0,1},
-        {1,1,1},
-        {0,0,1},
-        {1,1,1},
-    },
-    {
-        {0,0,0},
-        {0,1,0},
-        {0,0,0},
-        {0,1,0},
-        {0,0,0},
-    },
-    {
-        {0,0,0},
-        {0,1,0},
-        {0,0,0},
-        {0,1,0},
-        {0,1,0},
-    },
-    {
-        {0,0,1},
-        {0,1,0},
-        {1,0,0},
-        {0,1,0},
-        {0,0,1},
-    },
-    {
-        {0,0,0},
-        {1,1,1},
-        {0,0,0},
-        {1,1,1},
-        {0,0,0},
-    },
-    {
-        {1,0,0},
-        {0,1,0},
-        {0,0,1},
-        {0,1,0},
-        {1,0,0},
-    },
-    {
-        {1,1,1},
-        {0,0,1},
-        {0,1,1},
-        {0,0,0},
-        {0,1,0},
-    },
-    {
-        {0,1,0},
-        {1,0,1},
-        {1,0,1},
-        {1,0,0},
-        {0,1,1},
-    },
-    {
-        {1,1,1},
-        {1,0,1},
-        {1,1,1},
-        {1,0,1},
-        {1,0,1},
-    },
-    {
-        {1,1,0},
-        {1,0,1},
-        {1,1,0},
-        {1,0,1},
-        {1,1,0},
-    },
-    {
-        {1,1,0},
-        {1,0,1},
-        {1,0,0},
-        {1,0,1},
-        {1,1,0},
-    },
-    {
-        {1,1,0},
-        {1,0,1},
-        {1,0,1},
-        {1,0,1},
-        {1,1,0},
-    },
-    {
-        {1,1,1},
-        {1,0,0},
-        {1,1,0},
-        {1,0,0},
-        {1,1,1},
-    },
-    {
-        {1,1,1},
-        {1,0,0},
-        {1,1,0},
-        {1,0,0},
-        {1,0,0},
-    },
-    {
-        {1,1,1},
-        {1,0,0},
-        {1,0,1},
-        {1,0,1},
-        {1,1,1},
-    },
-    {
-        {1,0,1},
-        {1,0,1},
-        {1,1,1},
-        {1,0,1},
-        {1,0,1},
-    },
-    {
-        {1,1,1},
-        {0,1,0},
-        {0,1,0},
-        {0,1,0},
-        {1,1,1},
-    },
-    {
-        {1,1,1},
-        {0,0,1},
-        {0,0,1},
-        {1,0,1},
-        {0,1,0},
-    },
-    {
-        {1,0,1},
-        {1,0,1},
-        {1,1,0},
-        {1,0,1},
-        {1,0,1},
-    },
-    {
-        {1,0,0},
-        {1,0,0},
-        {1,0,0},
-        {1,0,0},
-        {1,1,1},
-    },
-    {
-        {1,0,1},
-        {1,1,1},
-        {1,0,1},
-        {1,0,1},
-        {1,0,1},
-    },
-    {
-        {1,1,0},
-        {1,0,1},
-        {1,0,1},
-        {1,0,1},
-        {1,0,1},
-    },
-    {
-        {1,1,0},
-        {1,0,1},
-        {1,0,1},
-        {1,0,1},
-        {0,1,1},
-    },
-    {
-        {1,1,0},
-        {1,0,1},
-        {1,1,0},
-        {1,0,0},
-        {1,0,0},
-    },
-    {
-        {1,1,1},
-        {1,0,1},
-        {1,0,1},
-        {1,1,1},
-        {0,0,1},
-    },
-    {
-        {1,1,0},
-        {1,0,1},
-        {1,1,0},
-        {1,0,1},
-        {1,0,1},
-    },
-    {
-        {1,1,1},
-        {1,0,0},
-        {1,1,1},
-        {0,0,1},
-        {1,1,1},
-    },
-    {
-        {1,1,1},
-        {0,1,0},
-        {0,1,0},
-        {0,1,0},
-        {0,1,0},
-    },
-    {
-        {1,0,1},
-        {1,0,1},
-        {1,0,1},
-        {1,0,1},
-        {1,1,1},
-    },
-    {
-        {1,0,1},
-        {1,0,1},
-        {1,0,1},
-        {1,0,1},
-        {0,1,0},
-    },
-    {
-        {1,0,1},
-        {1,0,1},
-        {1,0,1},
-        {1,1,1},
-        {1,0,1},
-    },
-    {
-        {1,0,1},
-        {1,0,1},
-        {0,1,0},
-        {1,0,1},
-        {1,0,1},
-    },
-    {
-        {1,0,1},
-        {1,0,1},
-        {1,0,1},
-        {0,1,0},
-        {0,1,0},
-    },
-    {
-        {1,1,1},
-        {0,0,1},
-        {0,1,0},
-        {1,0,0},
-        {1,1,1},
-    },
-    {
-        {0,1,1},
-        {0,1,0},
-        {0,1,0},
-        {0,1,0},
-        {0,1,1},
-    },
-    {
-        {1,0,0},
-        {0,1,0},
-        {0,1,0},
-        {0,1,0},
-        {0,0,1},
-    },
-    {
-        {1,1,0},
-        {0,1,0},
-        {0,1,0},
-        {0,1,0},
-        {1,1,0},
-    },
-    {
-        {0,1,0},
-        {1,0,1},
-        {0,0,0},
-        {0,0,0},
-        {0,0,0},
-    },
-
-    { 0 }, // _
-
-    {
-        {0,1,0},
-        {0,0,1},
-        {0,0,0},
-        {0,0,0},
-        {0,0,0},
-    },
-    {
-        {0,0,0},
-        {0,1,1},
-        {1,0,1},
-        {1,1,1},
-        {1,0,1},
-    },
-    {
-        {1,0,0},
-        {1,1,0},
-        {1,0,1},
-        {1,0,1},
-        {0,1,0},
-    },
-    {
-        {0,0,0},
-        {0,1,1},
-        {1,0,0},
-        {1,0,0},
-        {0,1,1},
-    },
-    {
-        {0,0,1},
-        {0,1,1},
-        {1,0,1},
-        {1,0,1},
-        {0,1,1},
-    },
-    {
-        {0,0,0},
-        {1,1,1},
-        {1,1,1},
-        {1,0,0},
-        {1,1,1},
-    },
-    {
-        {0,1,1},
-        {0,1,0},
-        {1,1,1},
-        {0,1,0},
-        {0,1,0},
-    },
-    {
-        {0,0,0},
-        {1,1,1},
-        {1,0,0},
-        {1,0,1},
-        {1,1,1},
-    },
-    {
-        {1,0,0},
-        {1,1,0},
-        {1,0,1},
-        {1,0,1},
-        {1,0,1},
-    },
-    {
-        {0,1,0},
-        {0,0,0},
-        {0,1,0},
-        {0,1,0},
-        {0,1,0},
-    },
-    {
-        {0,0,0},
-        {1,1,1},
-        {0,0,1},
-        {0,0,1},
-        {0,1,0},
-    },
-    {
-        {1,0,0},
-        {1,0,1},
-        {1,1,0},
-        {1,0,1},
-        {1,0,1},
-    },
-    {
-        {0,1,0},
-        {0,1,0},
-        {0,1,0},
-        {0,1,0},
-        {0,0,1},
-    },
-    {
-        {0,0,0},
-        {1,0,1},
-        {1,1,1},
-        {1,0,1},
-        {1,0,1},
-    },
-    {
-        {0,0,0},
-        {1,1,0},
-        {1,0,1},
-        {1,0,1},
-        {1,0,1},
-    },
-    {
-        {0,0,0},
-        {1,1,0},
-        {1,0,1},
-        {1,0,1},
-        {0,1,1},
-    },
-    {
-        {0,0,0},
-        {1,1,0},
-        {1,0,1},
-        {1,1,0},
-        {1,0,0},
-    },
-    {
-        {0,0,0},
-        {0,1,1},
-        {1,0,1},
-        {0,1,1},
-        {0,0,1},
-    },
-    {
-        {0,0,0},
-        {1,0,1},
-        {1,1,0},
-        {1,0,0},
-        {1,0,0},
-    },
-    {
-        {0,0,0},
-        {0,1,1},
-        {1,0,0},
-        {0,0,1},
-        {1,1,0},
-    },
-    {
-        {0,1,0},
-        {1,1,1},
-        {0,1,0},
-        {0,1,0},
-        {0,1,0},
-    },
-    {
-        {0,0,0},
-        {1,0,1},
-        {1,0,1},
-        {1,0,1},
-        {1,1,1},
-    },
-    {
-        {0,0,0},
-        {1,0,1},
-        {1,0,1},
-        {1,0,1},
-        {0,1,0},
-    },
-    {
-        {0,0,0},
-        {1,0,1},
-        {1,0,1},
-        {1,1,1},
-        {1,0,1},
-    },
-    {
-        {0,0,0},
-        {1,0,1},
-        {0,1,0},
-        {1,0,1},
-        {1,0,1},
-    },
-    {
-        {0,0,0},
-        {1,0,1},
-        {1,1,1},
-        {0,1,0},
-        {0,1,0},
-    },
-    {
-        {0,0,0},
-        {1,1,1},
-        {0,0,1},
-        {0,1,0},
-        {1,1,1},
-    },
-    {
-        {0,0,1},
-        {0,1,0},
-        {1,1,0},
-        {0,1,0},
-        {0,0,1},
-    },
-    {
-        {0,1,0},
-        {0,1,0},
-        {0,1,0},
-        {0,1,0},
-        {0,1,0},
-    },
-    {
-        {1,0,0},
-        {0,1,0},
-        {0,1,1},
-        {0,1,0},
-        {1,0,0},
-    },
-    {
-        {0,0,0},
-        {1,1,1},
-        {0,0,0},
-        {0,0,0},
-        {0,0,0},
-    },
-
-    { 0 } // DEL
+// Every glyph is a row mask per row of the font: bit 'x' of the row is it's column 'x' (bit 0 is the leftmost one)
+static const u8 silk_charset[128][SILK_DEFAULT_FONT_CHAR_HEIGHT] = {
+    { 0x0, 0x0, 0x0, 0x0, 0x0 }, // NUL
+    { 0x0, 0x0, 0x0, 0x0, 0x0 }, // SOH
+    { 0x0, 0x0, 0x0, 0x0, 0x0 }, // SXT
+    { 0x0, 0x0, 0x0, 0x0, 0x0 }, // EXT
+    { 0x0, 0x0, 0x0, 0x0, 0x0 }, // EOT
+    { 0x0, 0x0, 0x0, 0x0, 0x0 }, // ENQ
+    { 0x0, 0x0, 0x0, 0x0, 0x0 }, // ACK
+    { 0x0, 0x0, 0x0, 0x0, 0x0 }, // BEL
+    { 0x0, 0x0, 0x0, 0x0, 0x0 }, // BS
+    { 0x0, 0x0, 0x0, 0x0, 0x0 }, // HT
+    { 0x0, 0x0, 0x0, 0x0, 0x0 }, // LF
+    { 0x0, 0x0, 0x0, 0x0, 0x0 }, // VT
+    { 0x0, 0x0, 0x0, 0x0, 0x0 }, // FF
+    { 0x0, 0x0, 0x0, 0x0, 0x0 }, // CR
+    { 0x0, 0x0, 0x0, 0x0, 0x0 }, // SO
+    { 0x0, 0x0, 0x0, 0x0, 0x0 }, // SI
+    { 0x0, 0x0, 0x0, 0x0, 0x0 }, // DLE
+    { 0x0, 0x0, 0x0, 0x0, 0x0 }, // DC1
+    { 0x0, 0x0, 0x0, 0x0, 0x0 }, // DC2
+    { 0x0, 0x0, 0x0, 0x0, 0x0 }, // DC3
+    { 0x0, 0x0, 0x0, 0x0, 0x0 }, // DC4
+    { 0x0, 0x0, 0x0, 0x0, 0x0 }, // NAK
+    { 0x0, 0x0, 0x0, 0x0, 0x0 }, // SYN
+    { 0x0, 0x0, 0x0, 0x0, 0x0 }, // ETB
+    { 0x0, 0x0, 0x0, 0x0, 0x0 }, // CAN
+    { 0x0, 0x0, 0x0, 0x0, 0x0 }, // EM
+    { 0x0, 0x0, 0x0, 0x0, 0x0 }, // SUB
+    { 0x0, 0x0, 0x0, 0x0, 0x0 }, // ESC
+    { 0x0, 0x0, 0x0, 0x0, 0x0 }, // FS
+    { 0x0, 0x0, 0x0, 0x0, 0x0 }, // GS
+    { 0x0, 0x0, 0x0, 0x0, 0x0 }, // RS
+    { 0x0, 0x0, 0x0, 0x0, 0x0 }, // US
+    { 0x0, 0x0, 0x0, 0x0, 0x0 }, // Space
+    { 0x2, 0x2, 0x2, 0x0, 0x2 }, // !
+    { 0x5, 0x5, 0x0, 0x0, 0x0 }, // "
+    { 0x5, 0x7, 0x5, 0x7, 0x5 }, // #
+    { 0x0, 0x0, 0x0, 0x0, 0x0 }, // $
+    { 0x5, 0x4, 0x2, 0x1, 0x5 }, // %
+    { 0x3, 0x3, 0x7, 0x5, 0x7 }, // &
+    { 0x2, 0x2, 0x0, 0x0, 0x0 }, // '
+    { 0x2, 0x1, 0x1, 0x1, 0x2 }, // (
+    { 0x2, 0x4, 0x4, 0x4, 0x2 }, // )
+    { 0x5, 0x2, 0x5, 0x0, 0x0 }, // *
+    { 0x0, 0x2, 0x7, 0x2, 0x0 }, // +
+    { 0x0, 0x0, 0x0, 0x2, 0x2 }, // ,
+    { 0x0, 0x0, 0x7, 0x0, 0x0 }, // -
+    { 0x0, 0x0, 0x0, 0x0, 0x2 }, // .
+    { 0x4, 0x2, 0x2, 0x2, 0x1 }, // /
+    { 0x7, 0x5, 0x5, 0x5, 0x7 }, // 0
+    { 0x3, 0x2, 0x2, 0x2, 0x7 }, // 1
+    { 0x7, 0x4, 0x7, 0x1, 0x7 }, // 2
+    { 0x7, 0x4, 0x6, 0x4, 0x7 }, // 3
+    { 0x1, 0x5, 0x7, 0x4, 0x4 }, // 4
+    { 0x7, 0x1, 0x7, 0x4, 0x7 }, // 5
+    { 0x7, 0x1, 0x7, 0x5, 0x7 }, // 6
+    { 0x7, 0x4, 0x6, 0x4, 0x4 }, // 7
+    { 0x7, 0x5, 0x7, 0x5, 0x7 }, // 8
+    { 0x7, 0x5, 0x7, 0x4, 0x7 }, // 9
+    { 0x0, 0x2, 0x0, 0x2, 0x0 }, // :
+    { 0x0, 0x2, 0x0, 0x2, 0x2 }, // ;
+    { 0x4, 0x2, 0x1, 0x2, 0x4 }, // <
+    { 0x0, 0x7, 0x0, 0x7, 0x0 }, // =
+    { 0x1, 0x2, 0x4, 0x2, 0x1 }, // >
+    { 0x7, 0x4, 0x6, 0x0, 0x2 }, // ?
+    { 0x2, 0x5, 0x5, 0x1, 0x6 }, // @
+    { 0x7, 0x5, 0x7, 0x5, 0x5 }, // A
+    { 0x3, 0x5, 0x3, 0x5, 0x3 }, // B
+    { 0x3, 0x5, 0x1, 0x5, 0x3 }, // C
+    { 0x3, 0x5, 0x5, 0x5, 0x3 }, // D
+    { 0x7, 0x1, 0x3, 0x1, 0x7 }, // E
+    { 0x7, 0x1, 0x3, 0x1, 0x1 }, // F
+    { 0x7, 0x1, 0x5, 0x5, 0x7 }, // G
+    { 0x5, 0x5, 0x7, 0x5, 0x5 }, // H
+    { 0x7, 0x2, 0x2, 0x2, 0x7 }, // I
+    { 0x7, 0x4, 0x4, 0x5, 0x2 }, // J
+    { 0x5, 0x5, 0x3, 0x5, 0x5 }, // K
+    { 0x1, 0x1, 0x1, 0x1, 0x7 }, // L
+    { 0x5, 0x7, 0x5, 0x5, 0x5 }, // M
+    { 0x3, 0x5, 0x5, 0x5, 0x5 }, // N
+    { 0x3, 0x5, 0x5, 0x5, 0x6 }, // O
+    { 0x3, 0x5, 0x3, 0x1, 0x1 }, // P
+    { 0x7, 0x5, 0x5, 0x7, 0x4 }, // Q
+    { 0x3, 0x5, 0x3, 0x5, 0x5 }, // R
+    { 0x7, 0x1, 0x7, 0x4, 0x7 }, // S
+    { 0x7, 0x2, 0x2, 0x2, 0x2 }, // T
+    { 0x5, 0x5, 0x5, 0x5, 0x7 }, // U
+    { 0x5, 0x5, 0x5, 0x5, 0x2 }, // V
+    { 0x5, 0x5, 0x5, 0x7, 0x5 }, // W
+    { 0x5, 0x5, 0x2, 0x5, 0x5 }, // X
+    { 0x5, 0x5, 0x5, 0x2, 0x2 }, // Y
+    { 0x7, 0x4, 0x2, 0x1, 0x7 }, // Z
+    { 0x6, 0x2, 0x2, 0x2, 0x6 }, // [
+    { 0x1, 0x2, 0x2, 0x2, 0x4 }, // Backslash
+    { 0x3, 0x2, 0x2, 0x2, 0x3 }, // ]
+    { 0x2, 0x5, 0x0, 0x0, 0x0 }, // ^
+    { 0x0, 0x0, 0x0, 0x0, 0x0 }, // _
+    { 0x2, 0x4, 0x0, 0x0, 0x0 }, // `
+    { 0x0, 0x6, 0x5, 0x7, 0x5 }, // a
+    { 0x1, 0x3, 0x5, 0x5, 0x2 }, // b
+    { 0x0, 0x6, 0x1, 0x1, 0x6 }, // c
+    { 0x4, 0x6, 0x5, 0x5, 0x6 }, // d
+    { 0x0, 0x7, 0x7, 0x1, 0x7 }, // e
+    { 0x6, 0x2, 0x7, 0x2, 0x2 }, // f
+    { 0x0, 0x7, 0x1, 0x5, 0x7 }, // g
+    { 0x1, 0x3, 0x5, 0x5, 0x5 }, // h
+    { 0x2, 0x0, 0x2, 0x2, 0x2 }, // i
+    { 0x0, 0x7, 0x4, 0x4, 0x2 }, // j
+    { 0x1, 0x5, 0x3, 0x5, 0x5 }, // k
+    { 0x2, 0x2, 0x2, 0x2, 0x4 }, // l
+    { 0x0, 0x5, 0x7, 0x5, 0x5 }, // m
+    { 0x0, 0x3, 0x5, 0x5, 0x5 }, // n
+    { 0x0, 0x3, 0x5, 0x5, 0x6 }, // o
+    { 0x0, 0x3, 0x5, 0x3, 0x1 }, // p
+    { 0x0, 0x6, 0x5, 0x6, 0x4 }, // q
+    { 0x0, 0x5, 0x3, 0x1, 0x1 }, // r
+    { 0x0, 0x6, 0x1, 0x4, 0x3 }, // s
+    { 0x2, 0x7, 0x2, 0x2, 0x2 }, // t
+    { 0x0, 0x5, 0x5, 0x5, 0x7 }, // u
+    { 0x0, 0x5, 0x5, 0x5, 0x2 }, // v
+    { 0x0, 0x5, 0x5, 0x7, 0x5 }, // w
+    { 0x0, 0x5, 0x2, 0x5, 0x5 }, // x
+    { 0x0, 0x5, 0x7, 0x2, 0x2 }, // y
+    { 0x0, 0x7, 0x4, 0x2, 0x7 }, // z
+    { 0x4, 0x2, 0x3, 0x2, 0x4 }, // {
+    { 0x2, 0x2, 0x2, 0x2, 0x2 }, // |
+    { 0x1, 0x2, 0x6, 0x2, 0x1 }, // }
+    { 0x0, 0x7, 0x0, 0x0, 0x0 }, // ~
+    { 0x0, 0x0, 0x0, 0x0, 0x0 }  // DEL
+};
+
+static const silk_bitmap_font silk_default_font = {
+    &silk_charset[0][0],
+    { SILK_DEFAULT_FONT_CHAR_WIDTH, SILK_DEFAULT_FONT_CHAR_HEIGHT },
+    128
 };
 
 // --------------------------------------------------------------------------------------------------------------------------------
@@ -1093,874 +995,8587 @@ static u8 silk_charset[128][SILK_DEFAULT_FONT_CHAR_HEIGHT][SILK_DEFAULT_FONT_CHA
 // --------------------------------------------------------------------------------------------------------------------------------
 
 static char silk_error_msg[SILK_TEXT_BUFFER_SIZE] = SILK_ERR_MSG_EMPTY;
+static i32 silk_rasterizer = SILK_RASTERIZER_DEFAULT;
+static i32 silk_thread_count = 1;
 
 // --------------------------------------------------------------------------------------------------------------------------------
-// SECTION: Internal functions
+// SECTION: SIMD Kernels
 // --------------------------------------------------------------------------------------------------------------------------------
 
-static i32 silkAssignErrorMessage(const string msg) {
-    strcpy(
-        silk_error_msg,
-        msg
-    );
+// Every hot loop of Silk (fills, blends, conversions...) is implemented as a "kernel": scalar version, plus SIMD versions
+// for the instruction sets that make sense for it. Kernels are picked once, on the first use, based on the CPU features
+// (cpuid on x86), and stored in the 'silk_kernels' table. The SIMD kernels are compiled with the target attributes,
+// so there's no need to pass any '-m' flags to the compiler.
 
-    return SILK_SUCCESS;
+#if defined(_MSC_VER) && !defined(__clang__)
+    #define SILK_TARGET(name)
+#else
+    #define SILK_TARGET(name) __attribute__((target(name)))
+#endif // _MSC_VER
+
+#if defined(_MSC_VER)
+    #define SILK_FORCE_INLINE __forceinline
+#else
+    #define SILK_FORCE_INLINE inline __attribute__((always_inline))
+#endif // _MSC_VER
+
+typedef void (*silk_fill_kernel)(pixel* dest, i32 count, pixel pix);
+typedef void (*silk_blend_kernel)(pixel* dest, i32 count, pixel pix);
+typedef void (*silk_blend_image_kernel)(pixel* dest, const pixel* src, i32 count);
+typedef u64 (*silk_tile_coverage_kernel)(const i32 edge[3], const i32 step_x[3], const i32 step_y[3]);
+typedef void (*silk_convert_kernel)(void* dest, const void* src, i32 count);
+typedef void (*silk_hash_kernel)(u64* acc, const u8* data, i32 stripes, const u64* keys);
+
+typedef struct {
+    u32 features;
+    bool ready;
+
+    silk_fill_kernel fill;                  // fill: regular stores
+    silk_fill_kernel fill_stream;           // fill: non-temporal stores (used for the big, contiguous clears)
+    silk_blend_kernel blend[SILK_BLEND_MODE_COUNT];             // blend: one color (and it's alpha) over the whole span, per blend mode
+    silk_blend_image_kernel blend_image[SILK_BLEND_MODE_COUNT]; // blend: every source pixel with it's own alpha (images), per blend mode
+    silk_tile_coverage_kernel tile_coverage;// raster: coverage mask of one 8x8 tile (bit 'y * 8 + x')
+    silk_convert_kernel pack[SILK_PIXELFORMAT_COUNT];   // convert: RGBA8888 row to the format
+    silk_convert_kernel unpack[SILK_PIXELFORMAT_COUNT]; // convert: row of the format to RGBA8888
+    silk_hash_kernel hash;                  // hash: 64-byte stripes into the 8 accumulators
+} silk_kernel_table;
+
+static silk_kernel_table silk_kernels = { 0 };
+
+// Blending is the exact, integer "source-over":
+//      color:  dst + (src - dst) * a / 255
+//      alpha:  a + dst_a * (255 - a) / 255
+// The alpha is the very same lerp, if the source alpha channel is replaced with 255, so all four channels go through one formula.
+// With the premultiplied alpha ('SILK_PREMULTIPLIED_ALPHA') the source is already multiplied by its alpha, so every channel
+// (the alpha included) is just one multiply-add: src + dst * (255 - a) / 255, saturated at 255.
+// The division by 255 is rounded exactly, without any division: t = x + 128; x / 255 = (t + (t >> 8)) >> 8 = (t * 257) >> 16.
+// The scalar version works on two channels at once, in the 16-bit halves of a 32-bit integer (0x00ff00ff masks);
+// the SIMD versions widen the channels to 16-bit lanes and blend 4, 8 or 16 pixels per instruction.
+
+static pixel silkScalePixel(pixel pix, u32 factor) {
+    // All four channels times 'factor / 255' (premultiplying, fading by the coverage)
+    u32 rb = (pix & 0x00ff00ff) * factor + 0x00800080;
+    u32 ag = ((pix >> 8) & 0x00ff00ff) * factor + 0x00800080;
+
+    rb = ((rb + ((rb >> 8) & 0x00ff00ff)) >> 8) & 0x00ff00ff;
+    ag = (ag + ((ag >> 8) & 0x00ff00ff)) & 0xff00ff00;
+
+    return rb | ag;
 }
 
-// --------------------------------------------------------------------------------------------------------------------------------
-// SECTION: API
-// --------------------------------------------------------------------------------------------------------------------------------
+static pixel silkBlendPixel(pixel dst, pixel src, u32 alpha) {
+    u32 inv_alpha = 255 - alpha;
 
-// --------------------------------------------------------------------------------------------------------------------------------
-// SECTION MODULE: Pixel buffer
-// --------------------------------------------------------------------------------------------------------------------------------
+#if defined(SILK_PREMULTIPLIED_ALPHA)
 
-SILK_API i32 silkClearPixelBuffer(pixel* buffer) {
-    if(buffer == NULL) {
-        silkAssignErrorMessage(SILK_ERR_BUF_INVALID);
+    pixel faded = silkScalePixel(dst, inv_alpha);
 
-        return SILK_FAILURE;
-    }
+    u32 rb = (faded & 0x00ff00ff) + (src & 0x00ff00ff);
+    u32 ag = ((faded >> 8) & 0x00ff00ff) + ((src >> 8) & 0x00ff00ff);
 
-    for(i32 pixel_index = 0; pixel_index < SILK_PIXELBUFFER_WIDTH * SILK_PIXELBUFFER_HEIGHT; pixel_index++) {
-        buffer[pixel_index] = 0;
-    }
+    // Channels brighter than their alpha could overflow into the neighbouring ones, so the 9th bit saturates them
+    rb = (rb | (0x01000100 - ((rb >> 8) & 0x00010001))) & 0x00ff00ff;
+    ag = (ag | (0x01000100 - ((ag >> 8) & 0x00010001))) & 0x00ff00ff;
 
-    return SILK_SUCCESS;
+    return rb | (ag << 8);
+
+#else
+
+    src |= SILK_PIXEL_ALPHA_MASK;
+
+    u32 rb = (src & 0x00ff00ff) * alpha + (dst & 0x00ff00ff) * inv_alpha + 0x00800080;
+    u32 ag = ((src >> 8) & 0x00ff00ff) * alpha + ((dst >> 8) & 0x00ff00ff) * inv_alpha + 0x00800080;
+
+    rb = ((rb + ((rb >> 8) & 0x00ff00ff)) >> 8) & 0x00ff00ff;
+    ag = (ag + ((ag >> 8) & 0x00ff00ff)) & 0xff00ff00;
+
+    return rb | ag;
+
+#endif // SILK_PREMULTIPLIED_ALPHA
 }
 
-SILK_API i32 silkClearPixelBufferRegion(pixel* buffer, vec2i region, i32 stride) {
-    if(buffer == NULL) {
-        silkAssignErrorMessage(SILK_ERR_BUF_INVALID);
+static void silkBlendScalar(pixel* dest, i32 count, pixel pix) {
+    u32 alpha = (pix & SILK_PIXEL_ALPHA_MASK) >> SILK_PIXEL_ALPHA_SHIFT;
 
-        return SILK_FAILURE;
+    for(i32 i = 0; i < count; i++) {
+        dest[i] = silkBlendPixel(dest[i], pix, alpha);
     }
+}
 
-    for(i32 y = 0; y < region.y; y++) {
-        for(i32 x = 0; x < region.x; x++) {
-            silkSetPixel(buffer, (vec2i) { x, y }, stride, 0);
+static void silkBlendImageScalar(pixel* dest, const pixel* src, i32 count) {
+    for(i32 i = 0; i < count; i++) {
+        u32 alpha = (src[i] & SILK_PIXEL_ALPHA_MASK) >> SILK_PIXEL_ALPHA_SHIFT;
+
+        // Opaque pixels are stored and the transparent ones skipped (see: 'silkPixelTransparent')
+        if(alpha == 255) {
+            dest[i] = src[i];
+        } else if(alpha != 0) {
+            dest[i] = silkBlendPixel(dest[i], src[i], alpha);
         }
     }
+}
 
-    return SILK_SUCCESS;
+// Blend modes:
+// Every mode other than "source-over" first combines the channels of the canvas and the color with it's blend function
+// 'B(canvas, color)', and then the result is laid over the canvas by the alpha, just like in "source-over":
+//      color:  canvas + (B - canvas) * a / 255
+//      alpha:  a + canvas_a * (255 - a) / 255
+// So the fully transparent color leaves the canvas untouched in every mode (except "replace", which is a plain store).
+// The premultiplied modes are the W3C ones, with the canvas alpha as well; all four channels go through the same formula:
+//      additive:   min(255, src + dst)
+//      screen:     src + dst - src * dst / 255
+//      others:     (X + src * (255 - dst_a) + dst * (255 - a)) / 255, where X is 'src * dst' (multiply) or the smaller / bigger
+//                  of 'src * dst_a' and 'dst * a' (min / max)
+// The shared bodies below are force-inlined into one kernel per mode, with the mode as a constant,
+// so the switch is resolved at the compile time and there's no branching on the mode inside of the loops.
+// Source: https://www.w3.org/TR/compositing-1/#blending
+
+static SILK_FORCE_INLINE u32 silkBlendChannel(u32 dst, u32 src, i32 mode) {
+    u32 product = dst * src + 128;
+    product = (product + (product >> 8)) >> 8;
+
+    switch(mode) {
+        case SILK_BLEND_MODE_ADDITIVE: return dst + src > 255 ? 255 : dst + src;
+        case SILK_BLEND_MODE_MULTIPLY: return product;
+        case SILK_BLEND_MODE_SCREEN: return dst + src - product;
+        case SILK_BLEND_MODE_MIN: return dst < src ? dst : src;
+        case SILK_BLEND_MODE_MAX: return dst > src ? dst : src;
+        default: return src;
+    }
 }
 
-SILK_API i32 silkClearPixelBufferColor(pixel* buffer, pixel pix) {
-    if(buffer == NULL) {
-        silkAssignErrorMessage(SILK_ERR_BUF_INVALID);
+static SILK_FORCE_INLINE u32 silkBlendChannelPremultiplied(u32 dst, u32 src, u32 dst_alpha, u32 alpha, i32 mode) {
+    u32 x = dst * src;
 
-        return SILK_FAILURE;
+    switch(mode) {
+        case SILK_BLEND_MODE_ADDITIVE: return dst + src > 255 ? 255 : dst + src;
+        case SILK_BLEND_MODE_SCREEN: x += 128; return dst + src - ((x + (x >> 8)) >> 8);
+        case SILK_BLEND_MODE_MULTIPLY: break;
+        case SILK_BLEND_MODE_MIN: x = src * dst_alpha < dst * alpha ? src * dst_alpha : dst * alpha; break;
+        case SILK_BLEND_MODE_MAX: x = src * dst_alpha > dst * alpha ? src * dst_alpha : dst * alpha; break;
+        default: return src;
     }
 
-    for(i32 pixel_index = 0; pixel_index < SILK_PIXELBUFFER_WIDTH * SILK_PIXELBUFFER_HEIGHT; pixel_index++) {
-        buffer[pixel_index] = pix;
-    }
+    x += src * (255 - dst_alpha) + dst * (255 - alpha) + 128;
 
-    return SILK_SUCCESS;
+    return (x + (x >> 8)) >> 8;
 }
 
-SILK_API i32 silkClearPixelBufferColorRegion(pixel* buffer, vec2i region, i32 stride, pixel pix) {
-    if(buffer == NULL) {
-        silkAssignErrorMessage(SILK_ERR_BUF_INVALID);
+static SILK_FORCE_INLINE pixel silkBlendModePixel(pixel dst, pixel src, u32 alpha, i32 mode) {
+    pixel blended = 0;
 
-        return SILK_FAILURE;
-    }
+#if defined(SILK_PREMULTIPLIED_ALPHA)
 
-    for(i32 y = 0; y < region.y; y++) {
-        for(i32 x = 0; x < region.x; x++) {
-            silkSetPixel(buffer, (vec2i) { x, y }, stride, pix);
-        }
+    u32 dst_alpha = (dst & SILK_PIXEL_ALPHA_MASK) >> SILK_PIXEL_ALPHA_SHIFT;
+
+    for(i32 shift = 0; shift < 32; shift += 8) {
+        blended |= silkBlendChannelPremultiplied((dst >> shift) & 0xff, (src >> shift) & 0xff, dst_alpha, alpha, mode) << shift;
     }
 
-    return SILK_SUCCESS;
-}
+    return blended;
 
-SILK_API pixel silkGetPixel(pixel* buffer, vec2i position, i32 stride) {
-    return buffer[position.y * stride + position.x];
-}
+#else
 
-SILK_API i32 silkSetPixel(pixel* buffer, vec2i position, i32 stride, pixel pix) {
-    buffer[position.y * stride + position.x] = pix;
+    for(i32 shift = 0; shift < 32; shift += 8) {
+        blended |= silkBlendChannel((dst >> shift) & 0xff, (src >> shift) & 0xff, mode) << shift;
+    }
 
-    return SILK_SUCCESS;
+    // Alpha channel of 'blended' is replaced with 255 here, so the canvas alpha is the "source-over" one
+    return silkBlendPixel(dst, blended, alpha);
+
+#endif // SILK_PREMULTIPLIED_ALPHA
 }
 
-SILK_API i32 silkUnloadBuffer(pixel* buffer) {
-    if(buffer == NULL) {
-        silkAssignErrorMessage(SILK_ERR_BUF_INVALID);
+static SILK_FORCE_INLINE void silkBlendModeScalar(pixel* dest, i32 count, pixel pix, i32 mode) {
+    u32 alpha = (pix & SILK_PIXEL_ALPHA_MASK) >> SILK_PIXEL_ALPHA_SHIFT;
 
-        return SILK_FAILURE;
+    for(i32 i = 0; i < count; i++) {
+        dest[i] = silkBlendModePixel(dest[i], pix, alpha, mode);
     }
+}
 
-    SILK_FREE(buffer);
+static SILK_FORCE_INLINE void silkBlendImageModeScalar(pixel* dest, const pixel* src, i32 count, i32 mode) {
+    for(i32 i = 0; i < count; i++) {
+        u32 alpha = (src[i] & SILK_PIXEL_ALPHA_MASK) >> SILK_PIXEL_ALPHA_SHIFT;
 
-    return SILK_SUCCESS;
+        if(alpha != 0) {
+            dest[i] = silkBlendModePixel(dest[i], src[i], alpha, mode);
+        }
+    }
 }
 
-// --------------------------------------------------------------------------------------------------------------------------------
-// SECTION MODULE: Pixels and Colors
-// --------------------------------------------------------------------------------------------------------------------------------
+static void silkBlendAdditiveScalar(pixel* dest, i32 count, pixel pix) { silkBlendModeScalar(dest, count, pix, SILK_BLEND_MODE_ADDITIVE); }
+static void silkBlendMultiplyScalar(pixel* dest, i32 count, pixel pix) { silkBlendModeScalar(dest, count, pix, SILK_BLEND_MODE_MULTIPLY); }
+static void silkBlendScreenScalar(pixel* dest, i32 count, pixel pix) { silkBlendModeScalar(dest, count, pix, SILK_BLEND_MODE_SCREEN); }
+static void silkBlendMinScalar(pixel* dest, i32 count, pixel pix) { silkBlendModeScalar(dest, count, pix, SILK_BLEND_MODE_MIN); }
+static void silkBlendMaxScalar(pixel* dest, i32 count, pixel pix) { silkBlendModeScalar(dest, count, pix, SILK_BLEND_MODE_MAX); }
+
+static void silkBlendImageAdditiveScalar(pixel* dest, const pixel* src, i32 count) { silkBlendImageModeScalar(dest, src, count, SILK_BLEND_MODE_ADDITIVE); }
+static void silkBlendImageMultiplyScalar(pixel* dest, const pixel* src, i32 count) { silkBlendImageModeScalar(dest, src, count, SILK_BLEND_MODE_MULTIPLY); }
+static void silkBlendImageScreenScalar(pixel* dest, const pixel* src, i32 count) { silkBlendImageModeScalar(dest, src, count, SILK_BLEND_MODE_SCREEN); }
+static void silkBlendImageMinScalar(pixel* dest, const pixel* src, i32 count) { silkBlendImageModeScalar(dest, src, count, SILK_BLEND_MODE_MIN); }
+static void silkBlendImageMaxScalar(pixel* dest, const pixel* src, i32 count) { silkBlendImageModeScalar(dest, src, count, SILK_BLEND_MODE_MAX); }
+
+static void silkCopyScalar(pixel* dest, const pixel* src, i32 count) {
+    // "Replace" of the images
+    memcpy(dest, src, (size_t) count * sizeof(pixel));
+}
 
-SILK_API color silkPixelToColor(pixel pix) {
-    color result = { 0 };
+// Tile coverage:
+// 'edge' holds the values of the three edge functions at the top-left pixel of an 8x8 tile, 'step_x' / 'step_y'
+// their increments per pixel. Pixel is covered when none of the three values is negative.
+// The tile walker passes zeros for the edges that already cover the whole tile, so they never reject anything.
 
-#if defined(SILK_BYTEORDER_LITTLE_ENDIAN)
+static u64 silkTileCoverageScalar(const i32 edge[3], const i32 step_x[3], const i32 step_y[3]) {
+    u64 mask = 0;
 
-    result.r = (pix >> 8 * 0) & 0xFF;
-    result.g = (pix >> 8 * 1) & 0xFF;
-    result.b = (pix >> 8 * 2) & 0xFF;
-    result.a = (pix >> 8 * 3) & 0xFF;
+    for(i32 y = 0; y < SILK_RASTER_TILE_SIZE; y++) {
+        for(i32 x = 0; x < SILK_RASTER_TILE_SIZE; x++) {
+            i32 outside = 0;
 
-#elif defined(SILK_BYTEORDER_BIG_ENDIAN)
+            for(i32 i = 0; i < 3; i++) {
+                outside |= edge[i] + x * step_x[i] + y * step_y[i];
+            }
 
-    result.r = (pix >> 8 * 3) & 0xFF;
-    result.g = (pix >> 8 * 2) & 0xFF;
-    result.b = (pix >> 8 * 1) & 0xFF;
-    result.a = (pix >> 8 * 0) & 0xFF;
+            if(outside >= 0) {
+                mask |= (u64) 1 << (y * SILK_RASTER_TILE_SIZE + x);
+            }
+        }
+    }
 
-#endif
+    return mask;
+}
 
-    return result;
+static void silkFillScalar(pixel* dest, i32 count, pixel pix) {
+    for(i32 i = 0; i < count; i++) {
+        dest[i] = pix;
+    }
 }
 
-SILK_API pixel silkColorToPixel(color col) {
-    pixel result = 0;
+// Pixel formats:
+// Everything is drawn in RGBA8888 ('pixel'), and converted to the format of the canvas only when it's written.
+// BGRA8888 and XRGB8888 differ from it only by the order of the red and blue bytes, and every blend mode treats the two
+// the same way, so these canvases are blended by the very same kernels: only the color (or the image row) is swapped.
+// RGB565 and A8 rows are converted to RGBA8888 (the 'unpack' kernels), blended, and converted back ('pack'), a chunk at a time.
+// The 565 channels are truncated and widened back by repeating their top bits, so the unchanged pixels survive the round trip.
 
-#if defined(SILK_BYTEORDER_LITTLE_ENDIAN)
+static const i32 silk_pixel_format_sizes[SILK_PIXELFORMAT_COUNT] = { 4, 4, 4, 2, 1 };
 
-    result =
-        col.r       |
-        col.g << 8  |
-        col.b << 16 |
-        col.a << 24;
+static SILK_FORCE_INLINE pixel silkPixelSwapRedBlue(pixel pix) {
+    pixel red = (pix >> SILK_PIXEL_RED_SHIFT) & 0xff;
+    pixel blue = (pix >> SILK_PIXEL_BLUE_SHIFT) & 0xff;
 
-#elif defined(SILK_BYTEORDER_BIG_ENDIAN)
+    return (pix & ~((pixel) 0xff << SILK_PIXEL_RED_SHIFT | (pixel) 0xff << SILK_PIXEL_BLUE_SHIFT)) |
+        red << SILK_PIXEL_BLUE_SHIFT |
+        blue << SILK_PIXEL_RED_SHIFT;
+}
 
-    result =
-        col.r << 24 |
-        col.g << 16 |
-        col.b << 8  |
-        col.a;
+static SILK_FORCE_INLINE u16 silkPackRGB565(pixel pix) {
+    return (u16) (
+        (((pix >> SILK_PIXEL_RED_SHIFT) & 0xf8) << 8) |
+        (((pix >> SILK_PIXEL_GREEN_SHIFT) & 0xfc) << 3) |
+        (((pix >> SILK_PIXEL_BLUE_SHIFT) & 0xff) >> 3)
+    );
+}
 
-#endif
+static SILK_FORCE_INLINE pixel silkUnpackRGB565(u16 value) {
+    pixel red = (value >> 11) & 0x1f;
+    pixel green = (value >> 5) & 0x3f;
+    pixel blue = value & 0x1f;
 
-    return result;
+    return
+        ((red << 3) | (red >> 2)) << SILK_PIXEL_RED_SHIFT |
+        ((green << 2) | (green >> 4)) << SILK_PIXEL_GREEN_SHIFT |
+        ((blue << 3) | (blue >> 2)) << SILK_PIXEL_BLUE_SHIFT |
+        SILK_PIXEL_ALPHA_MASK;
 }
 
-SILK_API pixel silkAlphaBlend(pixel base_pixel, pixel return_pixel, color_channel value) {
-    color result = { 0 };
-    color base_color = silkPixelToColor(base_pixel);
-    color return_color = silkPixelToColor(return_pixel);
+static void silkConvertCopyScalar(void* dest, const void* src, i32 count) {
+    memcpy(dest, src, (size_t) count * sizeof(pixel));
+}
 
-    if(return_color.a == 0) {
-        return base_pixel;
-    } else if(return_pixel == base_pixel) {
-        return return_pixel;
+static void silkConvertSwapScalar(void* dest, const void* src, i32 count) {
+    // RGBA8888 <-> BGRA8888 (the same swap both ways), RGBA8888 -> XRGB8888
+    for(i32 i = 0; i < count; i++) {
+        ((pixel*) dest)[i] = silkPixelSwapRedBlue(((const pixel*) src)[i]);
     }
+}
 
-    result.r = base_color.r + (return_color.r - base_color.r) * (value / 255.0f);
-    result.g = base_color.g + (return_color.g - base_color.g) * (value / 255.0f);
-    result.b = base_color.b + (return_color.b - base_color.b) * (value / 255.0f);
-    result.a = value;
-
+static void silkUnpackXRGBScalar(void* dest, const void* src, i32 count) {
+    for(i32 i = 0; i < count; i++) {
+        ((pixel*) dest)[i] = silkPixelSwapRedBlue(((const pixel*) src)[i]) | SILK_PIXEL_ALPHA_MASK;
+    }
+}
 
-    return silkColorToPixel(result);
+static void silkPackRGB565Scalar(void* dest, const void* src, i32 count) {
+    for(i32 i = 0; i < count; i++) {
+        ((u16*) dest)[i] = silkPackRGB565(((const pixel*) src)[i]);
+    }
 }
 
-SILK_API pixel silkPixelFade(pixel pix, f32 factor) {
-    color result = { 0 };
+static void silkUnpackRGB565Scalar(void* dest, const void* src, i32 count) {
+    for(i32 i = 0; i < count; i++) {
+        ((pixel*) dest)[i] = silkUnpackRGB565(((const u16*) src)[i]);
+    }
+}
 
-    result.r = silkPixelToColor(pix).r;
-    result.g = silkPixelToColor(pix).g;
-    result.b = silkPixelToColor(pix).b;
-    result.a = factor * 255;
+static void silkPackA8Scalar(void* dest, const void* src, i32 count) {
+    for(i32 i = 0; i < count; i++) {
+        ((u8*) dest)[i] = (u8) (((const pixel*) src)[i] >> SILK_PIXEL_ALPHA_SHIFT);
+    }
+}
 
-    return silkColorToPixel(result);
+static void silkUnpackA8Scalar(void* dest, const void* src, i32 count) {
+    for(i32 i = 0; i < count; i++) {
+        ((pixel*) dest)[i] = (pixel) ((const u8*) src)[i] << SILK_PIXEL_ALPHA_SHIFT;
+    }
 }
 
-SILK_API pixel silkPixelTint(pixel pix, pixel tint) {
-    color result = { 0 };
+// Hashing (the stripe loop of XXH3):
+// Data is read in 64-byte stripes, as 8 64-bit lanes. Every lane is mixed with the key of it's position, and the product
+// of the key-mixed lane's 32-bit halves goes into it's accumulator, while the raw lane goes into the neighbouring one,
+// so no bit of the input is lost. Key window slides by one lane per stripe, and after 'SILK_HASH_BLOCK_STRIPES' stripes
+// the accumulators are scrambled, so the stripes can't be reordered without changing the hash.
+// The product is 32 x 32 -> 64 bits, so it's one 'pmuludq' ('vmull_u32') per two lanes in the SIMD versions.
+// NOTE: The hash is only meant to be compared with the hashes computed on the same machine (it reads the native byte order).
+// Source:
+// https://github.com/Cyan4973/xxHash/blob/dev/doc/xxhash_spec.md
+
+#define SILK_HASH_BLOCK_STRIPES 16
+
+#define SILK_HASH_PRIME32_1 0x9e3779b1ull
+#define SILK_HASH_PRIME64_1 0x9e3779b185ebca87ull
+#define SILK_HASH_PRIME64_4 0x85ebca77c2b2ae63ull
+
+// First 24 outputs of splitmix64 (seed 0): 16 sliding key windows, plus the scrambling key at the end
+static const u64 silk_hash_keys[24] = {
+    0xe220a8397b1dcdafull, 0x6e789e6aa1b965f4ull, 0x06c45d188009454full, 0xf88bb8a8724c81ecull,
+    0x1b39896a51a8749bull, 0x53cb9f0c747ea2eaull, 0x2c829abe1f4532e1ull, 0xc584133ac916ab3cull,
+    0x3ee5789041c98ac3ull, 0xf3b8488c368cb0a6ull, 0x657eecdd3cb13d09ull, 0xc2d326e0055bdef6ull,
+    0x8621a03fe0bbdb7bull, 0x8e1f7555983aa92full, 0xb54e0f1600cc4d19ull, 0x84bb3f97971d80abull,
+    0x7d29825c75521255ull, 0xc3cf17102b7f7f86ull, 0x3466e9a083914f64ull, 0xd81a8d2b5a4485acull,
+    0xdb01602b100b9ed7ull, 0xa9038a921825f10dull, 0xedf5f1d90dca2f6aull, 0x54496ad67bd2634cull
+};
 
-    result.r = ((i32)silkPixelToColor(pix).r * (i32)silkPixelToColor(tint).r) / 255;
-    result.g = ((i32)silkPixelToColor(pix).g * (i32)silkPixelToColor(tint).g) / 255;
-    result.b = ((i32)silkPixelToColor(pix).b * (i32)silkPixelToColor(tint).b) / 255;
-    result.a = ((i32)silkPixelToColor(pix).a * (i32)silkPixelToColor(tint).a) / 255;
+static void silkHashStripesScalar(u64* acc, const u8* data, i32 stripes, const u64* keys) {
+    for(i32 stripe = 0; stripe < stripes; stripe++) {
+        for(i32 i = 0; i < 8; i++) {
+            u64 value;
+            memcpy(&value, data + (size_t) stripe * 64 + (size_t) i * 8, sizeof(u64));
 
-    return silkColorToPixel(result);
+            u64 mixed = value ^ keys[stripe + i];
+
+            acc[i ^ 1] += value;
+            acc[i] += (mixed & 0xffffffff) * (mixed >> 32);
+        }
+    }
 }
 
-SILK_API color_channel silkPixelChannelRed(pixel pix) {
-    
-#if defined(SILK_BYTEORDER_LITTLE_ENDIAN)
+#if defined(SILK_SIMD_X86)
 
-    return (0x000000ff & pix) >> (8 * 0);
+SILK_TARGET("sse2") static void silkFillSSE2(pixel* dest, i32 count, pixel pix) {
+    i32 i = 0;
 
-#elif defined(SILK_BYTEORDER_BIG_ENDIAN)
+    // Head: scalar stores until the destination is 16-byte aligned
+    for(; i < count && ((uintptr_t) (dest + i) & 15) != 0; i++) {
+        dest[i] = pix;
+    }
 
-    return (0x000000ff & pix) >> (8 * 3);
+    __m128i value = _mm_set1_epi32((int) pix);
 
-#endif
+    for(; i + 16 <= count; i += 16) {
+        _mm_store_si128((__m128i*) (dest + i + 0), value);
+        _mm_store_si128((__m128i*) (dest + i + 4), value);
+        _mm_store_si128((__m128i*) (dest + i + 8), value);
+        _mm_store_si128((__m128i*) (dest + i + 12), value);
+    }
 
-}
+    for(; i + 4 <= count; i += 4) {
+        _mm_store_si128((__m128i*) (dest + i), value);
+    }
 
-SILK_API color_channel silkPixelChannelGreen(pixel pix) {
+    for(; i < count; i++) {
+        dest[i] = pix;
+    }
+}
 
-#if defined(SILK_BYTEORDER_LITTLE_ENDIAN)
+SILK_TARGET("sse2") static void silkFillStreamSSE2(pixel* dest, i32 count, pixel pix) {
+    i32 i = 0;
 
-    return (0x0000ff00 & pix) >> (8 * 0);
+    for(; i < count && ((uintptr_t) (dest + i) & 15) != 0; i++) {
+        dest[i] = pix;
+    }
 
-#elif defined(SILK_BYTEORDER_BIG_ENDIAN)
+    __m128i value = _mm_set1_epi32((int) pix);
 
-    return (0x0000ff00 & pix) >> (8 * 3);
+    for(; i + 4 <= count; i += 4) {
+        _mm_stream_si128((__m128i*) (dest + i), value);
+    }
 
-#endif
+    for(; i < count; i++) {
+        dest[i] = pix;
+    }
 
+    _mm_sfence();
 }
 
-SILK_API color_channel silkPixelChannelBlue(pixel pix) {
+// NOTE: Pixels are always stored as R, G, B, A bytes in memory (see: 'silkColorToPixel'), so after widening to 16-bit lanes
+// the alpha of every pixel sits in the 4th lane of it's group, regardless of the byte order.
 
-#if defined(SILK_BYTEORDER_LITTLE_ENDIAN)
+SILK_TARGET("sse2") static void silkBlendSSE2(pixel* dest, i32 count, pixel pix) {
+    u32 alpha = (pix & SILK_PIXEL_ALPHA_MASK) >> SILK_PIXEL_ALPHA_SHIFT;
 
-    return (0x00ff0000 & pix) >> (8 * 0);
+    __m128i zero = _mm_setzero_si128();
+    __m128i div = _mm_set1_epi16(257);
+    __m128i inv_alpha = _mm_set1_epi16((short) (255 - alpha));
 
-#elif defined(SILK_BYTEORDER_BIG_ENDIAN)
+#if defined(SILK_PREMULTIPLIED_ALPHA)
 
-    return (0x00ff0000 & pix) >> (8 * 3);
+    // Premultiplied color is added after the division, and the 'packus' saturates it (see: 'silkBlendPixel')
+    __m128i src = _mm_unpacklo_epi8(_mm_set1_epi32((int) pix), zero);
+    __m128i src_term = _mm_set1_epi16(128);
 
-#endif
+#else
 
-}
+    // 'src * a + 128' is the same for the whole span, so it's computed only once
+    __m128i src = _mm_unpacklo_epi8(_mm_set1_epi32((int) (pix | SILK_PIXEL_ALPHA_MASK)), zero);
+    __m128i src_term = _mm_add_epi16(_mm_mullo_epi16(src, _mm_set1_epi16((short) alpha)), _mm_set1_epi16(128));
 
-SILK_API color_channel silkPixelChannelAlpha(pixel pix) {
+#endif // SILK_PREMULTIPLIED_ALPHA
 
-#if defined(SILK_BYTEORDER_LITTLE_ENDIAN)
+    i32 i = 0;
 
-    return (0xff000000 & pix) >> (8 * 0);
+    for(; i + 4 <= count; i += 4) {
+        __m128i dst = _mm_loadu_si128((__m128i*) (dest + i));
+        __m128i lo = _mm_unpacklo_epi8(dst, zero);
+        __m128i hi = _mm_unpackhi_epi8(dst, zero);
 
-#elif defined(SILK_BYTEORDER_BIG_ENDIAN)
+        lo = _mm_mulhi_epu16(_mm_add_epi16(_mm_mullo_epi16(lo, inv_alpha), src_term), div);
+        hi = _mm_mulhi_epu16(_mm_add_epi16(_mm_mullo_epi16(hi, inv_alpha), src_term), div);
 
-    return (0xff000000 & pix) >> (8 * 3);
+#if defined(SILK_PREMULTIPLIED_ALPHA)
+
+        lo = _mm_add_epi16(lo, src);
+        hi = _mm_add_epi16(hi, src);
+
+#endif // SILK_PREMULTIPLIED_ALPHA
+
+        _mm_storeu_si128((__m128i*) (dest + i), _mm_packus_epi16(lo, hi));
+    }
+
+    for(; i < count; i++) {
+        dest[i] = silkBlendPixel(dest[i], pix, alpha);
+    }
+}
+
+SILK_TARGET("sse2") static __m128i silkBlendLanesSSE2(__m128i dst, __m128i src, __m128i alpha_mask) {
+    __m128i zero = _mm_setzero_si128();
+    __m128i div = _mm_set1_epi16(257);
+    __m128i max = _mm_set1_epi16(255);
+    __m128i round = _mm_set1_epi16(128);
+
+    __m128i src_lo = _mm_unpacklo_epi8(src, zero);
+    __m128i src_hi = _mm_unpackhi_epi8(src, zero);
+
+    // Broadcasting the alpha of every pixel to all of it's four lanes
+    __m128i alpha_lo = _mm_shufflehi_epi16(_mm_shufflelo_epi16(src_lo, 0xff), 0xff);
+    __m128i alpha_hi = _mm_shufflehi_epi16(_mm_shufflelo_epi16(src_hi, 0xff), 0xff);
+
+#if defined(SILK_PREMULTIPLIED_ALPHA)
+
+    SILK_UNUSED(alpha_mask)
+
+    // One multiply-add per channel: the source is already multiplied by its alpha
+    __m128i lo = _mm_mulhi_epu16(_mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(dst, zero), _mm_sub_epi16(max, alpha_lo)), round), div);
+    __m128i hi = _mm_mulhi_epu16(_mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(dst, zero), _mm_sub_epi16(max, alpha_hi)), round), div);
+
+    return _mm_packus_epi16(_mm_add_epi16(lo, src_lo), _mm_add_epi16(hi, src_hi));
+
+#else
+
+    src = _mm_or_si128(src, alpha_mask);
+    src_lo = _mm_unpacklo_epi8(src, zero);
+    src_hi = _mm_unpackhi_epi8(src, zero);
+
+    __m128i lo = _mm_add_epi16(_mm_mullo_epi16(src_lo, alpha_lo), _mm_mullo_epi16(_mm_unpacklo_epi8(dst, zero), _mm_sub_epi16(max, alpha_lo)));
+    __m128i hi = _mm_add_epi16(_mm_mullo_epi16(src_hi, alpha_hi), _mm_mullo_epi16(_mm_unpackhi_epi8(dst, zero), _mm_sub_epi16(max, alpha_hi)));
+
+    lo = _mm_mulhi_epu16(_mm_add_epi16(lo, round), div);
+    hi = _mm_mulhi_epu16(_mm_add_epi16(hi, round), div);
+
+    return _mm_packus_epi16(lo, hi);
+
+#endif // SILK_PREMULTIPLIED_ALPHA
+}
+
+SILK_TARGET("sse2") static void silkBlendImageSSE2(pixel* dest, const pixel* src, i32 count) {
+    __m128i alpha_mask = _mm_set1_epi32((int) SILK_PIXEL_ALPHA_MASK);
+    __m128i zero = _mm_setzero_si128();
+    i32 i = 0;
+
+    for(; i + 4 <= count; i += 4) {
+        __m128i s = _mm_loadu_si128((const __m128i*) (src + i));
+        __m128i alpha = _mm_and_si128(s, alpha_mask);
+
+        // Groups of the opaque pixels are copied, and the fully transparent ones skipped, without reading the canvas
+        if(_mm_movemask_epi8(_mm_cmpeq_epi32(alpha, alpha_mask)) == 0xffff) {
+            _mm_storeu_si128((__m128i*) (dest + i), s);
+
+            continue;
+        }
+
+        if(_mm_movemask_epi8(_mm_cmpeq_epi32(alpha, zero)) == 0xffff) {
+            continue;
+        }
+
+        __m128i dst = _mm_loadu_si128((__m128i*) (dest + i));
+
+        _mm_storeu_si128((__m128i*) (dest + i), silkBlendLanesSSE2(dst, s, alpha_mask));
+    }
+
+    silkBlendImageScalar(dest + i, src + i, count - i);
+}
+
+// NOTE: Blend modes work on the 16-bit lanes, with the same exact division by 255 as in 'silkBlendPixel' ('(x * 257) >> 16').
+// 'canvas * (255 - a) + B * a + 128' never exceeds 65153, so the sums fit into the unsigned 16-bit lanes (and so do
+// the premultiplied sums, as long as no channel is bigger than it's alpha).
+
+SILK_TARGET("sse2") static SILK_FORCE_INLINE __m128i silkBlendModeLanesSSE2(__m128i dst, __m128i src, __m128i alpha, i32 mode) {
+    __m128i div = _mm_set1_epi16(257);
+    __m128i round = _mm_set1_epi16(128);
+
+#if defined(SILK_PREMULTIPLIED_ALPHA)
+
+    __m128i max = _mm_set1_epi16(255);
+    __m128i sign = _mm_set1_epi16((short) 0x8000);
+    __m128i dst_alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(dst, 0xff), 0xff);
+    __m128i x = _mm_mullo_epi16(dst, src);
+
+    // SSE2 has only the signed 16-bit 'min' / 'max', so the products are compared with their sign bits flipped
+    switch(mode) {
+        case SILK_BLEND_MODE_ADDITIVE: return _mm_min_epi16(_mm_add_epi16(dst, src), max);
+        case SILK_BLEND_MODE_SCREEN: return _mm_sub_epi16(_mm_add_epi16(dst, src), _mm_mulhi_epu16(_mm_add_epi16(x, round), div));
+        case SILK_BLEND_MODE_MULTIPLY: break;
+        case SILK_BLEND_MODE_MIN: x = _mm_xor_si128(_mm_min_epi16(_mm_xor_si128(_mm_mullo_epi16(src, dst_alpha), sign), _mm_xor_si128(_mm_mullo_epi16(dst, alpha), sign)), sign); break;
+        case SILK_BLEND_MODE_MAX: x = _mm_xor_si128(_mm_max_epi16(_mm_xor_si128(_mm_mullo_epi16(src, dst_alpha), sign), _mm_xor_si128(_mm_mullo_epi16(dst, alpha), sign)), sign); break;
+        default: return src;
+    }
+
+    x = _mm_add_epi16(x, _mm_add_epi16(_mm_mullo_epi16(src, _mm_sub_epi16(max, dst_alpha)), _mm_mullo_epi16(dst, _mm_sub_epi16(max, alpha))));
+
+    return _mm_mulhi_epu16(_mm_add_epi16(x, round), div);
+
+#else
+
+    __m128i product = _mm_mulhi_epu16(_mm_add_epi16(_mm_mullo_epi16(dst, src), round), div);
+    __m128i blended = src;
+
+    switch(mode) {
+        case SILK_BLEND_MODE_ADDITIVE: blended = _mm_min_epi16(_mm_add_epi16(dst, src), _mm_set1_epi16(255)); break;
+        case SILK_BLEND_MODE_MULTIPLY: blended = product; break;
+        case SILK_BLEND_MODE_SCREEN: blended = _mm_sub_epi16(_mm_add_epi16(dst, src), product); break;
+        case SILK_BLEND_MODE_MIN: blended = _mm_min_epi16(dst, src); break;
+        case SILK_BLEND_MODE_MAX: blended = _mm_max_epi16(dst, src); break;
+        default: break;
+    }
+
+    // Alpha lanes of 'blended' are set to 255, so the canvas alpha is the "source-over" one
+    blended = _mm_or_si128(blended, _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0));
+
+    __m128i x = _mm_add_epi16(_mm_mullo_epi16(blended, alpha), _mm_mullo_epi16(dst, _mm_sub_epi16(_mm_set1_epi16(255), alpha)));
+
+    return _mm_mulhi_epu16(_mm_add_epi16(x, round), div);
+
+#endif // SILK_PREMULTIPLIED_ALPHA
+}
+
+SILK_TARGET("sse2") static SILK_FORCE_INLINE void silkBlendModeSSE2(pixel* dest, i32 count, pixel pix, i32 mode) {
+    __m128i zero = _mm_setzero_si128();
+    __m128i src = _mm_unpacklo_epi8(_mm_set1_epi32((int) pix), zero);
+    __m128i alpha = _mm_set1_epi16((short) ((pix & SILK_PIXEL_ALPHA_MASK) >> SILK_PIXEL_ALPHA_SHIFT));
+
+    i32 i = 0;
+
+    for(; i + 4 <= count; i += 4) {
+        __m128i dst = _mm_loadu_si128((__m128i*) (dest + i));
+        __m128i lo = silkBlendModeLanesSSE2(_mm_unpacklo_epi8(dst, zero), src, alpha, mode);
+        __m128i hi = silkBlendModeLanesSSE2(_mm_unpackhi_epi8(dst, zero), src, alpha, mode);
+
+        _mm_storeu_si128((__m128i*) (dest + i), _mm_packus_epi16(lo, hi));
+    }
+
+    silkBlendModeScalar(dest + i, count - i, pix, mode);
+}
+
+SILK_TARGET("sse2") static SILK_FORCE_INLINE void silkBlendImageModeSSE2(pixel* dest, const pixel* src, i32 count, i32 mode) {
+    __m128i zero = _mm_setzero_si128();
+    __m128i alpha_mask = _mm_set1_epi32((int) SILK_PIXEL_ALPHA_MASK);
+
+    i32 i = 0;
+
+    for(; i + 4 <= count; i += 4) {
+        __m128i s = _mm_loadu_si128((const __m128i*) (src + i));
+
+        // Fully transparent groups don't change the canvas
+        if(_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(s, alpha_mask), zero)) == 0xffff) {
+            continue;
+        }
+
+        __m128i dst = _mm_loadu_si128((__m128i*) (dest + i));
+        __m128i src_lo = _mm_unpacklo_epi8(s, zero);
+        __m128i src_hi = _mm_unpackhi_epi8(s, zero);
+
+        // Broadcasting the alpha of every pixel to all of it's four lanes
+        __m128i alpha_lo = _mm_shufflehi_epi16(_mm_shufflelo_epi16(src_lo, 0xff), 0xff);
+        __m128i alpha_hi = _mm_shufflehi_epi16(_mm_shufflelo_epi16(src_hi, 0xff), 0xff);
+
+        __m128i lo = silkBlendModeLanesSSE2(_mm_unpacklo_epi8(dst, zero), src_lo, alpha_lo, mode);
+        __m128i hi = silkBlendModeLanesSSE2(_mm_unpackhi_epi8(dst, zero), src_hi, alpha_hi, mode);
+
+        _mm_storeu_si128((__m128i*) (dest + i), _mm_packus_epi16(lo, hi));
+    }
+
+    silkBlendImageModeScalar(dest + i, src + i, count - i, mode);
+}
+
+SILK_TARGET("sse2") static void silkBlendAdditiveSSE2(pixel* dest, i32 count, pixel pix) { silkBlendModeSSE2(dest, count, pix, SILK_BLEND_MODE_ADDITIVE); }
+SILK_TARGET("sse2") static void silkBlendMultiplySSE2(pixel* dest, i32 count, pixel pix) { silkBlendModeSSE2(dest, count, pix, SILK_BLEND_MODE_MULTIPLY); }
+SILK_TARGET("sse2") static void silkBlendScreenSSE2(pixel* dest, i32 count, pixel pix) { silkBlendModeSSE2(dest, count, pix, SILK_BLEND_MODE_SCREEN); }
+SILK_TARGET("sse2") static void silkBlendMinSSE2(pixel* dest, i32 count, pixel pix) { silkBlendModeSSE2(dest, count, pix, SILK_BLEND_MODE_MIN); }
+SILK_TARGET("sse2") static void silkBlendMaxSSE2(pixel* dest, i32 count, pixel pix) { silkBlendModeSSE2(dest, count, pix, SILK_BLEND_MODE_MAX); }
+
+SILK_TARGET("sse2") static void silkBlendImageAdditiveSSE2(pixel* dest, const pixel* src, i32 count) { silkBlendImageModeSSE2(dest, src, count, SILK_BLEND_MODE_ADDITIVE); }
+SILK_TARGET("sse2") static void silkBlendImageMultiplySSE2(pixel* dest, const pixel* src, i32 count) { silkBlendImageModeSSE2(dest, src, count, SILK_BLEND_MODE_MULTIPLY); }
+SILK_TARGET("sse2") static void silkBlendImageScreenSSE2(pixel* dest, const pixel* src, i32 count) { silkBlendImageModeSSE2(dest, src, count, SILK_BLEND_MODE_SCREEN); }
+SILK_TARGET("sse2") static void silkBlendImageMinSSE2(pixel* dest, const pixel* src, i32 count) { silkBlendImageModeSSE2(dest, src, count, SILK_BLEND_MODE_MIN); }
+SILK_TARGET("sse2") static void silkBlendImageMaxSSE2(pixel* dest, const pixel* src, i32 count) { silkBlendImageModeSSE2(dest, src, count, SILK_BLEND_MODE_MAX); }
+
+SILK_TARGET("sse2") static u64 silkTileCoverageSSE2(const i32 edge[3], const i32 step_x[3], const i32 step_y[3]) {
+    __m128i left[3];    // pixels 0 - 3 of the current row
+    __m128i right[3];   // pixels 4 - 7 of the current row
+    __m128i down[3];
+
+    for(i32 i = 0; i < 3; i++) {
+        // SSE2 has no 32-bit 'mullo', so the starting values are simply set up lane by lane
+        left[i] = _mm_setr_epi32(edge[i], edge[i] + step_x[i], edge[i] + step_x[i] * 2, edge[i] + step_x[i] * 3);
+        right[i] = _mm_add_epi32(left[i], _mm_set1_epi32(step_x[i] * 4));
+        down[i] = _mm_set1_epi32(step_y[i]);
+    }
+
+    u64 mask = 0;
+
+    for(i32 y = 0; y < SILK_RASTER_TILE_SIZE; y++) {
+        // Sign bit of the OR is set, if any of the three values is negative
+        __m128i outside_left = _mm_or_si128(_mm_or_si128(left[0], left[1]), left[2]);
+        __m128i outside_right = _mm_or_si128(_mm_or_si128(right[0], right[1]), right[2]);
+
+        u32 row = (u32) _mm_movemask_ps(_mm_castsi128_ps(outside_left)) | (u32) _mm_movemask_ps(_mm_castsi128_ps(outside_right)) << 4;
+        mask |= (u64) (~row & 0xff) << (y * SILK_RASTER_TILE_SIZE);
+
+        for(i32 i = 0; i < 3; i++) {
+            left[i] = _mm_add_epi32(left[i], down[i]);
+            right[i] = _mm_add_epi32(right[i], down[i]);
+        }
+    }
+
+    return mask;
+}
+
+// Red and blue bytes are 16 bits apart (in either byte order), so rotating the pixel by 16 bits swaps them
+SILK_TARGET("sse2") static SILK_FORCE_INLINE __m128i silkSwapRedBlueSSE2(__m128i p, __m128i rb_mask) {
+    __m128i rb = _mm_and_si128(p, rb_mask);
+
+    return _mm_or_si128(_mm_andnot_si128(rb_mask, p), _mm_or_si128(_mm_slli_epi32(rb, 16), _mm_srli_epi32(rb, 16)));
+}
+
+SILK_TARGET("sse2") static void silkConvertSwapSSE2(void* dest, const void* src, i32 count) {
+    __m128i rb_mask = _mm_set1_epi32((int) ((pixel) 0xff << SILK_PIXEL_RED_SHIFT | (pixel) 0xff << SILK_PIXEL_BLUE_SHIFT));
+    i32 i = 0;
+
+    for(; i + 4 <= count; i += 4) {
+        __m128i p = _mm_loadu_si128((const __m128i*) ((const pixel*) src + i));
+        _mm_storeu_si128((__m128i*) ((pixel*) dest + i), silkSwapRedBlueSSE2(p, rb_mask));
+    }
+
+    silkConvertSwapScalar((pixel*) dest + i, (const pixel*) src + i, count - i);
+}
+
+SILK_TARGET("sse2") static void silkUnpackXRGBSSE2(void* dest, const void* src, i32 count) {
+    __m128i rb_mask = _mm_set1_epi32((int) ((pixel) 0xff << SILK_PIXEL_RED_SHIFT | (pixel) 0xff << SILK_PIXEL_BLUE_SHIFT));
+    __m128i alpha_mask = _mm_set1_epi32((int) SILK_PIXEL_ALPHA_MASK);
+    i32 i = 0;
+
+    for(; i + 4 <= count; i += 4) {
+        __m128i p = _mm_loadu_si128((const __m128i*) ((const pixel*) src + i));
+        _mm_storeu_si128((__m128i*) ((pixel*) dest + i), _mm_or_si128(silkSwapRedBlueSSE2(p, rb_mask), alpha_mask));
+    }
+
+    silkUnpackXRGBScalar((pixel*) dest + i, (const pixel*) src + i, count - i);
+}
+
+SILK_TARGET("sse2") static SILK_FORCE_INLINE __m128i silkPackRGB565LanesSSE2(__m128i p) {
+    __m128i red = _mm_slli_epi32(_mm_and_si128(_mm_srli_epi32(p, SILK_PIXEL_RED_SHIFT), _mm_set1_epi32(0xf8)), 8);
+    __m128i green = _mm_slli_epi32(_mm_and_si128(_mm_srli_epi32(p, SILK_PIXEL_GREEN_SHIFT), _mm_set1_epi32(0xfc)), 3);
+    __m128i blue = _mm_srli_epi32(_mm_and_si128(_mm_srli_epi32(p, SILK_PIXEL_BLUE_SHIFT), _mm_set1_epi32(0xf8)), 3);
+
+    // SSE2 only packs with the signed saturation, so the 16-bit values are sign-extended first
+    return _mm_srai_epi32(_mm_slli_epi32(_mm_or_si128(_mm_or_si128(red, green), blue), 16), 16);
+}
+
+SILK_TARGET("sse2") static void silkPackRGB565SSE2(void* dest, const void* src, i32 count) {
+    i32 i = 0;
+
+    for(; i + 8 <= count; i += 8) {
+        __m128i lo = silkPackRGB565LanesSSE2(_mm_loadu_si128((const __m128i*) ((const pixel*) src + i)));
+        __m128i hi = silkPackRGB565LanesSSE2(_mm_loadu_si128((const __m128i*) ((const pixel*) src + i + 4)));
+
+        _mm_storeu_si128((__m128i*) ((u16*) dest + i), _mm_packs_epi32(lo, hi));
+    }
+
+    silkPackRGB565Scalar((u16*) dest + i, (const pixel*) src + i, count - i);
+}
+
+SILK_TARGET("sse2") static SILK_FORCE_INLINE __m128i silkUnpackRGB565LanesSSE2(__m128i v) {
+    __m128i red = _mm_srli_epi32(v, 11);
+    __m128i green = _mm_and_si128(_mm_srli_epi32(v, 5), _mm_set1_epi32(0x3f));
+    __m128i blue = _mm_and_si128(v, _mm_set1_epi32(0x1f));
+
+    red = _mm_or_si128(_mm_slli_epi32(red, 3), _mm_srli_epi32(red, 2));
+    green = _mm_or_si128(_mm_slli_epi32(green, 2), _mm_srli_epi32(green, 4));
+    blue = _mm_or_si128(_mm_slli_epi32(blue, 3), _mm_srli_epi32(blue, 2));
+
+    return _mm_or_si128(
+        _mm_or_si128(_mm_slli_epi32(red, SILK_PIXEL_RED_SHIFT), _mm_slli_epi32(green, SILK_PIXEL_GREEN_SHIFT)),
+        _mm_or_si128(_mm_slli_epi32(blue, SILK_PIXEL_BLUE_SHIFT), _mm_set1_epi32((int) SILK_PIXEL_ALPHA_MASK))
+    );
+}
+
+SILK_TARGET("sse2") static void silkUnpackRGB565SSE2(void* dest, const void* src, i32 count) {
+    __m128i zero = _mm_setzero_si128();
+    i32 i = 0;
+
+    for(; i + 8 <= count; i += 8) {
+        __m128i v = _mm_loadu_si128((const __m128i*) ((const u16*) src + i));
+
+        _mm_storeu_si128((__m128i*) ((pixel*) dest + i), silkUnpackRGB565LanesSSE2(_mm_unpacklo_epi16(v, zero)));
+        _mm_storeu_si128((__m128i*) ((pixel*) dest + i + 4), silkUnpackRGB565LanesSSE2(_mm_unpackhi_epi16(v, zero)));
+    }
+
+    silkUnpackRGB565Scalar((pixel*) dest + i, (const u16*) src + i, count - i);
+}
+
+SILK_TARGET("sse2") static void silkHashStripesSSE2(u64* acc, const u8* data, i32 stripes, const u64* keys) {
+    __m128i lanes[4];
+
+    for(i32 i = 0; i < 4; i++) {
+        lanes[i] = _mm_loadu_si128((const __m128i*) (acc + i * 2));
+    }
+
+    for(i32 stripe = 0; stripe < stripes; stripe++) {
+        for(i32 i = 0; i < 4; i++) {
+            __m128i value = _mm_loadu_si128((const __m128i*) (data + (size_t) stripe * 64 + (size_t) i * 16));
+            __m128i mixed = _mm_xor_si128(value, _mm_loadu_si128((const __m128i*) (keys + stripe + i * 2)));
+
+            // High half of every key-mixed lane times it's low half; raw lanes swapped into the neighbouring accumulators
+            __m128i product = _mm_mul_epu32(mixed, _mm_shuffle_epi32(mixed, _MM_SHUFFLE(0, 3, 0, 1)));
+            __m128i swapped = _mm_shuffle_epi32(value, _MM_SHUFFLE(1, 0, 3, 2));
+
+            lanes[i] = _mm_add_epi64(lanes[i], _mm_add_epi64(product, swapped));
+        }
+    }
+
+    for(i32 i = 0; i < 4; i++) {
+        _mm_storeu_si128((__m128i*) (acc + i * 2), lanes[i]);
+    }
+}
+
+// SSSE3 swaps the red and blue bytes with one shuffle ('pshufb')
+SILK_TARGET("ssse3") static void silkConvertSwapSSSE3(void* dest, const void* src, i32 count) {
+    __m128i shuffle = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    i32 i = 0;
+
+    for(; i + 8 <= count; i += 8) {
+        __m128i a = _mm_loadu_si128((const __m128i*) ((const pixel*) src + i));
+        __m128i b = _mm_loadu_si128((const __m128i*) ((const pixel*) src + i + 4));
+
+        _mm_storeu_si128((__m128i*) ((pixel*) dest + i), _mm_shuffle_epi8(a, shuffle));
+        _mm_storeu_si128((__m128i*) ((pixel*) dest + i + 4), _mm_shuffle_epi8(b, shuffle));
+    }
+
+    silkConvertSwapScalar((pixel*) dest + i, (const pixel*) src + i, count - i);
+}
+
+SILK_TARGET("ssse3") static void silkUnpackXRGBSSSE3(void* dest, const void* src, i32 count) {
+    __m128i shuffle = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    __m128i alpha_mask = _mm_set1_epi32((int) SILK_PIXEL_ALPHA_MASK);
+    i32 i = 0;
+
+    for(; i + 4 <= count; i += 4) {
+        __m128i p = _mm_loadu_si128((const __m128i*) ((const pixel*) src + i));
+        _mm_storeu_si128((__m128i*) ((pixel*) dest + i), _mm_or_si128(_mm_shuffle_epi8(p, shuffle), alpha_mask));
+    }
+
+    silkUnpackXRGBScalar((pixel*) dest + i, (const pixel*) src + i, count - i);
+}
+
+#if !defined(SILK_SIMD_DISABLE_AVX2)
+
+SILK_TARGET("avx2") static void silkFillAVX2(pixel* dest, i32 count, pixel pix) {
+    i32 i = 0;
+
+    for(; i < count && ((uintptr_t) (dest + i) & 31) != 0; i++) {
+        dest[i] = pix;
+    }
+
+    __m256i value = _mm256_set1_epi32((int) pix);
+
+    for(; i + 32 <= count; i += 32) {
+        _mm256_store_si256((__m256i*) (dest + i + 0), value);
+        _mm256_store_si256((__m256i*) (dest + i + 8), value);
+        _mm256_store_si256((__m256i*) (dest + i + 16), value);
+        _mm256_store_si256((__m256i*) (dest + i + 24), value);
+    }
+
+    for(; i + 8 <= count; i += 8) {
+        _mm256_store_si256((__m256i*) (dest + i), value);
+    }
+
+    for(; i < count; i++) {
+        dest[i] = pix;
+    }
+}
+
+SILK_TARGET("avx2") static void silkFillStreamAVX2(pixel* dest, i32 count, pixel pix) {
+    i32 i = 0;
+
+    for(; i < count && ((uintptr_t) (dest + i) & 31) != 0; i++) {
+        dest[i] = pix;
+    }
+
+    __m256i value = _mm256_set1_epi32((int) pix);
+
+    for(; i + 8 <= count; i += 8) {
+        _mm256_stream_si256((__m256i*) (dest + i), value);
+    }
+
+    for(; i < count; i++) {
+        dest[i] = pix;
+    }
+
+    _mm_sfence();
+}
+
+// NOTE: The AVX2 unpack / pack instructions work inside of the 128-bit halves, so they cancel each other out
+// and the pixels end up back in their original order.
+
+SILK_TARGET("avx2") static void silkBlendAVX2(pixel* dest, i32 count, pixel pix) {
+    u32 alpha = (pix & SILK_PIXEL_ALPHA_MASK) >> SILK_PIXEL_ALPHA_SHIFT;
+
+    __m256i zero = _mm256_setzero_si256();
+    __m256i div = _mm256_set1_epi16(257);
+    __m256i inv_alpha = _mm256_set1_epi16((short) (255 - alpha));
+
+#if defined(SILK_PREMULTIPLIED_ALPHA)
+
+    __m256i src = _mm256_unpacklo_epi8(_mm256_set1_epi32((int) pix), zero);
+    __m256i src_term = _mm256_set1_epi16(128);
+
+#else
+
+    __m256i src = _mm256_unpacklo_epi8(_mm256_set1_epi32((int) (pix | SILK_PIXEL_ALPHA_MASK)), zero);
+    __m256i src_term = _mm256_add_epi16(_mm256_mullo_epi16(src, _mm256_set1_epi16((short) alpha)), _mm256_set1_epi16(128));
+
+#endif // SILK_PREMULTIPLIED_ALPHA
+
+    i32 i = 0;
+
+    for(; i + 8 <= count; i += 8) {
+        __m256i dst = _mm256_loadu_si256((__m256i*) (dest + i));
+        __m256i lo = _mm256_unpacklo_epi8(dst, zero);
+        __m256i hi = _mm256_unpackhi_epi8(dst, zero);
+
+        lo = _mm256_mulhi_epu16(_mm256_add_epi16(_mm256_mullo_epi16(lo, inv_alpha), src_term), div);
+        hi = _mm256_mulhi_epu16(_mm256_add_epi16(_mm256_mullo_epi16(hi, inv_alpha), src_term), div);
+
+#if defined(SILK_PREMULTIPLIED_ALPHA)
+
+        lo = _mm256_add_epi16(lo, src);
+        hi = _mm256_add_epi16(hi, src);
+
+#endif // SILK_PREMULTIPLIED_ALPHA
+
+        _mm256_storeu_si256((__m256i*) (dest + i), _mm256_packus_epi16(lo, hi));
+    }
+
+    for(; i < count; i++) {
+        dest[i] = silkBlendPixel(dest[i], pix, alpha);
+    }
+}
+
+SILK_TARGET("avx2") static void silkBlendImageAVX2(pixel* dest, const pixel* src, i32 count) {
+    __m256i zero = _mm256_setzero_si256();
+    __m256i div = _mm256_set1_epi16(257);
+    __m256i max = _mm256_set1_epi16(255);
+    __m256i round = _mm256_set1_epi16(128);
+    __m256i alpha_mask = _mm256_set1_epi32((int) SILK_PIXEL_ALPHA_MASK);
+
+    i32 i = 0;
+
+    for(; i + 8 <= count; i += 8) {
+        __m256i s = _mm256_loadu_si256((const __m256i*) (src + i));
+        __m256i alpha = _mm256_and_si256(s, alpha_mask);
+
+        // Groups of the opaque pixels are copied, and the fully transparent ones skipped, without reading the canvas
+        if(_mm256_movemask_epi8(_mm256_cmpeq_epi32(alpha, alpha_mask)) == -1) {
+            _mm256_storeu_si256((__m256i*) (dest + i), s);
+
+            continue;
+        }
+
+        if(_mm256_testz_si256(s, alpha_mask)) {
+            continue;
+        }
+
+        __m256i dst = _mm256_loadu_si256((__m256i*) (dest + i));
+
+        __m256i src_lo = _mm256_unpacklo_epi8(s, zero);
+        __m256i src_hi = _mm256_unpackhi_epi8(s, zero);
+
+        __m256i alpha_lo = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(src_lo, 0xff), 0xff);
+        __m256i alpha_hi = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(src_hi, 0xff), 0xff);
+
+#if defined(SILK_PREMULTIPLIED_ALPHA)
+
+        __m256i lo = _mm256_mulhi_epu16(_mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpacklo_epi8(dst, zero), _mm256_sub_epi16(max, alpha_lo)), round), div);
+        __m256i hi = _mm256_mulhi_epu16(_mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpackhi_epi8(dst, zero), _mm256_sub_epi16(max, alpha_hi)), round), div);
+
+        lo = _mm256_add_epi16(lo, src_lo);
+        hi = _mm256_add_epi16(hi, src_hi);
+
+#else
+
+        s = _mm256_or_si256(s, alpha_mask);
+        src_lo = _mm256_unpacklo_epi8(s, zero);
+        src_hi = _mm256_unpackhi_epi8(s, zero);
+
+        __m256i lo = _mm256_add_epi16(_mm256_mullo_epi16(src_lo, alpha_lo), _mm256_mullo_epi16(_mm256_unpacklo_epi8(dst, zero), _mm256_sub_epi16(max, alpha_lo)));
+        __m256i hi = _mm256_add_epi16(_mm256_mullo_epi16(src_hi, alpha_hi), _mm256_mullo_epi16(_mm256_unpackhi_epi8(dst, zero), _mm256_sub_epi16(max, alpha_hi)));
+
+        lo = _mm256_mulhi_epu16(_mm256_add_epi16(lo, round), div);
+        hi = _mm256_mulhi_epu16(_mm256_add_epi16(hi, round), div);
+
+#endif // SILK_PREMULTIPLIED_ALPHA
+
+        _mm256_storeu_si256((__m256i*) (dest + i), _mm256_packus_epi16(lo, hi));
+    }
+
+    silkBlendImageScalar(dest + i, src + i, count - i);
+}
+
+
+SILK_TARGET("avx2") static SILK_FORCE_INLINE __m256i silkBlendModeLanesAVX2(__m256i dst, __m256i src, __m256i alpha, i32 mode) {
+    __m256i div = _mm256_set1_epi16(257);
+    __m256i round = _mm256_set1_epi16(128);
+
+#if defined(SILK_PREMULTIPLIED_ALPHA)
+
+    __m256i max = _mm256_set1_epi16(255);
+    __m256i dst_alpha = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(dst, 0xff), 0xff);
+    __m256i x = _mm256_mullo_epi16(dst, src);
+
+    switch(mode) {
+        case SILK_BLEND_MODE_ADDITIVE: return _mm256_min_epi16(_mm256_add_epi16(dst, src), max);
+        case SILK_BLEND_MODE_SCREEN: return _mm256_sub_epi16(_mm256_add_epi16(dst, src), _mm256_mulhi_epu16(_mm256_add_epi16(x, round), div));
+        case SILK_BLEND_MODE_MULTIPLY: break;
+        case SILK_BLEND_MODE_MIN: x = _mm256_min_epu16(_mm256_mullo_epi16(src, dst_alpha), _mm256_mullo_epi16(dst, alpha)); break;
+        case SILK_BLEND_MODE_MAX: x = _mm256_max_epu16(_mm256_mullo_epi16(src, dst_alpha), _mm256_mullo_epi16(dst, alpha)); break;
+        default: return src;
+    }
+
+    x = _mm256_add_epi16(x, _mm256_add_epi16(_mm256_mullo_epi16(src, _mm256_sub_epi16(max, dst_alpha)), _mm256_mullo_epi16(dst, _mm256_sub_epi16(max, alpha))));
+
+    return _mm256_mulhi_epu16(_mm256_add_epi16(x, round), div);
+
+#else
+
+    __m256i product = _mm256_mulhi_epu16(_mm256_add_epi16(_mm256_mullo_epi16(dst, src), round), div);
+    __m256i blended = src;
+
+    switch(mode) {
+        case SILK_BLEND_MODE_ADDITIVE: blended = _mm256_min_epi16(_mm256_add_epi16(dst, src), _mm256_set1_epi16(255)); break;
+        case SILK_BLEND_MODE_MULTIPLY: blended = product; break;
+        case SILK_BLEND_MODE_SCREEN: blended = _mm256_sub_epi16(_mm256_add_epi16(dst, src), product); break;
+        case SILK_BLEND_MODE_MIN: blended = _mm256_min_epi16(dst, src); break;
+        case SILK_BLEND_MODE_MAX: blended = _mm256_max_epi16(dst, src); break;
+        default: break;
+    }
+
+    // Alpha lanes of 'blended' are set to 255, so the canvas alpha is the "source-over" one
+    blended = _mm256_or_si256(blended, _mm256_set_epi16(255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0));
+
+    __m256i x = _mm256_add_epi16(_mm256_mullo_epi16(blended, alpha), _mm256_mullo_epi16(dst, _mm256_sub_epi16(_mm256_set1_epi16(255), alpha)));
+
+    return _mm256_mulhi_epu16(_mm256_add_epi16(x, round), div);
+
+#endif // SILK_PREMULTIPLIED_ALPHA
+}
+
+SILK_TARGET("avx2") static SILK_FORCE_INLINE void silkBlendModeAVX2(pixel* dest, i32 count, pixel pix, i32 mode) {
+    __m256i zero = _mm256_setzero_si256();
+    __m256i src = _mm256_unpacklo_epi8(_mm256_set1_epi32((int) pix), zero);
+    __m256i alpha = _mm256_set1_epi16((short) ((pix & SILK_PIXEL_ALPHA_MASK) >> SILK_PIXEL_ALPHA_SHIFT));
+
+    i32 i = 0;
+
+    for(; i + 8 <= count; i += 8) {
+        __m256i dst = _mm256_loadu_si256((__m256i*) (dest + i));
+        __m256i lo = silkBlendModeLanesAVX2(_mm256_unpacklo_epi8(dst, zero), src, alpha, mode);
+        __m256i hi = silkBlendModeLanesAVX2(_mm256_unpackhi_epi8(dst, zero), src, alpha, mode);
+
+        _mm256_storeu_si256((__m256i*) (dest + i), _mm256_packus_epi16(lo, hi));
+    }
+
+    silkBlendModeScalar(dest + i, count - i, pix, mode);
+}
+
+SILK_TARGET("avx2") static SILK_FORCE_INLINE void silkBlendImageModeAVX2(pixel* dest, const pixel* src, i32 count, i32 mode) {
+    __m256i zero = _mm256_setzero_si256();
+    __m256i alpha_mask = _mm256_set1_epi32((int) SILK_PIXEL_ALPHA_MASK);
+
+    i32 i = 0;
+
+    for(; i + 8 <= count; i += 8) {
+        __m256i s = _mm256_loadu_si256((const __m256i*) (src + i));
+
+        // Fully transparent groups don't change the canvas
+        if(_mm256_movemask_epi8(_mm256_cmpeq_epi32(_mm256_and_si256(s, alpha_mask), zero)) == -1) {
+            continue;
+        }
+
+        __m256i dst = _mm256_loadu_si256((__m256i*) (dest + i));
+        __m256i src_lo = _mm256_unpacklo_epi8(s, zero);
+        __m256i src_hi = _mm256_unpackhi_epi8(s, zero);
+
+        // Broadcasting the alpha of every pixel to all of it's four lanes
+        __m256i alpha_lo = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(src_lo, 0xff), 0xff);
+        __m256i alpha_hi = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(src_hi, 0xff), 0xff);
+
+        __m256i lo = silkBlendModeLanesAVX2(_mm256_unpacklo_epi8(dst, zero), src_lo, alpha_lo, mode);
+        __m256i hi = silkBlendModeLanesAVX2(_mm256_unpackhi_epi8(dst, zero), src_hi, alpha_hi, mode);
+
+        _mm256_storeu_si256((__m256i*) (dest + i), _mm256_packus_epi16(lo, hi));
+    }
+
+    silkBlendImageModeScalar(dest + i, src + i, count - i, mode);
+}
+
+SILK_TARGET("avx2") static void silkBlendAdditiveAVX2(pixel* dest, i32 count, pixel pix) { silkBlendModeAVX2(dest, count, pix, SILK_BLEND_MODE_ADDITIVE); }
+SILK_TARGET("avx2") static void silkBlendMultiplyAVX2(pixel* dest, i32 count, pixel pix) { silkBlendModeAVX2(dest, count, pix, SILK_BLEND_MODE_MULTIPLY); }
+SILK_TARGET("avx2") static void silkBlendScreenAVX2(pixel* dest, i32 count, pixel pix) { silkBlendModeAVX2(dest, count, pix, SILK_BLEND_MODE_SCREEN); }
+SILK_TARGET("avx2") static void silkBlendMinAVX2(pixel* dest, i32 count, pixel pix) { silkBlendModeAVX2(dest, count, pix, SILK_BLEND_MODE_MIN); }
+SILK_TARGET("avx2") static void silkBlendMaxAVX2(pixel* dest, i32 count, pixel pix) { silkBlendModeAVX2(dest, count, pix, SILK_BLEND_MODE_MAX); }
+
+SILK_TARGET("avx2") static void silkBlendImageAdditiveAVX2(pixel* dest, const pixel* src, i32 count) { silkBlendImageModeAVX2(dest, src, count, SILK_BLEND_MODE_ADDITIVE); }
+SILK_TARGET("avx2") static void silkBlendImageMultiplyAVX2(pixel* dest, const pixel* src, i32 count) { silkBlendImageModeAVX2(dest, src, count, SILK_BLEND_MODE_MULTIPLY); }
+SILK_TARGET("avx2") static void silkBlendImageScreenAVX2(pixel* dest, const pixel* src, i32 count) { silkBlendImageModeAVX2(dest, src, count, SILK_BLEND_MODE_SCREEN); }
+SILK_TARGET("avx2") static void silkBlendImageMinAVX2(pixel* dest, const pixel* src, i32 count) { silkBlendImageModeAVX2(dest, src, count, SILK_BLEND_MODE_MIN); }
+SILK_TARGET("avx2") static void silkBlendImageMaxAVX2(pixel* dest, const pixel* src, i32 count) { silkBlendImageModeAVX2(dest, src, count, SILK_BLEND_MODE_MAX); }
+
+SILK_TARGET("avx2") static u64 silkTileCoverageAVX2(const i32 edge[3], const i32 step_x[3], const i32 step_y[3]) {
+    __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    __m256i row[3];
+    __m256i down[3];
+
+    for(i32 i = 0; i < 3; i++) {
+        row[i] = _mm256_add_epi32(_mm256_set1_epi32(edge[i]), _mm256_mullo_epi32(lanes, _mm256_set1_epi32(step_x[i])));
+        down[i] = _mm256_set1_epi32(step_y[i]);
+    }
+
+    u64 mask = 0;
+
+    // One whole row of the tile (8 pixels) per iteration
+    for(i32 y = 0; y < SILK_RASTER_TILE_SIZE; y++) {
+        __m256i outside = _mm256_or_si256(_mm256_or_si256(row[0], row[1]), row[2]);
+
+        mask |= (u64) (~(u32) _mm256_movemask_ps(_mm256_castsi256_ps(outside)) & 0xff) << (y * SILK_RASTER_TILE_SIZE);
+
+        for(i32 i = 0; i < 3; i++) {
+            row[i] = _mm256_add_epi32(row[i], down[i]);
+        }
+    }
+
+    return mask;
+}
+
+SILK_TARGET("avx2") static void silkConvertSwapAVX2(void* dest, const void* src, i32 count) {
+    __m256i shuffle = _mm256_setr_epi8(
+        2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15,
+        2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15
+    );
+    i32 i = 0;
+
+    for(; i + 16 <= count; i += 16) {
+        __m256i a = _mm256_loadu_si256((const __m256i*) ((const pixel*) src + i));
+        __m256i b = _mm256_loadu_si256((const __m256i*) ((const pixel*) src + i + 8));
+
+        _mm256_storeu_si256((__m256i*) ((pixel*) dest + i), _mm256_shuffle_epi8(a, shuffle));
+        _mm256_storeu_si256((__m256i*) ((pixel*) dest + i + 8), _mm256_shuffle_epi8(b, shuffle));
+    }
+
+    silkConvertSwapScalar((pixel*) dest + i, (const pixel*) src + i, count - i);
+}
+
+SILK_TARGET("avx2") static void silkUnpackXRGBAVX2(void* dest, const void* src, i32 count) {
+    __m256i shuffle = _mm256_setr_epi8(
+        2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15,
+        2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15
+    );
+    __m256i alpha_mask = _mm256_set1_epi32((int) SILK_PIXEL_ALPHA_MASK);
+    i32 i = 0;
+
+    for(; i + 8 <= count; i += 8) {
+        __m256i p = _mm256_loadu_si256((const __m256i*) ((const pixel*) src + i));
+        _mm256_storeu_si256((__m256i*) ((pixel*) dest + i), _mm256_or_si256(_mm256_shuffle_epi8(p, shuffle), alpha_mask));
+    }
+
+    silkUnpackXRGBScalar((pixel*) dest + i, (const pixel*) src + i, count - i);
+}
+
+SILK_TARGET("avx2") static SILK_FORCE_INLINE __m256i silkPackRGB565LanesAVX2(__m256i p) {
+    __m256i red = _mm256_slli_epi32(_mm256_and_si256(p, _mm256_set1_epi32(0xf8)), 8);
+    __m256i green = _mm256_srli_epi32(_mm256_and_si256(p, _mm256_set1_epi32(0xfc00)), 5);
+    __m256i blue = _mm256_srli_epi32(_mm256_and_si256(p, _mm256_set1_epi32(0xf80000)), 19);
+
+    return _mm256_or_si256(_mm256_or_si256(red, green), blue);
+}
+
+SILK_TARGET("avx2") static void silkPackRGB565AVX2(void* dest, const void* src, i32 count) {
+    i32 i = 0;
+
+    for(; i + 16 <= count; i += 16) {
+        __m256i lo = silkPackRGB565LanesAVX2(_mm256_loadu_si256((const __m256i*) ((const pixel*) src + i)));
+        __m256i hi = silkPackRGB565LanesAVX2(_mm256_loadu_si256((const __m256i*) ((const pixel*) src + i + 8)));
+
+        // 'packus' works within the 128-bit halves, so the 64-bit quarters are put back in order afterwards
+        __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(lo, hi), 0xd8);
+        _mm256_storeu_si256((__m256i*) ((u16*) dest + i), packed);
+    }
+
+    silkPackRGB565Scalar((u16*) dest + i, (const pixel*) src + i, count - i);
+}
+
+SILK_TARGET("avx2") static void silkUnpackRGB565AVX2(void* dest, const void* src, i32 count) {
+    i32 i = 0;
+
+    for(; i + 8 <= count; i += 8) {
+        __m256i v = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*) ((const u16*) src + i)));
+
+        __m256i red = _mm256_srli_epi32(v, 11);
+        __m256i green = _mm256_and_si256(_mm256_srli_epi32(v, 5), _mm256_set1_epi32(0x3f));
+        __m256i blue = _mm256_and_si256(v, _mm256_set1_epi32(0x1f));
+
+        red = _mm256_or_si256(_mm256_slli_epi32(red, 3), _mm256_srli_epi32(red, 2));
+        green = _mm256_or_si256(_mm256_slli_epi32(green, 2), _mm256_srli_epi32(green, 4));
+        blue = _mm256_or_si256(_mm256_slli_epi32(blue, 3), _mm256_srli_epi32(blue, 2));
+
+        __m256i result = _mm256_or_si256(
+            _mm256_or_si256(red, _mm256_slli_epi32(green, 8)),
+            _mm256_or_si256(_mm256_slli_epi32(blue, 16), _mm256_set1_epi32((int) SILK_PIXEL_ALPHA_MASK))
+        );
+
+        _mm256_storeu_si256((__m256i*) ((pixel*) dest + i), result);
+    }
+
+    silkUnpackRGB565Scalar((pixel*) dest + i, (const u16*) src + i, count - i);
+}
+
+SILK_TARGET("avx2") static void silkHashStripesAVX2(u64* acc, const u8* data, i32 stripes, const u64* keys) {
+    __m256i lanes[2] = {
+        _mm256_loadu_si256((const __m256i*) acc),
+        _mm256_loadu_si256((const __m256i*) (acc + 4))
+    };
+
+    for(i32 stripe = 0; stripe < stripes; stripe++) {
+        for(i32 i = 0; i < 2; i++) {
+            __m256i value = _mm256_loadu_si256((const __m256i*) (data + (size_t) stripe * 64 + (size_t) i * 32));
+            __m256i mixed = _mm256_xor_si256(value, _mm256_loadu_si256((const __m256i*) (keys + stripe + i * 4)));
+
+            // Same as SSE2: both shuffles stay inside of the 128-bit halves, where the neighbouring lanes are
+            __m256i product = _mm256_mul_epu32(mixed, _mm256_shuffle_epi32(mixed, _MM_SHUFFLE(0, 3, 0, 1)));
+            __m256i swapped = _mm256_shuffle_epi32(value, _MM_SHUFFLE(1, 0, 3, 2));
+
+            lanes[i] = _mm256_add_epi64(lanes[i], _mm256_add_epi64(product, swapped));
+        }
+    }
+
+    _mm256_storeu_si256((__m256i*) acc, lanes[0]);
+    _mm256_storeu_si256((__m256i*) (acc + 4), lanes[1]);
+}
+
+#endif // SILK_SIMD_DISABLE_AVX2
+
+#if !defined(SILK_SIMD_DISABLE_AVX512)
+
+SILK_TARGET("avx512f") static void silkFillAVX512(pixel* dest, i32 count, pixel pix) {
+    __m512i value = _mm512_set1_epi32((int) pix);
+    i32 i = 0;
+
+    // Head and tail are handled by the masked stores, so there's no scalar loop at all
+    i32 head = (i32) (((64 - ((uintptr_t) dest & 63)) & 63) / sizeof(pixel));
+
+    if(head > count) {
+        head = count;
+    }
+
+    if(head > 0) {
+        _mm512_mask_storeu_epi32(dest, (__mmask16) ((1u << head) - 1), value);
+        i = head;
+    }
+
+    for(; i + 64 <= count; i += 64) {
+        _mm512_store_si512((void*) (dest + i + 0), value);
+        _mm512_store_si512((void*) (dest + i + 16), value);
+        _mm512_store_si512((void*) (dest + i + 32), value);
+        _mm512_store_si512((void*) (dest + i + 48), value);
+    }
+
+    for(; i + 16 <= count; i += 16) {
+        _mm512_store_si512((void*) (dest + i), value);
+    }
+
+    if(i < count) {
+        _mm512_mask_storeu_epi32(dest + i, (__mmask16) ((1u << (count - i)) - 1), value);
+    }
+}
+
+SILK_TARGET("avx512f") static void silkFillStreamAVX512(pixel* dest, i32 count, pixel pix) {
+    __m512i value = _mm512_set1_epi32((int) pix);
+    i32 i = 0;
+
+    i32 head = (i32) (((64 - ((uintptr_t) dest & 63)) & 63) / sizeof(pixel));
+
+    if(head > count) {
+        head = count;
+    }
+
+    if(head > 0) {
+        _mm512_mask_storeu_epi32(dest, (__mmask16) ((1u << head) - 1), value);
+        i = head;
+    }
+
+    for(; i + 16 <= count; i += 16) {
+        _mm512_stream_si512((__m512i*) (dest + i), value);
+    }
+
+    if(i < count) {
+        _mm512_mask_storeu_epi32(dest + i, (__mmask16) ((1u << (count - i)) - 1), value);
+    }
+
+    _mm_sfence();
+}
+
+SILK_TARGET("avx512f,avx512bw") static void silkBlendAVX512(pixel* dest, i32 count, pixel pix) {
+    u32 alpha = (pix & SILK_PIXEL_ALPHA_MASK) >> SILK_PIXEL_ALPHA_SHIFT;
+
+    __m512i zero = _mm512_setzero_si512();
+    __m512i div = _mm512_set1_epi16(257);
+    __m512i inv_alpha = _mm512_set1_epi16((short) (255 - alpha));
+
+#if defined(SILK_PREMULTIPLIED_ALPHA)
+
+    __m512i src = _mm512_unpacklo_epi8(_mm512_set1_epi32((int) pix), zero);
+    __m512i src_term = _mm512_set1_epi16(128);
+
+#else
+
+    __m512i src = _mm512_unpacklo_epi8(_mm512_set1_epi32((int) (pix | SILK_PIXEL_ALPHA_MASK)), zero);
+    __m512i src_term = _mm512_add_epi16(_mm512_mullo_epi16(src, _mm512_set1_epi16((short) alpha)), _mm512_set1_epi16(128));
+
+#endif // SILK_PREMULTIPLIED_ALPHA
+
+    // The tail is blended with the masked loads / stores, so there's no scalar loop at all
+    for(i32 i = 0; i < count; i += 16) {
+        __mmask16 mask = count - i >= 16 ? (__mmask16) 0xffff : (__mmask16) ((1u << (count - i)) - 1);
+
+        __m512i dst = _mm512_maskz_loadu_epi32(mask, dest + i);
+        __m512i lo = _mm512_unpacklo_epi8(dst, zero);
+        __m512i hi = _mm512_unpackhi_epi8(dst, zero);
+
+        lo = _mm512_mulhi_epu16(_mm512_add_epi16(_mm512_mullo_epi16(lo, inv_alpha), src_term), div);
+        hi = _mm512_mulhi_epu16(_mm512_add_epi16(_mm512_mullo_epi16(hi, inv_alpha), src_term), div);
+
+#if defined(SILK_PREMULTIPLIED_ALPHA)
+
+        lo = _mm512_add_epi16(lo, src);
+        hi = _mm512_add_epi16(hi, src);
+
+#endif // SILK_PREMULTIPLIED_ALPHA
+
+        _mm512_mask_storeu_epi32(dest + i, mask, _mm512_packus_epi16(lo, hi));
+    }
+}
+
+SILK_TARGET("avx512f,avx512bw") static void silkBlendImageAVX512(pixel* dest, const pixel* src, i32 count) {
+    __m512i zero = _mm512_setzero_si512();
+    __m512i div = _mm512_set1_epi16(257);
+    __m512i max = _mm512_set1_epi16(255);
+    __m512i round = _mm512_set1_epi16(128);
+    __m512i alpha_mask = _mm512_set1_epi32((int) SILK_PIXEL_ALPHA_MASK);
+
+    for(i32 i = 0; i < count; i += 16) {
+        __mmask16 mask = count - i >= 16 ? (__mmask16) 0xffff : (__mmask16) ((1u << (count - i)) - 1);
+
+        __m512i s = _mm512_maskz_loadu_epi32(mask, src + i);
+
+        // Groups of the opaque pixels are copied, and the fully transparent ones skipped, without reading the canvas
+        if(_mm512_mask_cmpeq_epi32_mask(mask, _mm512_and_si512(s, alpha_mask), alpha_mask) == mask) {
+            _mm512_mask_storeu_epi32(dest + i, mask, s);
+
+            continue;
+        }
+
+        if(_mm512_mask_test_epi32_mask(mask, s, alpha_mask) == 0) {
+            continue;
+        }
+
+        __m512i dst = _mm512_maskz_loadu_epi32(mask, dest + i);
+
+        __m512i src_lo = _mm512_unpacklo_epi8(s, zero);
+        __m512i src_hi = _mm512_unpackhi_epi8(s, zero);
+
+        __m512i alpha_lo = _mm512_shufflehi_epi16(_mm512_shufflelo_epi16(src_lo, 0xff), 0xff);
+        __m512i alpha_hi = _mm512_shufflehi_epi16(_mm512_shufflelo_epi16(src_hi, 0xff), 0xff);
+
+#if defined(SILK_PREMULTIPLIED_ALPHA)
+
+        __m512i lo = _mm512_mulhi_epu16(_mm512_add_epi16(_mm512_mullo_epi16(_mm512_unpacklo_epi8(dst, zero), _mm512_sub_epi16(max, alpha_lo)), round), div);
+        __m512i hi = _mm512_mulhi_epu16(_mm512_add_epi16(_mm512_mullo_epi16(_mm512_unpackhi_epi8(dst, zero), _mm512_sub_epi16(max, alpha_hi)), round), div);
+
+        lo = _mm512_add_epi16(lo, src_lo);
+        hi = _mm512_add_epi16(hi, src_hi);
+
+#else
+
+        s = _mm512_or_si512(s, alpha_mask);
+        src_lo = _mm512_unpacklo_epi8(s, zero);
+        src_hi = _mm512_unpackhi_epi8(s, zero);
+
+        __m512i lo = _mm512_add_epi16(_mm512_mullo_epi16(src_lo, alpha_lo), _mm512_mullo_epi16(_mm512_unpacklo_epi8(dst, zero), _mm512_sub_epi16(max, alpha_lo)));
+        __m512i hi = _mm512_add_epi16(_mm512_mullo_epi16(src_hi, alpha_hi), _mm512_mullo_epi16(_mm512_unpackhi_epi8(dst, zero), _mm512_sub_epi16(max, alpha_hi)));
+
+        lo = _mm512_mulhi_epu16(_mm512_add_epi16(lo, round), div);
+        hi = _mm512_mulhi_epu16(_mm512_add_epi16(hi, round), div);
+
+#endif // SILK_PREMULTIPLIED_ALPHA
+
+        _mm512_mask_storeu_epi32(dest + i, mask, _mm512_packus_epi16(lo, hi));
+    }
+}
+
+SILK_TARGET("avx512f,avx512bw") static u64 silkTileCoverageAVX512(const i32 edge[3], const i32 step_x[3], const i32 step_y[3]) {
+    // Two rows of the tile (16 pixels) per iteration: lanes 0 - 7 are the row 'y', lanes 8 - 15 the row 'y + 1'
+    __m512i lanes_x = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 0, 1, 2, 3, 4, 5, 6, 7);
+    __m512i lanes_y = _mm512_setr_epi32(0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1);
+    __m512i rows[3];
+    __m512i down[3];
+
+    for(i32 i = 0; i < 3; i++) {
+        rows[i] = _mm512_add_epi32(
+            _mm512_set1_epi32(edge[i]),
+            _mm512_add_epi32(
+                _mm512_mullo_epi32(lanes_x, _mm512_set1_epi32(step_x[i])),
+                _mm512_mullo_epi32(lanes_y, _mm512_set1_epi32(step_y[i]))
+            )
+        );
+        down[i] = _mm512_set1_epi32(step_y[i] * 2);
+    }
+
+    u64 mask = 0;
+
+    for(i32 y = 0; y < SILK_RASTER_TILE_SIZE; y += 2) {
+        __m512i outside = _mm512_or_si512(_mm512_or_si512(rows[0], rows[1]), rows[2]);
+
+        mask |= (u64) (u16) ~_mm512_cmplt_epi32_mask(outside, _mm512_setzero_si512()) << (y * SILK_RASTER_TILE_SIZE);
+
+        for(i32 i = 0; i < 3; i++) {
+            rows[i] = _mm512_add_epi32(rows[i], down[i]);
+        }
+    }
+
+    return mask;
+}
+
+#endif // SILK_SIMD_DISABLE_AVX512
+
+static void silkCpuid(u32 leaf, u32 subleaf, u32 registers[4]) {
+#if defined(_MSC_VER)
+
+    int result[4] = { 0 };
+    __cpuidex(result, (int) leaf, (int) subleaf);
+
+    for(i32 i = 0; i < 4; i++) {
+        registers[i] = (u32) result[i];
+    }
+
+#else
+
+    __cpuid_count(leaf, subleaf, registers[0], registers[1], registers[2], registers[3]);
+
+#endif // _MSC_VER
+}
+
+static u32 silkXgetbv(void) {
+#if defined(_MSC_VER)
+
+    return (u32) _xgetbv(0);
+
+#else
+
+    u32 eax = 0;
+    u32 edx = 0;
+
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+
+    return eax;
+
+#endif // _MSC_VER
+}
+
+#endif // SILK_SIMD_X86
+
+#if defined(SILK_SIMD_ARM)
+
+static void silkFillNEON(pixel* dest, i32 count, pixel pix) {
+    uint32x4_t value = vdupq_n_u32(pix);
+    i32 i = 0;
+
+    for(; i + 16 <= count; i += 16) {
+        vst1q_u32(dest + i + 0, value);
+        vst1q_u32(dest + i + 4, value);
+        vst1q_u32(dest + i + 8, value);
+        vst1q_u32(dest + i + 12, value);
+    }
+
+    for(; i + 4 <= count; i += 4) {
+        vst1q_u32(dest + i, value);
+    }
+
+    for(; i < count; i++) {
+        dest[i] = pix;
+    }
+}
+
+// NOTE: 'vrshrn_n_u16(vrsraq_n_u16(x, x, 8), 8)' is the same exact division by 255 as in 'silkBlendPixel'
+
+static void silkBlendNEON(pixel* dest, i32 count, pixel pix) {
+    u32 alpha = (pix & SILK_PIXEL_ALPHA_MASK) >> SILK_PIXEL_ALPHA_SHIFT;
+
+    uint8x8_t inv_alpha = vdup_n_u8((u8) (255 - alpha));
+
+#if defined(SILK_PREMULTIPLIED_ALPHA)
+
+    // Premultiplied color is added (saturated) after the division
+    uint8x16_t src = vreinterpretq_u8_u32(vdupq_n_u32(pix));
+    uint16x8_t src_term = vdupq_n_u16(0);
+
+#else
+
+    uint8x8_t src = vreinterpret_u8_u32(vdup_n_u32(pix | SILK_PIXEL_ALPHA_MASK));
+    uint16x8_t src_term = vmull_u8(src, vdup_n_u8((u8) alpha));
+
+#endif // SILK_PREMULTIPLIED_ALPHA
+
+    i32 i = 0;
+
+    for(; i + 4 <= count; i += 4) {
+        uint8x16_t dst = vld1q_u8((const u8*) (dest + i));
+
+        uint16x8_t lo = vmlal_u8(src_term, vget_low_u8(dst), inv_alpha);
+        uint16x8_t hi = vmlal_u8(src_term, vget_high_u8(dst), inv_alpha);
+
+        uint8x8_t result_lo = vrshrn_n_u16(vrsraq_n_u16(lo, lo, 8), 8);
+        uint8x8_t result_hi = vrshrn_n_u16(vrsraq_n_u16(hi, hi, 8), 8);
+
+#if defined(SILK_PREMULTIPLIED_ALPHA)
+
+        vst1q_u8((u8*) (dest + i), vqaddq_u8(vcombine_u8(result_lo, result_hi), src));
+
+#else
+
+        vst1q_u8((u8*) (dest + i), vcombine_u8(result_lo, result_hi));
+
+#endif // SILK_PREMULTIPLIED_ALPHA
+    }
+
+    for(; i < count; i++) {
+        dest[i] = silkBlendPixel(dest[i], pix, alpha);
+    }
+}
+
+static void silkBlendImageNEON(pixel* dest, const pixel* src, i32 count) {
+    i32 i = 0;
+
+    // 'vld4' splits 8 pixels into the separate R, G, B and A registers, so the per-pixel alpha needs no shuffling
+    for(; i + 8 <= count; i += 8) {
+        uint8x8x4_t s = vld4_u8((const u8*) (src + i));
+        u64 alphas = vget_lane_u64(vreinterpret_u64_u8(s.val[3]), 0);
+
+        // Groups of the opaque pixels are copied, and the fully transparent ones skipped, without reading the canvas
+        if(alphas == ~(u64) 0) {
+            memcpy(dest + i, src + i, 8 * sizeof(pixel));
+
+            continue;
+        }
+
+        if(alphas == 0) {
+            continue;
+        }
+
+        uint8x8x4_t d = vld4_u8((const u8*) (dest + i));
+
+        uint8x8_t alpha = s.val[3];
+        uint8x8_t inv_alpha = vmvn_u8(alpha);
+
+#if defined(SILK_PREMULTIPLIED_ALPHA)
+
+        // One multiply-add per channel: the source is already multiplied by its alpha
+        for(i32 c = 0; c < 4; c++) {
+            uint16x8_t x = vmull_u8(d.val[c], inv_alpha);
+            d.val[c] = vqadd_u8(vrshrn_n_u16(vrsraq_n_u16(x, x, 8), 8), s.val[c]);
+        }
+
+#else
+
+        s.val[3] = vdup_n_u8(255);
+
+        for(i32 c = 0; c < 4; c++) {
+            uint16x8_t x = vmlal_u8(vmull_u8(s.val[c], alpha), d.val[c], inv_alpha);
+            d.val[c] = vrshrn_n_u16(vrsraq_n_u16(x, x, 8), 8);
+        }
+
+#endif // SILK_PREMULTIPLIED_ALPHA
+
+        vst4_u8((u8*) (dest + i), d);
+    }
+
+    silkBlendImageScalar(dest + i, src + i, count - i);
+}
+
+static u64 silkTileCoverageNEON(const i32 edge[3], const i32 step_x[3], const i32 step_y[3]) {
+    const i32 lanes_array[4] = { 0, 1, 2, 3 };
+    const u32 weights_array[4] = { 1, 2, 4, 8 };
+
+    int32x4_t lanes = vld1q_s32(lanes_array);
+    uint32x4_t weights = vld1q_u32(weights_array);
+    int32x4_t left[3];
+    int32x4_t right[3];
+
+    for(i32 i = 0; i < 3; i++) {
+        left[i] = vmlaq_n_s32(vdupq_n_s32(edge[i]), lanes, step_x[i]);
+        right[i] = vaddq_s32(left[i], vdupq_n_s32(step_x[i] * 4));
+    }
+
+    u64 mask = 0;
+
+    for(i32 y = 0; y < SILK_RASTER_TILE_SIZE; y++) {
+        // Lanes with any negative value are the pixels outside of the triangle
+        uint32x4_t inside_left = vcgeq_s32(vorrq_s32(vorrq_s32(left[0], left[1]), left[2]), vdupq_n_s32(0));
+        uint32x4_t inside_right = vcgeq_s32(vorrq_s32(vorrq_s32(right[0], right[1]), right[2]), vdupq_n_s32(0));
+
+        uint32x4_t bits = vaddq_u32(vandq_u32(inside_left, weights), vshlq_n_u32(vandq_u32(inside_right, weights), 4));
+        uint32x2_t sum = vpadd_u32(vget_low_u32(bits), vget_high_u32(bits));
+        u32 row = vget_lane_u32(vpadd_u32(sum, sum), 0);
+
+        mask |= (u64) row << (y * SILK_RASTER_TILE_SIZE);
+
+        for(i32 i = 0; i < 3; i++) {
+            left[i] = vaddq_s32(left[i], vdupq_n_s32(step_y[i]));
+            right[i] = vaddq_s32(right[i], vdupq_n_s32(step_y[i]));
+        }
+    }
+
+    return mask;
+}
+
+// 'vld4' splits the pixels into the four channel registers, so the swizzles are just the registers stored back in another order
+static void silkConvertSwapNEON(void* dest, const void* src, i32 count) {
+    i32 i = 0;
+
+    for(; i + 16 <= count; i += 16) {
+        uint8x16x4_t p = vld4q_u8((const u8*) ((const pixel*) src + i));
+        uint8x16_t red = p.val[0];
+
+        p.val[0] = p.val[2];
+        p.val[2] = red;
+
+        vst4q_u8((u8*) ((pixel*) dest + i), p);
+    }
+
+    silkConvertSwapScalar((pixel*) dest + i, (const pixel*) src + i, count - i);
+}
+
+static void silkUnpackXRGBNEON(void* dest, const void* src, i32 count) {
+    i32 i = 0;
+
+    for(; i + 16 <= count; i += 16) {
+        uint8x16x4_t p = vld4q_u8((const u8*) ((const pixel*) src + i));
+        uint8x16_t red = p.val[0];
+
+        p.val[0] = p.val[2];
+        p.val[2] = red;
+        p.val[3] = vdupq_n_u8(255);
+
+        vst4q_u8((u8*) ((pixel*) dest + i), p);
+    }
+
+    silkUnpackXRGBScalar((pixel*) dest + i, (const pixel*) src + i, count - i);
+}
+
+static void silkPackRGB565NEON(void* dest, const void* src, i32 count) {
+    i32 i = 0;
+
+    for(; i + 8 <= count; i += 8) {
+        uint8x8x4_t p = vld4_u8((const u8*) ((const pixel*) src + i));
+
+        uint16x8_t red = vshll_n_u8(vand_u8(p.val[0], vdup_n_u8(0xf8)), 8);
+        uint16x8_t green = vshlq_n_u16(vmovl_u8(vand_u8(p.val[1], vdup_n_u8(0xfc))), 3);
+        uint16x8_t blue = vmovl_u8(vshr_n_u8(p.val[2], 3));
+
+        vst1q_u16((u16*) dest + i, vorrq_u16(vorrq_u16(red, green), blue));
+    }
+
+    silkPackRGB565Scalar((u16*) dest + i, (const pixel*) src + i, count - i);
+}
+
+static void silkUnpackRGB565NEON(void* dest, const void* src, i32 count) {
+    i32 i = 0;
+
+    for(; i + 8 <= count; i += 8) {
+        uint16x8_t v = vld1q_u16((const u16*) src + i);
+        uint8x8x4_t p;
+
+        // Top bits of every channel are moved to the top of a byte, and repeated in it's low bits
+        uint8x8_t red = vand_u8(vshrn_n_u16(v, 8), vdup_n_u8(0xf8));
+        uint8x8_t green = vand_u8(vshrn_n_u16(v, 3), vdup_n_u8(0xfc));
+        uint8x8_t blue = vshl_n_u8(vmovn_u16(v), 3);
+
+        p.val[0] = vorr_u8(red, vshr_n_u8(red, 5));
+        p.val[1] = vorr_u8(green, vshr_n_u8(green, 6));
+        p.val[2] = vorr_u8(blue, vshr_n_u8(blue, 5));
+        p.val[3] = vdup_n_u8(255);
+
+        vst4_u8((u8*) ((pixel*) dest + i), p);
+    }
+
+    silkUnpackRGB565Scalar((pixel*) dest + i, (const u16*) src + i, count - i);
+}
+
+static void silkHashStripesNEON(u64* acc, const u8* data, i32 stripes, const u64* keys) {
+    uint64x2_t lanes[4];
+
+    for(i32 i = 0; i < 4; i++) {
+        lanes[i] = vld1q_u64(acc + i * 2);
+    }
+
+    for(i32 stripe = 0; stripe < stripes; stripe++) {
+        for(i32 i = 0; i < 4; i++) {
+            uint64x2_t value = vreinterpretq_u64_u8(vld1q_u8(data + (size_t) stripe * 64 + (size_t) i * 16));
+            uint64x2_t mixed = veorq_u64(value, vld1q_u64(keys + stripe + i * 2));
+
+            uint64x2_t product = vmull_u32(vmovn_u64(mixed), vshrn_n_u64(mixed, 32));
+            uint64x2_t swapped = vextq_u64(value, value, 1);
+
+            lanes[i] = vaddq_u64(lanes[i], vaddq_u64(product, swapped));
+        }
+    }
+
+    for(i32 i = 0; i < 4; i++) {
+        vst1q_u64(acc + i * 2, lanes[i]);
+    }
+}
+
+#endif // SILK_SIMD_ARM
+
+static u32 silkDetectSimdFeatures(void) {
+    u32 features = 0;
+
+#if defined(SILK_SIMD_X86)
+
+    u32 registers[4] = { 0 }; // eax, ebx, ecx, edx
+
+    silkCpuid(0, 0, registers);
+    u32 max_leaf = registers[0];
+
+    silkCpuid(1, 0, registers);
+
+    if(registers[3] & (1 << 26)) {
+        features |= SILK_SIMD_SSE2;
+    }
+
+    if(registers[2] & (1 << 9)) {
+        features |= SILK_SIMD_SSSE3;
+    }
+
+    // AVX needs both the CPU support and the OS support (the OS must save the YMM/ZMM registers on context switch)
+    bool os_xsave = (registers[2] & (1 << 27)) != 0;
+    bool cpu_avx = (registers[2] & (1 << 28)) != 0;
+
+    if(os_xsave && cpu_avx && max_leaf >= 7) {
+        u32 xcr0 = silkXgetbv();
+
+        silkCpuid(7, 0, registers);
+
+        if((xcr0 & 0x06) == 0x06 && (registers[1] & (1 << 5))) {
+            features |= SILK_SIMD_AVX2;
+        }
+
+        // AVX-512 kernels need both the Foundation (F) and the Byte-Word (BW) extensions
+        if((xcr0 & 0xe6) == 0xe6 && (registers[1] & (1 << 16)) && (registers[1] & (1u << 30))) {
+            features |= SILK_SIMD_AVX512;
+        }
+    }
+
+#if defined(SILK_SIMD_DISABLE_AVX2)
+    features &= ~SILK_SIMD_AVX2;
+#endif // SILK_SIMD_DISABLE_AVX2
+
+#if defined(SILK_SIMD_DISABLE_AVX512)
+    features &= ~SILK_SIMD_AVX512;
+#endif // SILK_SIMD_DISABLE_AVX512
+
+#elif defined(SILK_SIMD_ARM)
+
+    features |= SILK_SIMD_NEON;
+
+#endif // SILK_SIMD_X86 / SILK_SIMD_ARM
+
+    return features;
+}
+
+static i32 silkInitKernels(u32 features) {
+    silk_kernel_table table = { 0 };
+
+    table.features = features & silkDetectSimdFeatures();
+
+    table.fill = silkFillScalar;
+    table.fill_stream = silkFillScalar;
+    table.blend[SILK_BLEND_MODE_ALPHA] = silkBlendScalar;
+    table.blend[SILK_BLEND_MODE_ADDITIVE] = silkBlendAdditiveScalar;
+    table.blend[SILK_BLEND_MODE_MULTIPLY] = silkBlendMultiplyScalar;
+    table.blend[SILK_BLEND_MODE_SCREEN] = silkBlendScreenScalar;
+    table.blend[SILK_BLEND_MODE_MIN] = silkBlendMinScalar;
+    table.blend[SILK_BLEND_MODE_MAX] = silkBlendMaxScalar;
+    table.blend_image[SILK_BLEND_MODE_ALPHA] = silkBlendImageScalar;
+    table.blend_image[SILK_BLEND_MODE_ADDITIVE] = silkBlendImageAdditiveScalar;
+    table.blend_image[SILK_BLEND_MODE_MULTIPLY] = silkBlendImageMultiplyScalar;
+    table.blend_image[SILK_BLEND_MODE_SCREEN] = silkBlendImageScreenScalar;
+    table.blend_image[SILK_BLEND_MODE_MIN] = silkBlendImageMinScalar;
+    table.blend_image[SILK_BLEND_MODE_MAX] = silkBlendImageMaxScalar;
+    table.blend_image[SILK_BLEND_MODE_REPLACE] = silkCopyScalar;
+    table.tile_coverage = silkTileCoverageScalar;
+    table.pack[SILK_PIXELFORMAT_RGBA8888] = silkConvertCopyScalar;
+    table.pack[SILK_PIXELFORMAT_BGRA8888] = silkConvertSwapScalar;
+    table.pack[SILK_PIXELFORMAT_XRGB8888] = silkConvertSwapScalar;
+    table.pack[SILK_PIXELFORMAT_RGB565] = silkPackRGB565Scalar;
+    table.pack[SILK_PIXELFORMAT_A8] = silkPackA8Scalar;
+    table.unpack[SILK_PIXELFORMAT_RGBA8888] = silkConvertCopyScalar;
+    table.unpack[SILK_PIXELFORMAT_BGRA8888] = silkConvertSwapScalar;
+    table.unpack[SILK_PIXELFORMAT_XRGB8888] = silkUnpackXRGBScalar;
+    table.unpack[SILK_PIXELFORMAT_RGB565] = silkUnpackRGB565Scalar;
+    table.unpack[SILK_PIXELFORMAT_A8] = silkUnpackA8Scalar;
+    table.hash = silkHashStripesScalar;
+
+#if defined(SILK_SIMD_X86)
+
+    if(table.features & SILK_SIMD_SSE2) {
+        table.fill = silkFillSSE2;
+        table.fill_stream = silkFillStreamSSE2;
+        table.blend[SILK_BLEND_MODE_ALPHA] = silkBlendSSE2;
+        table.blend[SILK_BLEND_MODE_ADDITIVE] = silkBlendAdditiveSSE2;
+        table.blend[SILK_BLEND_MODE_MULTIPLY] = silkBlendMultiplySSE2;
+        table.blend[SILK_BLEND_MODE_SCREEN] = silkBlendScreenSSE2;
+        table.blend[SILK_BLEND_MODE_MIN] = silkBlendMinSSE2;
+        table.blend[SILK_BLEND_MODE_MAX] = silkBlendMaxSSE2;
+        table.blend_image[SILK_BLEND_MODE_ALPHA] = silkBlendImageSSE2;
+        table.blend_image[SILK_BLEND_MODE_ADDITIVE] = silkBlendImageAdditiveSSE2;
+        table.blend_image[SILK_BLEND_MODE_MULTIPLY] = silkBlendImageMultiplySSE2;
+        table.blend_image[SILK_BLEND_MODE_SCREEN] = silkBlendImageScreenSSE2;
+        table.blend_image[SILK_BLEND_MODE_MIN] = silkBlendImageMinSSE2;
+        table.blend_image[SILK_BLEND_MODE_MAX] = silkBlendImageMaxSSE2;
+        table.tile_coverage = silkTileCoverageSSE2;
+        table.pack[SILK_PIXELFORMAT_BGRA8888] = silkConvertSwapSSE2;
+        table.pack[SILK_PIXELFORMAT_XRGB8888] = silkConvertSwapSSE2;
+        table.pack[SILK_PIXELFORMAT_RGB565] = silkPackRGB565SSE2;
+        table.unpack[SILK_PIXELFORMAT_BGRA8888] = silkConvertSwapSSE2;
+        table.unpack[SILK_PIXELFORMAT_XRGB8888] = silkUnpackXRGBSSE2;
+        table.unpack[SILK_PIXELFORMAT_RGB565] = silkUnpackRGB565SSE2;
+        table.hash = silkHashStripesSSE2;
+    }
+
+    if(table.features & SILK_SIMD_SSSE3) {
+        table.pack[SILK_PIXELFORMAT_BGRA8888] = silkConvertSwapSSSE3;
+        table.pack[SILK_PIXELFORMAT_XRGB8888] = silkConvertSwapSSSE3;
+        table.unpack[SILK_PIXELFORMAT_BGRA8888] = silkConvertSwapSSSE3;
+        table.unpack[SILK_PIXELFORMAT_XRGB8888] = silkUnpackXRGBSSSE3;
+    }
+
+#if !defined(SILK_SIMD_DISABLE_AVX2)
+    if(table.features & SILK_SIMD_AVX2) {
+        table.fill = silkFillAVX2;
+        table.fill_stream = silkFillStreamAVX2;
+        table.blend[SILK_BLEND_MODE_ALPHA] = silkBlendAVX2;
+        table.blend[SILK_BLEND_MODE_ADDITIVE] = silkBlendAdditiveAVX2;
+        table.blend[SILK_BLEND_MODE_MULTIPLY] = silkBlendMultiplyAVX2;
+        table.blend[SILK_BLEND_MODE_SCREEN] = silkBlendScreenAVX2;
+        table.blend[SILK_BLEND_MODE_MIN] = silkBlendMinAVX2;
+        table.blend[SILK_BLEND_MODE_MAX] = silkBlendMaxAVX2;
+        table.blend_image[SILK_BLEND_MODE_ALPHA] = silkBlendImageAVX2;
+        table.blend_image[SILK_BLEND_MODE_ADDITIVE] = silkBlendImageAdditiveAVX2;
+        table.blend_image[SILK_BLEND_MODE_MULTIPLY] = silkBlendImageMultiplyAVX2;
+        table.blend_image[SILK_BLEND_MODE_SCREEN] = silkBlendImageScreenAVX2;
+        table.blend_image[SILK_BLEND_MODE_MIN] = silkBlendImageMinAVX2;
+        table.blend_image[SILK_BLEND_MODE_MAX] = silkBlendImageMaxAVX2;
+        table.tile_coverage = silkTileCoverageAVX2;
+        table.pack[SILK_PIXELFORMAT_BGRA8888] = silkConvertSwapAVX2;
+        table.pack[SILK_PIXELFORMAT_XRGB8888] = silkConvertSwapAVX2;
+        table.pack[SILK_PIXELFORMAT_RGB565] = silkPackRGB565AVX2;
+        table.unpack[SILK_PIXELFORMAT_BGRA8888] = silkConvertSwapAVX2;
+        table.unpack[SILK_PIXELFORMAT_XRGB8888] = silkUnpackXRGBAVX2;
+        table.unpack[SILK_PIXELFORMAT_RGB565] = silkUnpackRGB565AVX2;
+        table.hash = silkHashStripesAVX2;
+    }
+#endif // SILK_SIMD_DISABLE_AVX2
+
+#if !defined(SILK_SIMD_DISABLE_AVX512)
+    if(table.features & SILK_SIMD_AVX512) {
+        table.fill = silkFillAVX512;
+        table.fill_stream = silkFillStreamAVX512;
+        table.blend[SILK_BLEND_MODE_ALPHA] = silkBlendAVX512;
+        table.blend_image[SILK_BLEND_MODE_ALPHA] = silkBlendImageAVX512;
+        table.tile_coverage = silkTileCoverageAVX512;
+    }
+#endif // SILK_SIMD_DISABLE_AVX512
+
+#elif defined(SILK_SIMD_ARM)
+
+    if(table.features & SILK_SIMD_NEON) {
+        table.fill = silkFillNEON;
+        table.fill_stream = silkFillNEON;
+        table.blend[SILK_BLEND_MODE_ALPHA] = silkBlendNEON;
+        table.blend_image[SILK_BLEND_MODE_ALPHA] = silkBlendImageNEON;
+        table.tile_coverage = silkTileCoverageNEON;
+        table.pack[SILK_PIXELFORMAT_BGRA8888] = silkConvertSwapNEON;
+        table.pack[SILK_PIXELFORMAT_XRGB8888] = silkConvertSwapNEON;
+        table.pack[SILK_PIXELFORMAT_RGB565] = silkPackRGB565NEON;
+        table.unpack[SILK_PIXELFORMAT_BGRA8888] = silkConvertSwapNEON;
+        table.unpack[SILK_PIXELFORMAT_XRGB8888] = silkUnpackXRGBNEON;
+        table.unpack[SILK_PIXELFORMAT_RGB565] = silkUnpackRGB565NEON;
+        table.hash = silkHashStripesNEON;
+    }
+
+#endif // SILK_SIMD_X86 / SILK_SIMD_ARM
+
+    // "Replace" of one color is the plain fill
+    table.blend[SILK_BLEND_MODE_REPLACE] = table.fill;
+
+    table.ready = true;
+    silk_kernels = table;
+
+    return SILK_SUCCESS;
+}
+
+static silk_kernel_table* silkGetKernels(void) {
+    if(!silk_kernels.ready) {
+        silkInitKernels(SILK_SIMD_ALL);
+    }
+
+    return &silk_kernels;
+}
+
+// --------------------------------------------------------------------------------------------------------------------------------
+// SECTION: Internal functions
+// --------------------------------------------------------------------------------------------------------------------------------
+
+// Threads:
+// Thin wrappers over pthreads (Win32 threads on Windows), just enough for the thread pool of 'silkFlush'.
+// The mutex and the condition variables are static, so they're initialized at the compile time on both platforms.
+
+#if defined(SILK_THREADS_ENABLE)
+
+#if defined(_WIN32)
+
+typedef HANDLE silk_thread;
+typedef SRWLOCK silk_mutex;
+typedef CONDITION_VARIABLE silk_condition;
+
+#define SILK_MUTEX_INIT SRWLOCK_INIT
+#define SILK_CONDITION_INIT CONDITION_VARIABLE_INIT
+
+static DWORD WINAPI silkThreadEntry(LPVOID arg);
+
+static i32 silkThreadCreate(silk_thread* thread, void* arg) {
+    *thread = CreateThread(NULL, 0, silkThreadEntry, arg, 0, NULL);
+
+    return *thread != NULL ? SILK_SUCCESS : SILK_FAILURE;
+}
+
+static void silkThreadJoin(silk_thread thread) {
+    WaitForSingleObject(thread, INFINITE);
+    CloseHandle(thread);
+}
+
+static void silkMutexLock(silk_mutex* mutex) { AcquireSRWLockExclusive(mutex); }
+static void silkMutexUnlock(silk_mutex* mutex) { ReleaseSRWLockExclusive(mutex); }
+static void silkConditionWait(silk_condition* condition, silk_mutex* mutex) { SleepConditionVariableSRW(condition, mutex, INFINITE, 0); }
+static void silkConditionBroadcast(silk_condition* condition) { WakeAllConditionVariable(condition); }
+
+static u64 silkAtomicLoad64(volatile u64* target) {
+    return (u64) InterlockedCompareExchange64((volatile LONG64*) target, 0, 0);
+}
+
+static bool silkAtomicCompareExchange64(volatile u64* target, u64 expected, u64 desired) {
+    return (u64) InterlockedCompareExchange64((volatile LONG64*) target, (LONG64) desired, (LONG64) expected) == expected;
+}
+
+#else
+
+typedef pthread_t silk_thread;
+typedef pthread_mutex_t silk_mutex;
+typedef pthread_cond_t silk_condition;
+
+#define SILK_MUTEX_INIT PTHREAD_MUTEX_INITIALIZER
+#define SILK_CONDITION_INIT PTHREAD_COND_INITIALIZER
+
+static void* silkThreadEntry(void* arg);
+
+static i32 silkThreadCreate(silk_thread* thread, void* arg) {
+    return pthread_create(thread, NULL, silkThreadEntry, arg) == 0 ? SILK_SUCCESS : SILK_FAILURE;
+}
+
+static void silkThreadJoin(silk_thread thread) {
+    pthread_join(thread, NULL);
+}
+
+static void silkMutexLock(silk_mutex* mutex) { pthread_mutex_lock(mutex); }
+static void silkMutexUnlock(silk_mutex* mutex) { pthread_mutex_unlock(mutex); }
+static void silkConditionWait(silk_condition* condition, silk_mutex* mutex) { pthread_cond_wait(condition, mutex); }
+static void silkConditionBroadcast(silk_condition* condition) { pthread_cond_broadcast(condition); }
+
+static u64 silkAtomicLoad64(volatile u64* target) {
+    return __atomic_load_n(target, __ATOMIC_ACQUIRE);
+}
+
+static bool silkAtomicCompareExchange64(volatile u64* target, u64 expected, u64 desired) {
+    return __atomic_compare_exchange_n(target, &expected, desired, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+}
+
+#endif // _WIN32
+
+// Worker threads can fail at the same time, so the error message is written under the lock
+static silk_mutex silk_error_mutex = SILK_MUTEX_INIT;
+
+#endif // SILK_THREADS_ENABLE
+
+static i32 silkAssignErrorMessage(const string msg) {
+#if defined(SILK_THREADS_ENABLE)
+    silkMutexLock(&silk_error_mutex);
+#endif // SILK_THREADS_ENABLE
+
+    strcpy(
+        silk_error_msg,
+        msg
+    );
+
+#if defined(SILK_THREADS_ENABLE)
+    silkMutexUnlock(&silk_error_mutex);
+#endif // SILK_THREADS_ENABLE
+
+    return SILK_SUCCESS;
+}
+
+// Span layer:
+// Every filled primitive is broken down into horizontal runs of pixels: [x0, x1) on the row 'y'.
+// The run is clipped against the buffer only once per row, and then written in a single tight loop,
+// instead of calling 'silkDrawPixel' (with all of it's checks) for every single pixel.
+
+// Opacity:
+// Blending with the alpha of 255 gives back the source color, and blending with the alpha of 0 gives back the destination.
+// So only the translucent colors are really blended: the opaque ones are simply stored (without reading the canvas at all),
+// and the primitives drawn with the fully transparent ones are culled right after their parameters are validated.
+
+static bool silkPixelTransparent(silk_canvas* canvas, pixel pix) {
+#if defined(SILK_ALPHABLEND_ENABLE)
+
+    // "Replace" stores even the fully transparent colors
+    return (pix & SILK_PIXEL_ALPHA_MASK) == 0 && canvas->blend_mode != SILK_BLEND_MODE_REPLACE;
+
+#else
+
+    // Without the alpha-blending every color simply overwrites the canvas
+    SILK_UNUSED(canvas)
+    SILK_UNUSED(pix)
+
+    return false;
+
+#endif // SILK_ALPHABLEND_ENABLE
+}
+
+// Color that simply overwrites the pixel: drawn over the same color, it changes nothing.
+// Every other blend mode (and the translucent "source-over") can change even the pixel equal to the color.
+static bool silkPixelOverwrites(silk_canvas* canvas, pixel pix) {
+#if defined(SILK_ALPHABLEND_ENABLE)
+
+    return canvas->blend_mode == SILK_BLEND_MODE_REPLACE ||
+           (canvas->blend_mode == SILK_BLEND_MODE_ALPHA && (pix & SILK_PIXEL_ALPHA_MASK) == SILK_PIXEL_ALPHA_MASK);
+
+#else
+
+    SILK_UNUSED(canvas)
+    SILK_UNUSED(pix)
+
+    return true;
+
+#endif // SILK_ALPHABLEND_ENABLE
+}
+
+static u8* silkCanvasAddress(silk_canvas* canvas, i32 x, i32 y) {
+    return canvas->data + (size_t) y * canvas->stride + (size_t) x * silk_pixel_format_sizes[canvas->format];
+}
+
+static i32 silkFillFormat(i32 format, u8* dest, i32 count, pixel pix, bool stream) {
+    switch(format) {
+        case SILK_PIXELFORMAT_RGB565: {
+            u16 value = silkPackRGB565(pix);
+
+            for(i32 i = 0; i < count; i++) {
+                ((u16*) dest)[i] = value;
+            }
+        } break;
+
+        case SILK_PIXELFORMAT_A8: {
+            memset(dest, (int) ((pix & SILK_PIXEL_ALPHA_MASK) >> SILK_PIXEL_ALPHA_SHIFT), (size_t) count);
+        } break;
+
+        default: {
+            silk_kernel_table* kernels = silkGetKernels();
+
+            if(format != SILK_PIXELFORMAT_RGBA8888) {
+                pix = silkPixelSwapRedBlue(pix);
+            }
+
+            (stream ? kernels->fill_stream : kernels->fill)((pixel*) dest, count, pix);
+        } break;
+    }
+
+    return SILK_SUCCESS;
+}
+
+static i32 silkBlendSpan(silk_canvas* canvas, pixel* row, i32 count, pixel pix) {
+#if defined(SILK_ALPHABLEND_ENABLE)
+
+    u32 alpha = (pix & SILK_PIXEL_ALPHA_MASK) >> SILK_PIXEL_ALPHA_SHIFT;
+
+    // Kernel is picked once per span, by the blend mode of the canvas
+    if(alpha == 255 && canvas->blend_mode == SILK_BLEND_MODE_ALPHA) {
+        silkGetKernels()->fill(row, count, pix);
+    } else if(alpha != 0 || canvas->blend_mode == SILK_BLEND_MODE_REPLACE) {
+        silkGetKernels()->blend[canvas->blend_mode](row, count, pix);
+    }
+
+#else
+
+    SILK_UNUSED(canvas)
+
+    silkGetKernels()->fill(row, count, pix);
+
+#endif // SILK_ALPHABLEND_ENABLE
+
+    return SILK_SUCCESS;
+}
+
+static i32 silkBlendImageSpan(silk_canvas* canvas, pixel* row, const pixel* src, i32 count) {
+#if defined(SILK_ALPHABLEND_ENABLE)
+
+    silkGetKernels()->blend_image[canvas->blend_mode](row, src, count);
+
+#else
+
+    SILK_UNUSED(canvas)
+
+    memcpy(row, src, (size_t) count * sizeof(pixel));
+
+#endif // SILK_ALPHABLEND_ENABLE
+
+    return SILK_SUCCESS;
+}
+
+static bool silkSpanOpaque(silk_canvas* canvas, pixel pix) {
+#if defined(SILK_ALPHABLEND_ENABLE)
+
+    // Spans which simply store the color, without reading the canvas
+    return canvas->blend_mode == SILK_BLEND_MODE_REPLACE ||
+        (canvas->blend_mode == SILK_BLEND_MODE_ALPHA && (pix & SILK_PIXEL_ALPHA_MASK) == SILK_PIXEL_ALPHA_MASK);
+
+#else
+
+    SILK_UNUSED(canvas)
+    SILK_UNUSED(pix)
+
+    return true;
+
+#endif // SILK_ALPHABLEND_ENABLE
+}
+
+static i32 silkWriteSpan(silk_canvas* canvas, i32 x, i32 y, i32 count, pixel pix) {
+    u8* dest = silkCanvasAddress(canvas, x, y);
+
+    switch(canvas->format) {
+        case SILK_PIXELFORMAT_RGBA8888: return silkBlendSpan(canvas, (pixel*) dest, count, pix);
+        case SILK_PIXELFORMAT_BGRA8888:
+        case SILK_PIXELFORMAT_XRGB8888: return silkBlendSpan(canvas, (pixel*) dest, count, silkPixelSwapRedBlue(pix));
+        default: break;
+    }
+
+    if(silkSpanOpaque(canvas, pix)) {
+        return silkFillFormat(canvas->format, dest, count, pix, false);
+    }
+
+    // 16-bit and 8-bit rows are blended in RGBA8888, one chunk at a time
+    silk_kernel_table* kernels = silkGetKernels();
+    pixel scratch[SILK_SPAN_CHUNK];
+    i32 size = silk_pixel_format_sizes[canvas->format];
+
+    for(i32 i = 0; i < count; i += SILK_SPAN_CHUNK) {
+        i32 chunk = count - i < SILK_SPAN_CHUNK ? count - i : SILK_SPAN_CHUNK;
+
+        kernels->unpack[canvas->format](scratch, dest + (size_t) i * size, chunk);
+        silkBlendSpan(canvas, scratch, chunk, pix);
+        kernels->pack[canvas->format](dest + (size_t) i * size, scratch, chunk);
+    }
+
+    return SILK_SUCCESS;
+}
+
+static i32 silkWriteImageSpan(silk_canvas* canvas, i32 x, i32 y, const pixel* src, i32 count) {
+    u8* dest = silkCanvasAddress(canvas, x, y);
+
+    if(canvas->format == SILK_PIXELFORMAT_RGBA8888) {
+        return silkBlendImageSpan(canvas, (pixel*) dest, src, count);
+    }
+
+    silk_kernel_table* kernels = silkGetKernels();
+    pixel scratch[SILK_SPAN_CHUNK];
+    i32 size = silk_pixel_format_sizes[canvas->format];
+
+    for(i32 i = 0; i < count; i += SILK_SPAN_CHUNK) {
+        i32 chunk = count - i < SILK_SPAN_CHUNK ? count - i : SILK_SPAN_CHUNK;
+        u8* chunk_dest = dest + (size_t) i * size;
+
+        if(size == (i32) sizeof(pixel)) {
+            // 32-bit canvases: the image pixels are swapped to the order of the canvas instead
+            kernels->pack[canvas->format](scratch, src + i, chunk);
+            silkBlendImageSpan(canvas, (pixel*) chunk_dest, scratch, chunk);
+        } else {
+            kernels->unpack[canvas->format](scratch, chunk_dest, chunk);
+            silkBlendImageSpan(canvas, scratch, src + i, chunk);
+            kernels->pack[canvas->format](chunk_dest, scratch, chunk);
+        }
+    }
+
+    return SILK_SUCCESS;
+}
+
+// Clipping:
+// Every primitive tests it's bounding box against the current clip rectangle once, before it's rasterized.
+// Primitives fully outside of it are skipped right away, the ones fully inside of it are drawn without
+// any further checks, and only the ones crossing it's border are clipped (once per span, or per pixel for the outlines).
+
+#define SILK_CLIP_OUTSIDE -1
+#define SILK_CLIP_PARTIAL 0
+#define SILK_CLIP_INSIDE 1
+
+static silk_rect silkRectIntersect(silk_rect a, silk_rect b) {
+    i64 x0 = a.x > b.x ? a.x : b.x;
+    i64 y0 = a.y > b.y ? a.y : b.y;
+    i64 x1 = (i64) a.x + a.w < (i64) b.x + b.w ? (i64) a.x + a.w : (i64) b.x + b.w;
+    i64 y1 = (i64) a.y + a.h < (i64) b.y + b.h ? (i64) a.y + a.h : (i64) b.y + b.h;
+
+    return (silk_rect) {
+        (i32) x0,
+        (i32) y0,
+        x1 > x0 ? (i32) (x1 - x0) : 0,
+        y1 > y0 ? (i32) (y1 - y0) : 0
+    };
+}
+
+static silk_rect silkCanvasClip(silk_canvas* canvas) {
+    if(canvas->clip_count > 0) {
+        return canvas->clip_stack[canvas->clip_count - 1];
+    }
+
+    return (silk_rect) { 0, 0, canvas->size.x, canvas->size.y };
+}
+
+static i32 silkClipBounds(silk_rect* clip, i32 x0, i32 y0, i32 x1, i32 y1) {
+    // Bounds are half-open: [x0, x1) x [y0, y1)
+    if(x0 >= x1 || y0 >= y1 ||
+       x1 <= clip->x || x0 >= clip->x + clip->w ||
+       y1 <= clip->y || y0 >= clip->y + clip->h) {
+        return SILK_CLIP_OUTSIDE;
+    }
+
+    if(x0 >= clip->x && x1 <= clip->x + clip->w &&
+       y0 >= clip->y && y1 <= clip->y + clip->h) {
+        return SILK_CLIP_INSIDE;
+    }
+
+    return SILK_CLIP_PARTIAL;
+}
+
+// Dirty rectangles:
+// Every draw call adds it's clipped bounds to the canvas' list of the changed areas. New rectangle is merged into
+// the one already in the list when less than a quarter of their union would be wasted (the pixels covered by neither of them),
+// and the union then gets the same treatment, so the overlapping damage collapses into one rectangle. When the list
+// is full, the rectangle goes into the one whose union wastes the least, so the list never loses any damage.
+
+static i64 silkRectArea(silk_rect rect) {
+    return (i64) rect.w * rect.h;
+}
+
+static silk_rect silkRectUnion(silk_rect a, silk_rect b) {
+    i32 x0 = a.x < b.x ? a.x : b.x;
+    i32 y0 = a.y < b.y ? a.y : b.y;
+    i32 x1 = a.x + a.w > b.x + b.w ? a.x + a.w : b.x + b.w;
+    i32 y1 = a.y + a.h > b.y + b.h ? a.y + a.h : b.y + b.h;
+
+    return (silk_rect) { x0, y0, x1 - x0, y1 - y0 };
+}
+
+static i32 silkMarkDirty(silk_canvas* canvas, silk_rect rect) {
+    rect = silkRectIntersect(rect, (silk_rect) { 0, 0, canvas->size.x, canvas->size.y });
+
+    if(rect.w <= 0 || rect.h <= 0) {
+        return SILK_SUCCESS;
+    }
+
+    for(;;) {
+        i32 best = -1;
+        i64 best_waste = INT64_MAX;
+        silk_rect best_union = rect;
+
+        for(i32 i = 0; i < canvas->dirty_count; i++) {
+            silk_rect dirty = canvas->dirty_rects[i];
+
+            // Already covered (the common case for the small primitives drawn over the big ones)
+            if(rect.x >= dirty.x && rect.y >= dirty.y && rect.x + rect.w <= dirty.x + dirty.w && rect.y + rect.h <= dirty.y + dirty.h) {
+                return SILK_SUCCESS;
+            }
+
+            silk_rect merged = silkRectUnion(dirty, rect);
+            i64 waste = silkRectArea(merged) - silkRectArea(dirty) - silkRectArea(rect) + silkRectArea(silkRectIntersect(dirty, rect));
+
+            if(waste < best_waste) {
+                best = i;
+                best_waste = waste;
+                best_union = merged;
+            }
+        }
+
+        if(best < 0 || (best_waste * 4 > silkRectArea(best_union) && canvas->dirty_count < SILK_DIRTY_RECT_COUNT)) {
+            canvas->dirty_rects[canvas->dirty_count++] = rect;
+
+            return SILK_SUCCESS;
+        }
+
+        // Union replaces the merged rectangle, and is then tested against the rest of the list
+        canvas->dirty_rects[best] = canvas->dirty_rects[--canvas->dirty_count];
+        rect = best_union;
+    }
+}
+
+static i32 silkMarkDirtyBounds(silk_canvas* canvas, silk_rect* clip, i32 x0, i32 y0, i32 x1, i32 y1) {
+    // Same half-open bounds as the ones tested with 'silkClipBounds', cut to the clip rectangle
+    x0 = x0 < clip->x ? clip->x : x0;
+    y0 = y0 < clip->y ? clip->y : y0;
+    x1 = x1 > clip->x + clip->w ? clip->x + clip->w : x1;
+    y1 = y1 > clip->y + clip->h ? clip->y + clip->h : y1;
+
+    if(x0 >= x1 || y0 >= y1) {
+        return SILK_SUCCESS;
+    }
+
+    return silkMarkDirty(canvas, (silk_rect) { x0, y0, x1 - x0, y1 - y0 });
+}
+
+static i32 silkWritePixel(silk_canvas* canvas, i32 x, i32 y, pixel pix) {
+    // Other blend modes (and the 16-bit and 8-bit formats) go through their one-pixel spans
+    if(canvas->blend_mode != SILK_BLEND_MODE_ALPHA || silk_pixel_format_sizes[canvas->format] != (i32) sizeof(pixel)) {
+        return silkWriteSpan(canvas, x, y, 1, pix);
+    }
+
+    pixel* dest = (pixel*) silkCanvasAddress(canvas, x, y);
+
+    if(canvas->format != SILK_PIXELFORMAT_RGBA8888) {
+        pix = silkPixelSwapRedBlue(pix);
+    }
+
+#if defined(SILK_ALPHABLEND_ENABLE)
+
+    u32 alpha = (pix & SILK_PIXEL_ALPHA_MASK) >> SILK_PIXEL_ALPHA_SHIFT;
+
+    // Same as 'silkAlphaBlend', without the call (and without reading the canvas for the opaque colors)
+    if(alpha == 255) {
+        *dest = pix;
+    } else if(alpha != 0) {
+        *dest = silkBlendPixel(*dest, pix, alpha);
+    }
+
+#else
+
+    *dest = pix;
+
+#endif // SILK_ALPHABLEND_ENABLE
+
+    return SILK_SUCCESS;
+}
+
+static i32 silkPlotPixel(silk_canvas* canvas, silk_rect* clip, i32 x, i32 y, pixel pix) {
+    // 'clip' is NULL when the whole primitive is already known to be inside of the clip rectangle
+    if(clip != NULL && (x < clip->x || x >= clip->x + clip->w || y < clip->y || y >= clip->y + clip->h)) {
+        return SILK_SUCCESS;
+    }
+
+    return silkWritePixel(canvas, x, y, pix);
+}
+
+static i32 silkPlotPixelCoverage(silk_canvas* canvas, silk_rect* clip, i32 x, i32 y, pixel pix, u32 coverage) {
+    // Coverage (0 - 255) of the anti-aliased primitives scales the alpha of the color
+    if(clip != NULL && (x < clip->x || x >= clip->x + clip->w || y < clip->y || y >= clip->y + clip->h)) {
+        return SILK_SUCCESS;
+    }
+
+    u8* address = silkCanvasAddress(canvas, x, y);
+    pixel* dest = (pixel*) address;
+    pixel converted = 0;
+
+    // Other formats are blended in a one-pixel RGBA8888 scratch
+    if(canvas->format != SILK_PIXELFORMAT_RGBA8888) {
+        silkGetKernels()->unpack[canvas->format](&converted, address, 1);
+        dest = &converted;
+    }
+
+    // "Replace" moves every channel (the alpha included) towards the color by the coverage
+    if(canvas->blend_mode == SILK_BLEND_MODE_REPLACE) {
+        pixel replaced = 0;
+
+        for(i32 shift = 0; shift < 32; shift += 8) {
+            i32 dst = (i32) ((*dest >> shift) & 0xff);
+            i32 src = (i32) ((pix >> shift) & 0xff);
+
+            replaced |= (pixel) (dst + ((src - dst) * (i32) coverage + (src >= dst ? 127 : -127)) / 255) << shift;
+        }
+
+        *dest = replaced;
+    } else {
+        u32 alpha = ((pix & SILK_PIXEL_ALPHA_MASK) >> SILK_PIXEL_ALPHA_SHIFT) * coverage + 128;
+        alpha = (alpha + (alpha >> 8)) >> 8;
+
+        if(alpha == 0) {
+            return SILK_SUCCESS;
+        }
+
+#if defined(SILK_PREMULTIPLIED_ALPHA)
+
+        // Premultiplied color is faded by scaling all of it's channels
+        pix = silkScalePixel(pix, coverage);
+
+#else
+
+        pix = (pix & ~SILK_PIXEL_ALPHA_MASK) | ((pixel) alpha << SILK_PIXEL_ALPHA_SHIFT);
+
+#endif // SILK_PREMULTIPLIED_ALPHA
+
+        if(canvas->blend_mode != SILK_BLEND_MODE_ALPHA) {
+            // Other blend modes take the coverage as a part of the alpha
+            silkGetKernels()->blend[canvas->blend_mode](dest, 1, pix);
+        } else if(alpha == 255) {
+            // Fully covered pixel of an opaque color
+            *dest = pix;
+        } else {
+            *dest = silkBlendPixel(*dest, pix, alpha);
+        }
+    }
+
+    if(dest == &converted) {
+        silkGetKernels()->pack[canvas->format](address, &converted, 1);
+    }
+
+    return SILK_SUCCESS;
+}
+
+static i32 silkPlotCircleOctants(silk_canvas* canvas, silk_rect* clip, vec2i center, i32 x, i32 y, pixel pix) {
+    silkPlotPixel(canvas, clip, center.x + x, center.y + y, pix);
+    silkPlotPixel(canvas, clip, center.x - x, center.y + y, pix);
+    silkPlotPixel(canvas, clip, center.x + x, center.y - y, pix);
+    silkPlotPixel(canvas, clip, center.x - x, center.y - y, pix);
+    silkPlotPixel(canvas, clip, center.x + y, center.y + x, pix);
+    silkPlotPixel(canvas, clip, center.x - y, center.y + x, pix);
+    silkPlotPixel(canvas, clip, center.x + y, center.y - x, pix);
+    silkPlotPixel(canvas, clip, center.x - y, center.y - x, pix);
+
+    return SILK_SUCCESS;
+}
+
+static i32 silkFillRegion(silk_canvas* canvas, vec2i region, pixel pix) {
+    // Region always starts at (0, 0), so we only need to clamp it's far corner
+    if(region.x > canvas->size.x) {
+        region.x = canvas->size.x;
+    }
+
+    if(region.y > canvas->size.y) {
+        region.y = canvas->size.y;
+    }
+
+    if(region.x <= 0 || region.y <= 0) {
+        return SILK_SUCCESS;
+    }
+
+    i32 size = silk_pixel_format_sizes[canvas->format];
+    bool stream = (size_t) region.x * region.y * size >= SILK_NONTEMPORAL_THRESHOLD;
+
+    // Rows are back-to-back (no padding), so the whole region is one contiguous run of pixels
+    if(canvas->stride == region.x * size) {
+        return silkFillFormat(canvas->format, canvas->data, region.x * region.y, pix, stream);
+    }
+
+    for(i32 y = 0; y < region.y; y++) {
+        silkFillFormat(canvas->format, silkCanvasAddress(canvas, 0, y), region.x, pix, stream);
+    }
+
+    return SILK_SUCCESS;
+}
+
+static i32 silkDrawSpan(silk_canvas* canvas, i32 y, i32 x0, i32 x1, pixel pix) {
+    silk_rect clip = silkCanvasClip(canvas);
+
+    if(y < clip.y || y >= clip.y + clip.h) {
+        return SILK_SUCCESS;
+    }
+
+    if(x0 < clip.x) {
+        x0 = clip.x;
+    }
+
+    if(x1 > clip.x + clip.w) {
+        x1 = clip.x + clip.w;
+    }
+
+    if(x0 >= x1) {
+        return SILK_SUCCESS;
+    }
+
+    silkWriteSpan(canvas, x0, y, x1 - x0, pix);
+
+    return SILK_SUCCESS;
+}
+
+// Triangle setup:
+// Vertices are 28.4 fixed-point numbers (see: 'SILK_SUBPIXEL_BITS') and every pixel is sampled at it's center, (x + 0.5, y + 0.5).
+// Every edge of the triangle is a linear function 'E(x, y)', positive on the inner side of the edge; pixel is covered when
+// all three functions are non-negative. All of the math is exact (integer), so two triangles sharing an edge always agree on it.
+// Pixels lying exactly on an edge follow the top-left rule: they belong to the triangle only if the edge is a "top" edge
+// (horizontal, with the triangle below it) or a "left" edge. Thanks to that, every pixel of a mesh is drawn exactly once:
+// no seams, no double-blended edges.
+
+typedef struct {
+    vec2i points[3];    // vertices (28.4), wound so the inside is on the positive side of the edges
+    i64 step_x[3];      // increment of the edge functions per pixel (x)
+    i64 step_y[3];      // increment of the edge functions per pixel (y)
+    i64 bias[3];        // top-left rule: -1 for the edges that don't own the pixels lying exactly on them
+    i32 x0;             // covered area (clipped to the canvas): [x0, x1) x [y0, y1)
+    i32 y0;
+    i32 x1;
+    i32 y1;
+} silk_raster_triangle;
+
+static bool silkRasterSetup(silk_canvas* canvas, vec2i point_a, vec2i point_b, vec2i point_c, silk_raster_triangle* triangle) {
+    i64 area = (i64) (point_b.x - point_a.x) * (point_c.y - point_a.y) - (i64) (point_b.y - point_a.y) * (point_c.x - point_a.x);
+
+    // Degenerate triangle doesn't cover anything
+    if(area == 0) {
+        return false;
+    }
+
+    // Making the winding consistent, so the inside of the triangle is always on the positive side of the edges
+    if(area < 0) {
+        silkVectorSwap(&point_b, &point_c);
+    }
+
+    const i32 half = SILK_SUBPIXEL_ONE / 2;
+
+    i32 min_x = point_a.x < point_b.x ? (point_a.x < point_c.x ? point_a.x : point_c.x) : (point_b.x < point_c.x ? point_b.x : point_c.x);
+    i32 min_y = point_a.y < point_b.y ? (point_a.y < point_c.y ? point_a.y : point_c.y) : (point_b.y < point_c.y ? point_b.y : point_c.y);
+    i32 max_x = point_a.x > point_b.x ? (point_a.x > point_c.x ? point_a.x : point_c.x) : (point_b.x > point_c.x ? point_b.x : point_c.x);
+    i32 max_y = point_a.y > point_b.y ? (point_a.y > point_c.y ? point_a.y : point_c.y) : (point_b.y > point_c.y ? point_b.y : point_c.y);
+
+    // Bounding box of the pixel centers, clipped to the clip rectangle (triangles outside of it are culled here)
+    triangle->x0 = (min_x - half + SILK_SUBPIXEL_ONE - 1) >> SILK_SUBPIXEL_BITS;
+    triangle->y0 = (min_y - half + SILK_SUBPIXEL_ONE - 1) >> SILK_SUBPIXEL_BITS;
+    triangle->x1 = ((max_x - half) >> SILK_SUBPIXEL_BITS) + 1;
+    triangle->y1 = ((max_y - half) >> SILK_SUBPIXEL_BITS) + 1;
+
+    silk_rect clip = silkCanvasClip(canvas);
+
+    triangle->x0 = triangle->x0 < clip.x ? clip.x : triangle->x0;
+    triangle->y0 = triangle->y0 < clip.y ? clip.y : triangle->y0;
+    triangle->x1 = triangle->x1 > clip.x + clip.w ? clip.x + clip.w : triangle->x1;
+    triangle->y1 = triangle->y1 > clip.y + clip.h ? clip.y + clip.h : triangle->y1;
+
+    if(triangle->x0 >= triangle->x1 || triangle->y0 >= triangle->y1) {
+        return false;
+    }
+
+    triangle->points[0] = point_a;
+    triangle->points[1] = point_b;
+    triangle->points[2] = point_c;
+
+    // Edge 'i' goes from 'points[i]' to 'points[i + 1]'. The values are in the 24.8 units (sub-pixel * sub-pixel).
+    for(i32 i = 0; i < 3; i++) {
+        vec2i from = triangle->points[i];
+        vec2i to = triangle->points[(i + 1) % 3];
+
+        i64 dx = (i64) to.x - from.x;
+        i64 dy = (i64) to.y - from.y;
+
+        triangle->step_x[i] = -dy * SILK_SUBPIXEL_ONE;
+        triangle->step_y[i] = dx * SILK_SUBPIXEL_ONE;
+
+        bool top_edge = dy == 0 && dx > 0;
+        bool left_edge = dy < 0;
+
+        triangle->bias[i] = top_edge || left_edge ? 0 : -1;
+    }
+
+    return true;
+}
+
+static i64 silkRasterEdgeValue(silk_raster_triangle* triangle, i32 i, i32 x, i32 y) {
+    vec2i from = triangle->points[i];
+    vec2i to = triangle->points[(i + 1) % 3];
+
+    const i32 half = SILK_SUBPIXEL_ONE / 2;
+
+    return
+        ((i64) to.x - from.x) * ((i64) y * SILK_SUBPIXEL_ONE + half - from.y) -
+        ((i64) to.y - from.y) * ((i64) x * SILK_SUBPIXEL_ONE + half - from.x) +
+        triangle->bias[i];
+}
+
+static i64 silkFloorDiv(i64 numerator, i64 denominator) {
+    // C division truncates towards zero, this one rounds towards negative infinity ('denominator' must be positive)
+    i64 result = numerator / denominator;
+
+    if(numerator % denominator != 0 && numerator < 0) {
+        result--;
+    }
+
+    return result;
+}
+
+// Scanline rasterizer:
+// 'E(x, y) >= 0' is solved for 'x' for every edge, which gives the span of the row: the edges rising to the right
+// limit the span from the left, the other ones from the right. The bound 'floor(E(0, y) / |step_x|)' is stepped
+// from one row to the next exactly (quotient + remainder), so there's no division in the loop.
+
+static i32 silkRasterTriangleScanline(silk_canvas* canvas, silk_raster_triangle* triangle, pixel pix) {
+    i64 value[3];           // edges with 'step_x == 0': value of the edge function in the current row
+    i64 bound[3];           // edges with 'step_x != 0': 'floor(E(0, y) / |step_x|)'
+    i64 remainder[3];
+    i64 step_quotient[3];
+    i64 step_remainder[3];
+    i64 divisor[3];
+
+    for(i32 i = 0; i < 3; i++) {
+        value[i] = silkRasterEdgeValue(triangle, i, 0, triangle->y0);
+        divisor[i] = triangle->step_x[i] < 0 ? -triangle->step_x[i] : triangle->step_x[i];
+
+        if(divisor[i] != 0) {
+            bound[i] = silkFloorDiv(value[i], divisor[i]);
+            remainder[i] = value[i] - bound[i] * divisor[i];
+            step_quotient[i] = silkFloorDiv(triangle->step_y[i], divisor[i]);
+            step_remainder[i] = triangle->step_y[i] - step_quotient[i] * divisor[i];
+        }
+    }
+
+    for(i32 y = triangle->y0; y < triangle->y1; y++) {
+        i64 start = triangle->x0;
+        i64 end = triangle->x1;
+
+        for(i32 i = 0; i < 3; i++) {
+            if(triangle->step_x[i] > 0) {
+                // E(x) >= 0  <=>  x >= -floor(E(0) / step_x)
+                start = -bound[i] > start ? -bound[i] : start;
+            } else if(triangle->step_x[i] < 0) {
+                // E(x) >= 0  <=>  x <= floor(E(0) / -step_x)
+                end = bound[i] + 1 < end ? bound[i] + 1 : end;
+            } else if(value[i] < 0) {
+                // Horizontal edge: the whole row is either inside or outside
+                end = start;
+            }
+
+            if(divisor[i] != 0) {
+                bound[i] += step_quotient[i];
+                remainder[i] += step_remainder[i];
+
+                if(remainder[i] >= divisor[i]) {
+                    bound[i]++;
+                    remainder[i] -= divisor[i];
+                }
+            } else {
+                value[i] += triangle->step_y[i];
+            }
+        }
+
+        if(start < end) {
+            silkWriteSpan(canvas, start, y, (i32) (end - start), pix);
+        }
+    }
+
+    return SILK_SUCCESS;
+}
+
+// Half-space rasterizer:
+// The bounding box is walked in 8x8 tiles: the edge functions are evaluated only at the tile corners, which is enough
+// to reject the empty tiles and to accept the fully covered ones in bulk. Only the partially covered tiles are tested
+// pixel by pixel (with the SIMD kernels). As the triangle is convex, the covered pixels of every row form a single span,
+// so the tiles of one tile-row are merged into at most 8 spans before they're written.
+
+static i32 silkLowestBit(u32 value) {
+#if defined(__GNUC__) || defined(__clang__)
+
+    return __builtin_ctz(value);
+
+#else
+
+    i32 result = 0;
+
+    while(!(value & 1)) {
+        value >>= 1;
+        result++;
+    }
+
+    return result;
+
+#endif // __GNUC__
+}
+
+static i32 silkHighestBit(u32 value) {
+#if defined(__GNUC__) || defined(__clang__)
+
+    return 31 - __builtin_clz(value);
+
+#else
+
+    i32 result = 0;
+
+    while(value >>= 1) {
+        result++;
+    }
+
+    return result;
+
+#endif // __GNUC__
+}
+
+typedef struct {
+    i64 row[3];         // edge functions at the top-left pixel of the first tile in the current tile-row
+    i64 tile_step[3];   // increment of the edge functions from one tile to the next one
+    i64 low[3];         // offset (from the top-left pixel) to the smallest value of the edge function in a tile
+    i64 high[3];        // offset (from the top-left pixel) to the largest value of the edge function in a tile
+    i32 step_x[3];      // increment of the edge functions per pixel (x)
+    i32 step_y[3];      // increment of the edge functions per pixel (y)
+} silk_raster_edges;
+
+#define SILK_TILE_OUTSIDE -1
+#define SILK_TILE_PARTIAL 0
+#define SILK_TILE_COVERED 1
+
+static i32 silkRasterClassifyTile(silk_raster_edges* edges, i32 tile, i32 edge[3], i32 step_x[3], i32 step_y[3]) {
+    i32 result = SILK_TILE_COVERED;
+
+    for(i32 i = 0; i < 3; i++) {
+        i64 value = edges->row[i] + tile * edges->tile_step[i];
+
+        if(value + edges->high[i] < 0) {
+            return SILK_TILE_OUTSIDE;
+        }
+
+        if(value + edges->low[i] >= 0) {
+            // Edge doesn't cross the tile: it can't reject any pixel in it
+            edge[i] = 0;
+            step_x[i] = 0;
+            step_y[i] = 0;
+        } else {
+            // Edge crosses the tile, so it's value here is small enough for the 32-bit lanes
+            edge[i] = (i32) value;
+            step_x[i] = edges->step_x[i];
+            step_y[i] = edges->step_y[i];
+
+            result = SILK_TILE_PARTIAL;
+        }
+    }
+
+    return result;
+}
+
+static i32 silkRasterPartialTile(const i32 edge[3], const i32 step_x[3], const i32 step_y[3], i32 tile_x, i32 row_start[], i32 row_end[]) {
+    u64 mask = silkGetKernels()->tile_coverage(edge, step_x, step_y);
+
+    for(i32 r = 0; r < SILK_RASTER_TILE_SIZE; r++) {
+        u32 row = (u32) (mask >> (r * SILK_RASTER_TILE_SIZE)) & 0xff;
+
+        if(row == 0) {
+            continue;
+        }
+
+        i32 start = tile_x + silkLowestBit(row);
+        i32 end = tile_x + silkHighestBit(row) + 1;
+
+        row_start[r] = start < row_start[r] ? start : row_start[r];
+        row_end[r] = end > row_end[r] ? end : row_end[r];
+    }
+
+    return SILK_SUCCESS;
+}
+
+static i32 silkRasterTriangleHalfSpace(silk_canvas* canvas, silk_raster_triangle* triangle, pixel pix) {
+    const i32 tile_last = SILK_RASTER_TILE_SIZE - 1;
+
+    i32 x0 = triangle->x0;
+    i32 y0 = triangle->y0;
+    i32 x1 = triangle->x1;
+    i32 y1 = triangle->y1;
+
+    // Tiles are aligned to the canvas grid
+    i32 tile_x0 = x0 & ~(SILK_RASTER_TILE_SIZE - 1);
+    i32 tile_y0 = y0 & ~(SILK_RASTER_TILE_SIZE - 1);
+    i32 tile_count = (x1 - tile_x0 + SILK_RASTER_TILE_SIZE - 1) / SILK_RASTER_TILE_SIZE;
+
+    silk_raster_edges edges = { 0 };
+
+    for(i32 i = 0; i < 3; i++) {
+        // Vertices are inside of the guard band, so the per-pixel steps fit in the 32-bit lanes
+        edges.step_x[i] = (i32) triangle->step_x[i];
+        edges.step_y[i] = (i32) triangle->step_y[i];
+
+        edges.row[i] = silkRasterEdgeValue(triangle, i, tile_x0, tile_y0);
+        edges.tile_step[i] = triangle->step_x[i] * SILK_RASTER_TILE_SIZE;
+
+        // Edge function is linear, so it's extremes inside of the tile are at the corners
+        edges.low[i] = (edges.step_x[i] < 0 ? (i64) edges.step_x[i] * tile_last : 0) + (edges.step_y[i] < 0 ? (i64) edges.step_y[i] * tile_last : 0);
+        edges.high[i] = (edges.step_x[i] > 0 ? (i64) edges.step_x[i] * tile_last : 0) + (edges.step_y[i] > 0 ? (i64) edges.step_y[i] * tile_last : 0);
+    }
+
+    for(i32 tile_y = tile_y0; tile_y < y1; tile_y += SILK_RASTER_TILE_SIZE) {
+        i32 row_start[SILK_RASTER_TILE_SIZE];
+        i32 row_end[SILK_RASTER_TILE_SIZE];
+
+        for(i32 r = 0; r < SILK_RASTER_TILE_SIZE; r++) {
+            row_start[r] = x1;
+            row_end[r] = x0;
+        }
+
+        i32 edge[3];
+        i32 step_x[3];
+        i32 step_y[3];
+
+        // Walking from the left, until the first fully covered tile...
+        i32 left = 0;
+
+        for(; left < tile_count; left++) {
+            i32 tile = silkRasterClassifyTile(&edges, left, edge, step_x, step_y);
+
+            if(tile == SILK_TILE_COVERED) {
+                break;
+            } else if(tile == SILK_TILE_PARTIAL) {
+                silkRasterPartialTile(edge, step_x, step_y, tile_x0 + left * SILK_RASTER_TILE_SIZE, row_start, row_end);
+            }
+        }
+
+        // ...and from the right, until the first fully covered tile. The triangle is convex,
+        // so every tile between the two covered ones is fully covered as well, and there's no need to test them.
+        if(left < tile_count) {
+            i32 right = tile_count - 1;
+
+            for(; right > left; right--) {
+                i32 tile = silkRasterClassifyTile(&edges, right, edge, step_x, step_y);
+
+                if(tile == SILK_TILE_COVERED) {
+                    break;
+                } else if(tile == SILK_TILE_PARTIAL) {
+                    silkRasterPartialTile(edge, step_x, step_y, tile_x0 + right * SILK_RASTER_TILE_SIZE, row_start, row_end);
+                }
+            }
+
+            i32 covered_start = tile_x0 + left * SILK_RASTER_TILE_SIZE;
+            i32 covered_end = tile_x0 + (right + 1) * SILK_RASTER_TILE_SIZE;
+
+            for(i32 r = 0; r < SILK_RASTER_TILE_SIZE; r++) {
+                row_start[r] = covered_start < row_start[r] ? covered_start : row_start[r];
+                row_end[r] = covered_end > row_end[r] ? covered_end : row_end[r];
+            }
+        }
+
+        for(i32 r = 0; r < SILK_RASTER_TILE_SIZE; r++) {
+            i32 y = tile_y + r;
+
+            if(y < y0 || y >= y1) {
+                continue;
+            }
+
+            i32 start = row_start[r] < x0 ? x0 : row_start[r];
+            i32 end = row_end[r] > x1 ? x1 : row_end[r];
+
+            if(start < end) {
+                silkWriteSpan(canvas, start, y, end - start, pix);
+            }
+        }
+
+        for(i32 i = 0; i < 3; i++) {
+            edges.row[i] += (i64) edges.step_y[i] * SILK_RASTER_TILE_SIZE;
+        }
+    }
+
+    return SILK_SUCCESS;
+}
+
+static i32 silkRasterTriangle(silk_canvas* canvas, vec2i point_a, vec2i point_b, vec2i point_c, pixel pix) {
+    vec2i points[3] = { point_a, point_b, point_c };
+    bool inside_guard_band = true;
+
+    for(i32 i = 0; i < 3; i++) {
+        // Beyond this range the edge functions could overflow even the 64-bit integers
+        if(points[i].x < -SILK_RASTER_MAX_COORD * SILK_SUBPIXEL_ONE || points[i].x > SILK_RASTER_MAX_COORD * SILK_SUBPIXEL_ONE ||
+           points[i].y < -SILK_RASTER_MAX_COORD * SILK_SUBPIXEL_ONE || points[i].y > SILK_RASTER_MAX_COORD * SILK_SUBPIXEL_ONE) {
+            silkAssignErrorMessage(SILK_ERR_OUT_OF_BOUNDS);
+
+            return SILK_FAILURE;
+        }
+
+        // Guard band keeps all of the edge function values of the half-space rasterizer inside of the 32-bit SIMD lanes
+        if(points[i].x < -SILK_RASTER_GUARD_BAND * SILK_SUBPIXEL_ONE || points[i].x > SILK_RASTER_GUARD_BAND * SILK_SUBPIXEL_ONE ||
+           points[i].y < -SILK_RASTER_GUARD_BAND * SILK_SUBPIXEL_ONE || points[i].y > SILK_RASTER_GUARD_BAND * SILK_SUBPIXEL_ONE) {
+            inside_guard_band = false;
+        }
+    }
+
+    silk_raster_triangle triangle = { 0 };
+
+    if(silkPixelTransparent(canvas, pix) || !silkRasterSetup(canvas, point_a, point_b, point_c, &triangle)) {
+        return SILK_SUCCESS;
+    }
+
+    silkMarkDirty(canvas, (silk_rect) { triangle.x0, triangle.y0, triangle.x1 - triangle.x0, triangle.y1 - triangle.y0 });
+
+    if(silk_rasterizer == SILK_RASTERIZER_HALFSPACE && inside_guard_band) {
+        return silkRasterTriangleHalfSpace(canvas, &triangle, pix);
+    }
+
+    return silkRasterTriangleScanline(canvas, &triangle, pix);
+}
+
+static vec2i silkToSubpixel(f32 x, f32 y) {
+    // Rounding to the nearest 1/16 of a pixel
+    return (vec2i) {
+        (i32) floorf(x * SILK_SUBPIXEL_ONE + 0.5f),
+        (i32) floorf(y * SILK_SUBPIXEL_ONE + 0.5f)
+    };
+}
+
+// Polygons:
+// Arbitrary (concave and self-intersecting) polygons are filled with the active edge table. Vertices are 28.4
+// fixed-point numbers and pixels are sampled at their centers, exactly like the triangles: every edge covers the rows whose
+// centers lie in [top, bottom), and the crossing 'x' of every row is stepped exactly (quotient + remainder) as the index
+// of the first pixel center at or to the right of the edge. Between the sorted crossings the fill rule decides what's
+// inside, and every inside run is written as a single span, so no pixel is ever written twice.
+
+typedef struct {
+    i32 y0;             // first row covered by the edge
+    i32 y1;             // last row covered by the edge + 1
+    i32 direction;      // +1 for the edges going down, -1 for the edges going up (winding number)
+    i64 top_x;          // upper vertex (28.4)
+    i64 top_y;
+    i64 dx;             // vector from the upper to the lower vertex (28.4, 'dy > 0')
+    i64 dy;
+    i64 x;              // index of the first pixel at or to the right of the edge, in the current row...
+    i64 remainder;      // ...and the remainder of it's division
+    i64 step_quotient;  // change of the two above from one row to the next one
+    i64 step_remainder;
+} silk_polygon_edge;
+
+static int silkPolygonEdgeCompare(const void* a, const void* b) {
+    const silk_polygon_edge* edge_a = (const silk_polygon_edge*) a;
+    const silk_polygon_edge* edge_b = (const silk_polygon_edge*) b;
+
+    return (edge_a->y0 > edge_b->y0) - (edge_a->y0 < edge_b->y0);
+}
+
+static i32 silkPolygonEdgeActivate(silk_polygon_edge* edge, i32 y) {
+    // Pixel 'x' is at or to the right of the edge when '16 * x + 8 >= top_x + (16 * y + 8 - top_y) * dx / dy',
+    // so the first one is 'ceil(numerator / divisor)'. It's kept as the floor of 'numerator + divisor - 1'.
+    i64 divisor = edge->dy * SILK_SUBPIXEL_ONE;
+    i64 numerator = edge->top_x * edge->dy + ((i64) y * SILK_SUBPIXEL_ONE + SILK_SUBPIXEL_ONE / 2 - edge->top_y) * edge->dx - (SILK_SUBPIXEL_ONE / 2) * edge->dy;
+    i64 step = edge->dx * SILK_SUBPIXEL_ONE;
+
+    edge->x = silkFloorDiv(numerator + divisor - 1, divisor);
+    edge->remainder = numerator + divisor - 1 - edge->x * divisor;
+    edge->step_quotient = silkFloorDiv(step, divisor);
+    edge->step_remainder = step - edge->step_quotient * divisor;
+
+    return SILK_SUCCESS;
+}
+
+static i32 silkPolygonEdgeStep(silk_polygon_edge* edge) {
+    i64 divisor = edge->dy * SILK_SUBPIXEL_ONE;
+
+    edge->x += edge->step_quotient;
+    edge->remainder += edge->step_remainder;
+
+    if(edge->remainder >= divisor) {
+        edge->x++;
+        edge->remainder -= divisor;
+    }
+
+    return SILK_SUCCESS;
+}
+
+static i32 silkRasterPolygon(silk_canvas* canvas, const vec2i* points, i32 count, i32 fill_rule, pixel pix) {
+    const i32 half = SILK_SUBPIXEL_ONE / 2;
+
+    i32 min_x = points[0].x;
+    i32 min_y = points[0].y;
+    i32 max_x = points[0].x;
+    i32 max_y = points[0].y;
+
+    for(i32 i = 1; i < count; i++) {
+        min_x = points[i].x < min_x ? points[i].x : min_x;
+        min_y = points[i].y < min_y ? points[i].y : min_y;
+        max_x = points[i].x > max_x ? points[i].x : max_x;
+        max_y = points[i].y > max_y ? points[i].y : max_y;
+    }
+
+    // Bounding box of the pixel centers, same as for the triangles
+    i32 left = (min_x - half + SILK_SUBPIXEL_ONE - 1) >> SILK_SUBPIXEL_BITS;
+    i32 top = (min_y - half + SILK_SUBPIXEL_ONE - 1) >> SILK_SUBPIXEL_BITS;
+    i32 right = ((max_x - half) >> SILK_SUBPIXEL_BITS) + 1;
+    i32 bottom = ((max_y - half) >> SILK_SUBPIXEL_BITS) + 1;
+
+    silk_rect clip = silkCanvasClip(canvas);
+    i32 clip_test = silkClipBounds(&clip, left, top, right, bottom);
+
+    if(clip_test == SILK_CLIP_OUTSIDE || silkPixelTransparent(canvas, pix)) {
+        return SILK_SUCCESS;
+    }
+
+    silkMarkDirtyBounds(canvas, &clip, left, top, right, bottom);
+
+    // Small polygons don't allocate any memory
+    silk_polygon_edge stack_edges[SILK_POLYGON_STACK_EDGES];
+    silk_polygon_edge* stack_active[SILK_POLYGON_STACK_EDGES];
+
+    silk_polygon_edge* edges = stack_edges;
+    silk_polygon_edge** active = stack_active;
+
+    if(count > SILK_POLYGON_STACK_EDGES) {
+        edges = (silk_polygon_edge*) SILK_MALLOC((size_t) count * sizeof(silk_polygon_edge));
+        active = (silk_polygon_edge**) SILK_MALLOC((size_t) count * sizeof(silk_polygon_edge*));
+
+        if(edges == NULL || active == NULL) {
+            SILK_FREE(edges);
+            SILK_FREE(active);
+
+            silkAssignErrorMessage(SILK_ERR_ALLOCATION_FAIL);
+
+            return SILK_FAILURE;
+        }
+    }
+
+    // Edge table: every edge that covers at least one row, sorted by it's first row
+    i32 edge_count = 0;
+
+    for(i32 i = 0; i < count; i++) {
+        vec2i from = points[i];
+        vec2i to = points[(i + 1) % count];
+
+        silk_polygon_edge edge = { 0 };
+        edge.direction = to.y > from.y ? 1 : -1;
+
+        if(to.y < from.y) {
+            vec2i temp = from;
+            from = to;
+            to = temp;
+        }
+
+        // First and last row with the pixel centers in [from.y, to.y); horizontal edges don't cover any
+        edge.y0 = (from.y - half + SILK_SUBPIXEL_ONE - 1) >> SILK_SUBPIXEL_BITS;
+        edge.y1 = (to.y - half + SILK_SUBPIXEL_ONE - 1) >> SILK_SUBPIXEL_BITS;
+
+        if(edge.y0 >= edge.y1) {
+            continue;
+        }
+
+        edge.top_x = from.x;
+        edge.top_y = from.y;
+        edge.dx = (i64) to.x - from.x;
+        edge.dy = (i64) to.y - from.y;
+
+        edges[edge_count++] = edge;
+    }
+
+    qsort(edges, (size_t) edge_count, sizeof(silk_polygon_edge), silkPolygonEdgeCompare);
+
+    i32 y0 = edge_count > 0 ? edges[0].y0 : 0;
+    i32 y1 = y0;
+
+    for(i32 i = 0; i < edge_count; i++) {
+        y1 = edges[i].y1 > y1 ? edges[i].y1 : y1;
+    }
+
+    y0 = y0 < clip.y ? clip.y : y0;
+    y1 = y1 > clip.y + clip.h ? clip.y + clip.h : y1;
+
+    i32 next_edge = 0;
+    i32 active_count = 0;
+
+    for(i32 y = y0; y < y1; y++) {
+        // Dropping the edges that end above this row...
+        i32 kept = 0;
+
+        for(i32 i = 0; i < active_count; i++) {
+            if(active[i]->y1 > y) {
+                active[kept++] = active[i];
+            }
+        }
+
+        active_count = kept;
+
+        // ...and adding the ones that start here (or above the first visible row)
+        while(next_edge < edge_count && edges[next_edge].y0 <= y) {
+            if(edges[next_edge].y1 > y) {
+                silkPolygonEdgeActivate(&edges[next_edge], y);
+
+                active[active_count++] = &edges[next_edge];
+            }
+
+            next_edge++;
+        }
+
+        // Crossings barely move between the rows, so the insertion sort is almost free
+        for(i32 i = 1; i < active_count; i++) {
+            silk_polygon_edge* edge = active[i];
+            i32 j = i - 1;
+
+            while(j >= 0 && active[j]->x > edge->x) {
+                active[j + 1] = active[j];
+                j--;
+            }
+
+            active[j + 1] = edge;
+        }
+
+        i32 winding = 0;
+        i64 span_start = 0;
+
+        for(i32 i = 0; i < active_count; i++) {
+            bool was_inside = fill_rule == SILK_FILL_RULE_NON_ZERO ? winding != 0 : (winding & 1) != 0;
+
+            winding += active[i]->direction;
+
+            bool is_inside = fill_rule == SILK_FILL_RULE_NON_ZERO ? winding != 0 : (winding & 1) != 0;
+
+            if(!was_inside && is_inside) {
+                span_start = active[i]->x;
+            } else if(was_inside && !is_inside && active[i]->x > span_start) {
+                i64 x0 = span_start;
+                i64 x1 = active[i]->x;
+
+                if(clip_test == SILK_CLIP_INSIDE) {
+                    silkWriteSpan(canvas, x0, y, (i32) (x1 - x0), pix);
+                } else {
+                    x0 = x0 < clip.x ? clip.x : x0;
+                    x1 = x1 > clip.x + clip.w ? clip.x + clip.w : x1;
+
+                    if(x0 < x1) {
+                        silkWriteSpan(canvas, x0, y, (i32) (x1 - x0), pix);
+                    }
+                }
+            }
+
+            silkPolygonEdgeStep(active[i]);
+        }
+    }
+
+    if(edges != stack_edges) {
+        SILK_FREE(edges);
+        SILK_FREE(active);
+    }
+
+    return SILK_SUCCESS;
+}
+
+// Paths:
+// Paths are filled with the signed-area coverage accumulation. Every line segment adds the signed area it covers in each
+// pixel of the accumulation buffer (for the pixels it crosses) and the change of the coverage right after it, so the running
+// sum of the row gives the exact coverage of every pixel. Pixels between the edges receive nothing, which makes the cost of
+// the outline proportional to it's length, and the single pass over the buffer turns it into the blended spans (and clears
+// it). The buffer only holds a band of rows, so it stays in the cache and doesn't have to be allocated for the whole path.
+// Every written cell is also marked in the bitmap, so the pass jumps straight from one cell to the next one.
+// Areas are accumulated in the fixed-point units, and every row of the segment is computed directly from it's absolute
+// coordinates: the cells left of the buffer are folded (exactly) into it's first column, and the ones right of it are
+// dropped. Clipped path therefore produces exactly the same pixels as the unclipped one, no matter where the clip is.
+// Source: https://github.com/raphlinus/font-rs (accumulation buffer)
+// Source: https://nothings.org/gamedev/rasterize/ (signed area coverage)
+
+static f32 silkPathCellArea(i32 cell, i32 x0i, i32 x1i, f32 x_middle, f32 area_first, f32 area_second, f32 area_last, f32 s) {
+    // Area of the segment covered by the cells up to (and including) 'cell', as the fraction of it's whole area
+    if(cell < x0i) {
+        return 0.0f;
+    }
+
+    if(cell >= x1i) {
+        return 1.0f;
+    }
+
+    if(x1i <= x0i + 1) {
+        return 1.0f - x_middle;
+    }
+
+    if(cell == x0i) {
+        return area_first;
+    }
+
+    if(cell == x1i - 1) {
+        return 1.0f - area_last;
+    }
+
+    return area_second + (f32) (cell - x0i - 1) * s;
+}
+
+static i32 silkPathAccumulateLine(i32* accumulation, u32* touched, i32 stride, silk_rect area, vec2f from, vec2f to) {
+    if(from.y == to.y) {
+        return SILK_SUCCESS;
+    }
+
+    i32 direction = 1;
+
+    if(from.y > to.y) {
+        vec2f temp = from;
+        from = to;
+        to = temp;
+
+        direction = -1;
+    }
+
+    f32 dxdy = (to.x - from.x) / (to.y - from.y);
+
+    i32 y0 = (i32) floorf(from.y);
+    i32 y1 = (i32) ceilf(to.y);
+
+    y0 = y0 < area.y ? area.y : y0;
+    y1 = y1 > area.y + area.h ? area.y + area.h : y1;
+
+    i32 words = (stride + 31) / 32;
+
+    for(i32 y = y0; y < y1; y++) {
+        i32* row = accumulation + (size_t) (y - area.y) * stride;
+        u32* row_touched = touched + (size_t) (y - area.y) * words;
+
+        // Both ends of the row's piece are computed from the segment itself, not stepped from the previous row
+        f32 top = (f32) y > from.y ? (f32) y : from.y;
+        f32 bottom = (f32) (y + 1) < to.y ? (f32) (y + 1) : to.y;
+        f32 x = from.x + (top - from.y) * dxdy;
+        f32 x_next = bottom == to.y ? to.x : from.x + (bottom - from.y) * dxdy;
+
+        i32 d = (i32) floorf((bottom - top) * SILK_PATH_COVERAGE_ONE + 0.5f) * direction;
+
+        if(d == 0) {
+            continue;
+        }
+
+        f32 x0 = x < x_next ? x : x_next;
+        f32 x1 = x < x_next ? x_next : x;
+        f32 x0_floor = floorf(x0);
+        f32 x1_ceil = ceilf(x1);
+        i32 x0i = (i32) x0_floor;
+        i32 x1i = (i32) x1_ceil;
+
+        // The segment stays within one pixel: it's area is decided by the middle point. Otherwise the first and the last
+        // pixel get the triangles, and the ones between them the equal steps.
+        f32 x_middle = 0.5f * (x + x_next) - x0_floor;
+        f32 s = x1 > x0 ? 1.0f / (x1 - x0) : 0.0f;
+        f32 x0_fraction = x0 - x0_floor;
+        f32 x1_fraction = x1 - x1_ceil + 1.0f;
+        f32 area_first = 0.5f * s * (1.0f - x0_fraction) * (1.0f - x0_fraction);
+        f32 area_second = s * (1.5f - x0_fraction);
+        f32 area_last = 0.5f * s * x1_fraction * x1_fraction;
+
+        if(x1i <= x0i + 1) {
+            x1i = x0i + 1;
+        }
+
+        // Every cell gets the difference of the rounded running areas, so the cells always sum up to exactly 'd'
+        i32 first = x0i > area.x ? x0i : area.x;
+        i32 last = x1i < area.x + area.w - 1 ? x1i : area.x + area.w - 1;
+        i32 previous = 0;
+
+        if(x1i < area.x) {
+            first = area.x;
+            last = area.x;
+        }
+
+        for(i32 cell = first; cell <= last; cell++) {
+            f32 fraction = silkPathCellArea(cell, x0i, x1i, x_middle, area_first, area_second, area_last, s);
+            i32 running = (i32) floorf((f32) d * fraction + 0.5f);
+            i32 column = cell - area.x;
+
+            row[column] += running - previous;
+            row_touched[column >> 5] |= 1u << (column & 31);
+
+            previous = running;
+        }
+    }
+
+    return SILK_SUCCESS;
+}
+
+static i32 silkPathPushPoint(silk_path* path, vec2f point) {
+    // NOTE: The negated comparison rejects NaN as well
+    if(!(point.x >= -SILK_RASTER_MAX_COORD && point.x <= SILK_RASTER_MAX_COORD &&
+         point.y >= -SILK_RASTER_MAX_COORD && point.y <= SILK_RASTER_MAX_COORD)) {
+        silkAssignErrorMessage(SILK_ERR_OUT_OF_BOUNDS);
+
+        return SILK_FAILURE;
+    }
+
+    if(path->point_count == path->point_capacity) {
+        i32 capacity = path->point_capacity > 0 ? path->point_capacity * 2 : 64;
+        vec2f* points = (vec2f*) SILK_REALLOC(path->points, (size_t) capacity * sizeof(vec2f));
+
+        if(points == NULL) {
+            silkAssignErrorMessage(SILK_ERR_ALLOCATION_FAIL);
+
+            return SILK_FAILURE;
+        }
+
+        path->points = points;
+        path->point_capacity = capacity;
+    }
+
+    path->points[path->point_count++] = point;
+
+    return SILK_SUCCESS;
+}
+
+static vec2f silkPathCurrentPoint(silk_path* path) {
+    return path->point_count > 0 ? path->points[path->point_count - 1] : (vec2f) { 0.0f, 0.0f };
+}
+
+static i32 silkPathSegmentCount(f32 deviation, f32 degree_factor) {
+    // Wang's formula: 'n' segments keep the flattened curve within the tolerance, where 'deviation' is the largest
+    // second difference of the control points ('degree_factor' is 'd * (d - 1) / 8' of the curve of degree 'd')
+    // Source: https://github.com/linebender/kurbo (Wang's formula, used by the flattening of the cubic curves)
+    f32 n = ceilf(sqrtf(degree_factor * deviation / SILK_PATH_TOLERANCE));
+
+    // NOTE: The negated comparison catches NaN as well
+    if(!(n < SILK_PATH_MAX_SEGMENTS)) {
+        return SILK_PATH_MAX_SEGMENTS;
+    }
+
+    return n < 1.0f ? 1 : (i32) n;
+}
+
+static i32 silkPathNextTouched(const u32* row_touched, i32 x, i32 width) {
+    // First marked cell at or after 'x' (or 'width' if there's none)
+    if(x >= width) {
+        return width;
+    }
+
+    i32 word = x >> 5;
+    u32 bits = row_touched[word] & (~0u << (x & 31));
+
+    while(bits == 0) {
+        word++;
+
+        if(word * 32 >= width) {
+            return width;
+        }
+
+        bits = row_touched[word];
+    }
+
+    x = word * 32 + silkLowestBit(bits);
+
+    return x < width ? x : width;
+}
+
+// Command buffer:
+// While the canvas is recording, every draw call is stored as a single command: it's type, the color, the parameters
+// (exactly as they were passed) and the conservative bounds of the pixels it can touch. Points and strings are copied
+// into the command buffer right after the command, so the caller's memory can be reused as soon as the call returns.
+// Commands are bump-allocated in one growing block (the arena) and replayed by 'silkFlush' through the same API calls,
+// so the replayed frame is exactly the same as the one drawn right away.
+
+#define SILK_COMMAND_CLEAR                          0
+#define SILK_COMMAND_CLEAR_REGION                   1
+#define SILK_COMMAND_PUSH_CLIP                      2
+#define SILK_COMMAND_POP_CLIP                       3
+#define SILK_COMMAND_BLEND_MODE                     4
+#define SILK_COMMAND_PIXEL                          5
+#define SILK_COMMAND_LINE                           6
+#define SILK_COMMAND_LINE_AA                        7
+#define SILK_COMMAND_RECT                           8
+#define SILK_COMMAND_RECT_LINES                     9
+#define SILK_COMMAND_CIRCLE                         10
+#define SILK_COMMAND_CIRCLE_AA                      11
+#define SILK_COMMAND_CIRCLE_LINES                   12
+#define SILK_COMMAND_ELLIPSE                        13
+#define SILK_COMMAND_TRIANGLE                       14
+#define SILK_COMMAND_TRIANGLE_FLOAT                 15
+#define SILK_COMMAND_TRIANGLE_FIXED                 16
+#define SILK_COMMAND_TRIANGLE_LINES                 17
+#define SILK_COMMAND_TRIANGLE_EQUILATERAL           18
+#define SILK_COMMAND_TRIANGLE_EQUILATERAL_LINES     19
+#define SILK_COMMAND_POLYGON                        20
+#define SILK_COMMAND_POLYGON_POINTS                 21
+#define SILK_COMMAND_STAR                           22
+#define SILK_COMMAND_IMAGE                          23
+#define SILK_COMMAND_TEXT                           24
+#define SILK_COMMAND_PATH                           25
+#define SILK_COMMAND_TEXT_FONT                      26
+#define SILK_COMMAND_TEXT_SDF                       27
+#define SILK_COMMAND_TEXT_LAYOUT                    28
+
+#define SILK_COMMAND_ALIGNMENT 8                // Every command starts at a multiple of this (in bytes)
+#define SILK_COMMAND_UNBOUNDED (1 << 29)        // Bounds of the commands that can touch any pixel
+
+typedef struct {
+    i32 type;           // SILK_COMMAND_*
+    i32 size;           // Size of the command with it's payload (in bytes)
+    silk_rect bounds;   // Pixels the command can touch (commands outside of the clip rectangle are skipped)
+    pixel pix;
+
+    union {
+        struct { vec2i a; vec2i b; vec2i c; } points;                       // Pixels, lines and triangles
+        struct { vec2f a; vec2f b; vec2f c; } points_float;                 // Anti-aliased lines and triangles with the float points
+        struct { vec2i position; vec2i size; vec2i offset; i32 angle; } rect;
+        struct { vec2i position; vec2i radius; i32 angle; i32 n; } shape;   // Circles, ellipses, equilateral triangles, polygons and stars
+        struct { vec2f position; f32 radius; } circle;
+        struct { image* img; vec2i position; vec2i offset; vec2i size; pixel tint; } image;
+        struct { const silk_bitmap_font* font; vec2i position; i32 font_size; i32 font_spacing; } text;  // Payload: the string
+        struct { silk_font* font; vec2i position; i32 font_size; } text_font;                       // Payload: the string
+        struct { const silk_sdf_font* font; vec2f position; f32 font_size; } text_sdf;              // Payload: the string
+        struct { const silk_bitmap_font* font; vec2i position; vec2i size; i32 font_size; i32 count; } text_layout;  // Payload: the glyphs
+        struct { i32 count; i32 contour_count; i32 fill_rule; } polygon;   // Payload: the points (and the contours, for the paths)
+        silk_rect clip;
+        vec2i region;
+        i32 blend_mode;
+    } args;
+} silk_command;
+
+static void* silkCommandPayload(silk_command* command) {
+    return (u8*) command + sizeof(silk_command);
+}
+
+static silk_command silkCommandInit(i32 type, pixel pix) {
+    // Arguments are assigned one by one by the caller (C++ has no nested designated initializers)
+    silk_command command = { 0 };
+    command.type = type;
+    command.pix = pix;
+
+    return command;
+}
+
+static silk_rect silkCommandBoundsFromCorners(i64 x0, i64 y0, i64 x1, i64 y1) {
+    // Half-open corners, clamped so the width and the height still fit into 'i32'
+    x0 = x0 < -SILK_COMMAND_UNBOUNDED ? -SILK_COMMAND_UNBOUNDED : (x0 > SILK_COMMAND_UNBOUNDED ? SILK_COMMAND_UNBOUNDED : x0);
+    y0 = y0 < -SILK_COMMAND_UNBOUNDED ? -SILK_COMMAND_UNBOUNDED : (y0 > SILK_COMMAND_UNBOUNDED ? SILK_COMMAND_UNBOUNDED : y0);
+    x1 = x1 < -SILK_COMMAND_UNBOUNDED ? -SILK_COMMAND_UNBOUNDED : (x1 > SILK_COMMAND_UNBOUNDED ? SILK_COMMAND_UNBOUNDED : x1);
+    y1 = y1 < -SILK_COMMAND_UNBOUNDED ? -SILK_COMMAND_UNBOUNDED : (y1 > SILK_COMMAND_UNBOUNDED ? SILK_COMMAND_UNBOUNDED : y1);
+
+    return (silk_rect) { (i32) x0, (i32) y0, x1 > x0 ? (i32) (x1 - x0) : 0, y1 > y0 ? (i32) (y1 - y0) : 0 };
+}
+
+static silk_rect silkCommandBoundsFromPoints(const vec2f* points, i32 count, f32 margin) {
+    f32 min_x = (f32) SILK_COMMAND_UNBOUNDED;
+    f32 min_y = (f32) SILK_COMMAND_UNBOUNDED;
+    f32 max_x = (f32) -SILK_COMMAND_UNBOUNDED;
+    f32 max_y = (f32) -SILK_COMMAND_UNBOUNDED;
+
+    for(i32 i = 0; i < count; i++) {
+        // NOTE: NaN fails both comparisons, so it can't shrink the bounds (such a command is rejected on the replay anyway)
+        min_x = points[i].x < min_x ? points[i].x : min_x;
+        min_y = points[i].y < min_y ? points[i].y : min_y;
+        max_x = points[i].x > max_x ? points[i].x : max_x;
+        max_y = points[i].y > max_y ? points[i].y : max_y;
+    }
+
+    if(count == 0) {
+        return (silk_rect) { 0 };
+    }
+
+    return silkCommandBoundsFromCorners(
+        (i64) floorf(min_x - margin),
+        (i64) floorf(min_y - margin),
+        (i64) ceilf(max_x + margin) + 1,
+        (i64) ceilf(max_y + margin) + 1
+    );
+}
+
+static silk_rect silkCommandBounds(silk_command* command) {
+    const silk_rect unbounded = { -SILK_COMMAND_UNBOUNDED, -SILK_COMMAND_UNBOUNDED, 2 * SILK_COMMAND_UNBOUNDED, 2 * SILK_COMMAND_UNBOUNDED };
+
+    switch(command->type) {
+        case SILK_COMMAND_PIXEL:
+        case SILK_COMMAND_LINE:
+        case SILK_COMMAND_TRIANGLE:
+        case SILK_COMMAND_TRIANGLE_LINES: {
+            vec2f points[3] = {
+                { (f32) command->args.points.a.x, (f32) command->args.points.a.y },
+                { (f32) command->args.points.b.x, (f32) command->args.points.b.y },
+                { (f32) command->args.points.c.x, (f32) command->args.points.c.y }
+            };
+
+            // Pixels and lines only use the first one or two points
+            i32 count = command->type == SILK_COMMAND_PIXEL ? 1 : (command->type == SILK_COMMAND_LINE ? 2 : 3);
+
+            return silkCommandBoundsFromPoints(points, count, 0.0f);
+        }
+
+        case SILK_COMMAND_TRIANGLE_FIXED: {
+            vec2f points[3] = {
+                { command->args.points.a.x / (f32) SILK_SUBPIXEL_ONE, command->args.points.a.y / (f32) SILK_SUBPIXEL_ONE },
+                { command->args.points.b.x / (f32) SILK_SUBPIXEL_ONE, command->args.points.b.y / (f32) SILK_SUBPIXEL_ONE },
+                { command->args.points.c.x / (f32) SILK_SUBPIXEL_ONE, command->args.points.c.y / (f32) SILK_SUBPIXEL_ONE }
+            };
+
+            return silkCommandBoundsFromPoints(points, 3, 1.0f);
+        }
+
+        case SILK_COMMAND_LINE_AA:
+        case SILK_COMMAND_TRIANGLE_FLOAT: {
+            vec2f points[3] = { command->args.points_float.a, command->args.points_float.b, command->args.points_float.c };
+
+            return silkCommandBoundsFromPoints(points, command->type == SILK_COMMAND_LINE_AA ? 2 : 3, 1.0f);
+        }
+
+        case SILK_COMMAND_RECT:
+        case SILK_COMMAND_RECT_LINES: {
+            vec2i position = command->args.rect.position;
+            vec2i size = command->args.rect.size;
+            vec2i offset = command->args.rect.offset;
+
+            if(command->type == SILK_COMMAND_RECT && command->args.rect.angle == 0) {
+                return silkCommandBoundsFromCorners(
+                    (i64) position.x - offset.x,
+                    (i64) position.y - offset.y,
+                    (i64) position.x - offset.x + size.x,
+                    (i64) position.y - offset.y + size.y
+                );
+            }
+
+            // Rotated corners are never further from the position than the sum of the offset and the size
+            i64 reach = llabs((i64) offset.x) + llabs((i64) offset.y) + llabs((i64) size.x) + llabs((i64) size.y) + 1;
+
+            return silkCommandBoundsFromCorners(position.x - reach, position.y - reach, position.x + reach + 1, position.y + reach + 1);
+        }
+
+        case SILK_COMMAND_CIRCLE:
+        case SILK_COMMAND_CIRCLE_LINES:
+        case SILK_COMMAND_ELLIPSE:
+        case SILK_COMMAND_TRIANGLE_EQUILATERAL:
+        case SILK_COMMAND_TRIANGLE_EQUILATERAL_LINES:
+        case SILK_COMMAND_POLYGON:
+        case SILK_COMMAND_STAR: {
+            vec2i position = command->args.shape.position;
+            i64 reach_x = llabs((i64) command->args.shape.radius.x) + 1;
+            i64 reach_y = llabs((i64) command->args.shape.radius.y) + 1;
+
+            return silkCommandBoundsFromCorners(position.x - reach_x, position.y - reach_y, position.x + reach_x + 1, position.y + reach_y + 1);
+        }
+
+        case SILK_COMMAND_CIRCLE_AA: {
+            vec2f position = command->args.circle.position;
+            f32 radius = command->args.circle.radius;
+            vec2f points[2] = { { position.x - radius, position.y - radius }, { position.x + radius, position.y + radius } };
+
+            return silkCommandBoundsFromPoints(points, 2, 1.0f);
+        }
+
+        case SILK_COMMAND_IMAGE: {
+            vec2i origin = {
+                command->args.image.position.x - command->args.image.offset.x,
+                command->args.image.position.y - command->args.image.offset.y
+            };
+
+            return silkCommandBoundsFromCorners(
+                origin.x, origin.y,
+                (i64) origin.x + command->args.image.size.x, (i64) origin.y + command->args.image.size.y
+            );
+        }
+
+        case SILK_COMMAND_TEXT: {
+            i32 font_size = command->args.text.font_size;
+
+            if(font_size <= 0 || command->args.text.font_spacing < 0) {
+                return unbounded;
+            }
+
+            // Glyphs are snapped to the multiples of the font size, so they can start up to one font size before the position
+            vec2i position = command->args.text.position;
+            vec2i size = silkMeasureTextBitmap(command->args.text.font, (const char*) silkCommandPayload(command), font_size, command->args.text.font_spacing);
+
+            return silkCommandBoundsFromCorners(
+                (i64) position.x - font_size,
+                (i64) position.y - font_size,
+                (i64) position.x + size.x + font_size,
+                (i64) position.y + size.y + font_size
+            );
+        }
+
+        case SILK_COMMAND_TEXT_FONT: {
+            i32 font_size = command->args.text_font.font_size;
+
+            if(font_size <= 0) {
+                return unbounded;
+            }
+
+            // Glyphs can reach a bit out of the measured lines (bearings, accents), so every side gets one more font size
+            vec2i position = command->args.text_font.position;
+            vec2i size = silkMeasureTextFont(command->args.text_font.font, (const char*) silkCommandPayload(command), font_size);
+
+            return silkCommandBoundsFromCorners(
+                (i64) position.x - font_size,
+                (i64) position.y - font_size,
+                (i64) position.x + size.x + font_size,
+                (i64) position.y + size.y + font_size
+            );
+        }
+
+        case SILK_COMMAND_TEXT_LAYOUT: {
+            // Laid out glyphs never leave the size of their layout
+            vec2i position = command->args.text_layout.position;
+            vec2i size = command->args.text_layout.size;
+
+            return silkCommandBoundsFromCorners(position.x, position.y, (i64) position.x + size.x, (i64) position.y + size.y);
+        }
+
+        case SILK_COMMAND_TEXT_SDF: {
+            const silk_sdf_font* font = command->args.text_sdf.font;
+            f32 font_size = command->args.text_sdf.font_size;
+
+            if(font == NULL || !(font_size > 0.0f) || !(font->em > 0.0f)) {
+                return unbounded;
+            }
+
+            // Same as above: one more em on every side, plus the spread of the distance fields
+            vec2f position = command->args.text_sdf.position;
+            vec2f size = silkMeasureTextSDF(font, (const char*) silkCommandPayload(command), font_size);
+            vec2f corners[2] = { position, { position.x + size.x, position.y + size.y } };
+
+            return silkCommandBoundsFromPoints(corners, 2, font_size * (1.0f + SILK_SDF_SPREAD / font->em) + 1.0f);
+        }
+
+        case SILK_COMMAND_POLYGON_POINTS:
+        case SILK_COMMAND_PATH: {
+            return silkCommandBoundsFromPoints((const vec2f*) silkCommandPayload(command), command->args.polygon.count, 1.0f);
+        }
+
+        default: {
+            return unbounded;
+        }
+    }
+}
+
+static i32 silkRecordCommand(silk_canvas* canvas, silk_command command, const void* payload, i64 payload_size, const void* extra, i64 extra_size) {
+    silk_command_buffer* commands = canvas->recording;
+
+    i64 size = (i64) sizeof(silk_command) + payload_size + extra_size;
+    size = (size + SILK_COMMAND_ALIGNMENT - 1) & ~(i64) (SILK_COMMAND_ALIGNMENT - 1);
+
+    if(size > INT32_MAX) {
+        silkAssignErrorMessage(SILK_ERR_OUT_OF_BOUNDS);
+
+        return SILK_FAILURE;
+    }
+
+    // Arena grows by doubling, so recording the commands is amortized O(1)
+    if(commands->size + size > commands->capacity) {
+        i64 capacity = commands->capacity > 0 ? commands->capacity : 4096;
+
+        while(capacity < commands->size + size) {
+            capacity *= 2;
+        }
+
+        u8* data = (u8*) SILK_REALLOC(commands->data, (size_t) capacity);
+
+        if(data == NULL) {
+            silkAssignErrorMessage(SILK_ERR_ALLOCATION_FAIL);
+
+            return SILK_FAILURE;
+        }
+
+        commands->data = data;
+        commands->capacity = capacity;
+    }
+
+    silk_command* result = (silk_command*) (commands->data + commands->size);
+    *result = command;
+    result->size = (i32) size;
+
+    if(payload_size > 0) {
+        memcpy(silkCommandPayload(result), payload, (size_t) payload_size);
+    }
+
+    if(extra_size > 0) {
+        memcpy((u8*) silkCommandPayload(result) + payload_size, extra, (size_t) extra_size);
+    }
+
+    result->bounds = silkCommandBounds(result);
+
+    commands->size += size;
+    commands->count++;
+
+    return SILK_SUCCESS;
+}
+
+static i32 silkReplayCommand(silk_canvas* canvas, silk_command* command) {
+    // Draw commands outside of the clip rectangle are skipped without any setup (unless they're only being re-recorded).
+    // Clears, the clip rectangles and the blend modes change the state, so they're always replayed.
+    if(canvas->recording == NULL && command->type >= SILK_COMMAND_PIXEL) {
+        silk_rect visible = silkRectIntersect(silkCanvasClip(canvas), command->bounds);
+
+        if(visible.w <= 0 || visible.h <= 0) {
+            return SILK_SUCCESS;
+        }
+    }
+
+    switch(command->type) {
+        case SILK_COMMAND_CLEAR: return silkClearPixelBufferColor(canvas, command->pix);
+        case SILK_COMMAND_CLEAR_REGION: return silkClearPixelBufferColorRegion(canvas, command->args.region, command->pix);
+        case SILK_COMMAND_PUSH_CLIP: return silkPushClipRect(canvas, command->args.clip);
+        case SILK_COMMAND_POP_CLIP: return silkPopClipRect(canvas);
+        case SILK_COMMAND_BLEND_MODE: return silkSetBlendMode(canvas, command->args.blend_mode);
+        case SILK_COMMAND_PIXEL: return silkDrawPixel(canvas, command->args.points.a, command->pix);
+        case SILK_COMMAND_LINE: return silkDrawLine(canvas, command->args.points.a, command->args.points.b, command->pix);
+        case SILK_COMMAND_LINE_AA: return silkDrawLineAA(canvas, command->args.points_float.a, command->args.points_float.b, command->pix);
+        case SILK_COMMAND_RECT: return silkDrawRectPro(canvas, command->args.rect.position, command->args.rect.size, command->args.rect.angle, command->args.rect.offset, command->pix);
+        case SILK_COMMAND_RECT_LINES: return silkDrawRectLines(canvas, command->args.rect.position, command->args.rect.size, command->args.rect.angle, command->args.rect.offset, command->pix);
+        case SILK_COMMAND_CIRCLE: return silkDrawCircle(canvas, command->args.shape.position, command->args.shape.radius.x, command->pix);
+        case SILK_COMMAND_CIRCLE_AA: return silkDrawCircleAA(canvas, command->args.circle.position, command->args.circle.radius, command->pix);
+        case SILK_COMMAND_CIRCLE_LINES: return silkDrawCircleLines(canvas, command->args.shape.position, command->args.shape.radius.x, command->pix);
+        case SILK_COMMAND_ELLIPSE: return silkDrawEllipse(canvas, command->args.shape.position, command->args.shape.radius, command->pix);
+        case SILK_COMMAND_TRIANGLE: return silkDrawTriangle(canvas, command->args.points.a, command->args.points.b, command->args.points.c, command->pix);
+        case SILK_COMMAND_TRIANGLE_FLOAT: return silkDrawTriangleFloat(canvas, command->args.points_float.a, command->args.points_float.b, command->args.points_float.c, command->pix);
+        case SILK_COMMAND_TRIANGLE_FIXED: return silkDrawTriangleFixed(canvas, command->args.points.a, command->args.points.b, command->args.points.c, command->pix);
+        case SILK_COMMAND_TRIANGLE_LINES: return silkDrawTriangleLines(canvas, command->args.points.a, command->args.points.b, command->args.points.c, command->pix);
+        case SILK_COMMAND_TRIANGLE_EQUILATERAL: return silkDrawTriangleEquilateral(canvas, command->args.shape.position, command->args.shape.radius.x, command->args.shape.angle, command->pix);
+        case SILK_COMMAND_TRIANGLE_EQUILATERAL_LINES: return silkDrawTriangleEquilateralLines(canvas, command->args.shape.position, command->args.shape.radius.x, command->args.shape.angle, command->pix);
+        case SILK_COMMAND_POLYGON: return silkDrawPolygon(canvas, command->args.shape.position, command->args.shape.radius.x, command->args.shape.angle, command->args.shape.n, command->pix);
+        case SILK_COMMAND_POLYGON_POINTS: return silkDrawPolygonPoints(canvas, (const vec2f*) silkCommandPayload(command), command->args.polygon.count, command->args.polygon.fill_rule, command->pix);
+        case SILK_COMMAND_STAR: return silkDrawStar(canvas, command->args.shape.position, command->args.shape.radius.x, command->args.shape.angle, command->args.shape.n, command->pix);
+        case SILK_COMMAND_IMAGE: return silkDrawImagePro(canvas, command->args.image.img, command->args.image.position, command->args.image.offset, command->args.image.size, command->args.image.tint);
+        case SILK_COMMAND_TEXT: return silkDrawTextBitmap(canvas, command->args.text.font, (const char*) silkCommandPayload(command), command->args.text.position, command->args.text.font_size, command->args.text.font_spacing, command->pix);
+        case SILK_COMMAND_TEXT_FONT: return silkDrawTextFont(canvas, command->args.text_font.font, (const char*) silkCommandPayload(command), command->args.text_font.position, command->args.text_font.font_size, command->pix);
+        case SILK_COMMAND_TEXT_SDF: return silkDrawTextSDF(canvas, command->args.text_sdf.font, (const char*) silkCommandPayload(command), command->args.text_sdf.position, command->args.text_sdf.font_size, command->pix);
+
+        case SILK_COMMAND_TEXT_LAYOUT: {
+            // Layout is rebuilt around the recorded glyphs, without copying them
+            silk_text_layout layout = {
+                command->args.text_layout.font,
+                command->args.text_layout.font_size,
+                0,
+                (const silk_text_glyph*) silkCommandPayload(command),
+                command->args.text_layout.count,
+                0,
+                command->args.text_layout.size
+            };
+
+            return silkDrawTextLayout(canvas, &layout, command->args.text_layout.position, command->pix);
+        }
+
+        case SILK_COMMAND_PATH: {
+            // Path is rebuilt around the recorded points, without copying them
+            silk_path path = { 0 };
+            path.points = (vec2f*) silkCommandPayload(command);
+            path.point_count = command->args.polygon.count;
+            path.point_capacity = command->args.polygon.count;
+            path.contours = (i32*) ((u8*) silkCommandPayload(command) + (size_t) command->args.polygon.count * sizeof(vec2f));
+            path.contour_count = command->args.polygon.contour_count;
+            path.contour_capacity = command->args.polygon.contour_count;
+
+            return silkDrawPath(canvas, &path, command->args.polygon.fill_rule, command->pix);
+        }
+
+        default: {
+            silkAssignErrorMessage(SILK_ERR_UNDEFINE_BEHAVIOUR);
+
+            return SILK_FAILURE;
+        }
+    }
+}
+
+// Tile renderer:
+// Sort-middle: the multithreaded 'silkFlush' bins every recorded command into the screen tiles it's bounds overlap
+// (clears and the clip rectangles go to every tile), and then the tiles are rendered independently, each one by a single
+// thread replaying it's own commands in the recorded order, clipped to the tile. Tiles don't share any pixels, so there
+// are no locks around the canvas, and every pixel sees the same commands in the same order as in the serial replay.
+// Every primitive computes it's pixels the same way no matter how it's clipped, so the frame is bit-exact with any number of the threads.
+//
+// Tiles are split into the equal contiguous ranges, one per thread. Thread takes the tiles from the front of it's own range,
+// and after that it steals the remaining ones from the back of the other ranges. Range is a single 64-bit word ([begin, end)),
+// so both of it's ends are moved with one compare-and-swap.
+// Source: https://en.wikipedia.org/wiki/Work_stealing
+
+#if defined(SILK_THREADS_ENABLE)
+
+typedef struct {
+    silk_canvas* canvas;
+    silk_command** commands;                // Recorded commands, in order
+    u32* bin_offsets;                       // First entry of every tile in 'bins' ('tile_count + 1' entries)
+    u32* bins;                              // Indices of the commands overlapping every tile, in order
+    silk_rect* damage;                      // Bounds of the pixels changed in every tile (empty: nothing changed)
+    vec2i tiles;                            // Number of the tiles, horizontally and vertically
+    i32 thread_count;
+    volatile u64 ranges[SILK_MAX_THREADS];  // Tiles left for every thread: '(end << 32) | begin'
+    i32 result;                             // Written under the pool's lock
+} silk_tile_job;
+
+typedef struct {
+    silk_thread threads[SILK_MAX_THREADS];
+    i32 worker_count;           // Running threads (the calling one excluded)
+    silk_mutex mutex;
+    silk_condition wake;        // New job, or the shutdown
+    silk_condition done;        // Last worker finished the job
+    u32 generation;             // Incremented with every job
+    i32 busy;                   // Workers still rendering the current job
+    bool quit;
+    silk_tile_job* job;
+} silk_thread_pool;
+
+static silk_thread_pool silk_pool = { .mutex = SILK_MUTEX_INIT, .wake = SILK_CONDITION_INIT, .done = SILK_CONDITION_INIT };
+
+static i32 silkTileRangePopFront(volatile u64* range) {
+    for(;;) {
+        u64 value = silkAtomicLoad64(range);
+        u32 begin = (u32) value;
+        u32 end = (u32) (value >> 32);
+
+        if(begin >= end) {
+            return -1;
+        }
+
+        if(silkAtomicCompareExchange64(range, value, ((u64) end << 32) | (begin + 1))) {
+            return (i32) begin;
+        }
+    }
+}
+
+static i32 silkTileRangePopBack(volatile u64* range) {
+    for(;;) {
+        u64 value = silkAtomicLoad64(range);
+        u32 begin = (u32) value;
+        u32 end = (u32) (value >> 32);
+
+        if(begin >= end) {
+            return -1;
+        }
+
+        if(silkAtomicCompareExchange64(range, value, ((u64) (end - 1) << 32) | begin)) {
+            return (i32) (end - 1);
+        }
+    }
+}
+
+static i32 silkRenderTile(silk_tile_job* job, i32 tile) {
+    silk_canvas* canvas = job->canvas;
+    silk_rect area = silkRectIntersect(
+        (silk_rect) { (tile % job->tiles.x) * SILK_TILE_SIZE, (tile / job->tiles.x) * SILK_TILE_SIZE, SILK_TILE_SIZE, SILK_TILE_SIZE },
+        (silk_rect) { 0, 0, canvas->size.x, canvas->size.y }
+    );
+
+    // Tile is drawn through a copy of the canvas, with every clip rectangle shrunk to the tile.
+    // The tile itself stays at the bottom of the stack, so the copy holds 'max(depth, 1)' rectangles ('depth': the serial stack).
+    silk_canvas tile_canvas = *canvas;
+    tile_canvas.dirty_count = 0;
+    i32 depth = canvas->clip_count;
+
+    for(i32 i = 0; i < depth; i++) {
+        tile_canvas.clip_stack[i] = silkRectIntersect(canvas->clip_stack[i], area);
+    }
+
+    if(depth == 0) {
+        tile_canvas.clip_stack[0] = area;
+        tile_canvas.clip_count = 1;
+    }
+
+    i32 result = SILK_SUCCESS;
+
+    for(u32 i = job->bin_offsets[tile]; i < job->bin_offsets[tile + 1]; i++) {
+        silk_command* command = job->commands[job->bins[i]];
+
+        switch(command->type) {
+            // Clears ignore the clip rectangles, so they're cut to the tile right here
+            case SILK_COMMAND_CLEAR:
+            case SILK_COMMAND_CLEAR_REGION: {
+                vec2i region = command->type == SILK_COMMAND_CLEAR ? canvas->size : command->args.region;
+                silk_rect fill = silkRectIntersect(area, (silk_rect) { 0, 0, region.x, region.y });
+                silkMarkDirty(&tile_canvas, fill);
+
+                for(i32 y = fill.y; y < fill.y + fill.h; y++) {
+                    silkFillFormat(canvas->format, silkCanvasAddress(canvas, fill.x, y), fill.w, command->pix, false);
+                }
+            } break;
+
+            // Clip rectangles overflowing (or underflowing) the serial stack are skipped here, and reported by 'silkFlush'
+            case SILK_COMMAND_PUSH_CLIP: {
+                if(depth >= SILK_CLIP_STACK_SIZE) {
+                    break;
+                }
+
+                if(depth == 0) {
+                    tile_canvas.clip_count = 0;
+                }
+
+                silkPushClipRect(&tile_canvas, command->args.clip);
+                tile_canvas.clip_stack[tile_canvas.clip_count - 1] = silkRectIntersect(tile_canvas.clip_stack[tile_canvas.clip_count - 1], area);
+                depth++;
+            } break;
+
+            case SILK_COMMAND_POP_CLIP: {
+                if(depth <= 0) {
+                    break;
+                }
+
+                depth--;
+
+                if(depth == 0) {
+                    tile_canvas.clip_stack[0] = area;
+                } else {
+                    tile_canvas.clip_count--;
+                }
+            } break;
+
+            default: {
+                if(silkReplayCommand(&tile_canvas, command) != SILK_SUCCESS) {
+                    result = SILK_FAILURE;
+                }
+            } break;
+        }
+    }
+
+    // Damage of the copy would be lost, so it's handed back to 'silkFlushTiles' (every tile has it's own slot, no locking)
+    silk_rect damage = { 0 };
+
+    for(i32 i = 0; i < tile_canvas.dirty_count; i++) {
+        damage = i == 0 ? tile_canvas.dirty_rects[i] : silkRectUnion(damage, tile_canvas.dirty_rects[i]);
+    }
+
+    job->damage[tile] = damage;
+
+    return result;
+}
+
+static i32 silkRenderTiles(silk_tile_job* job, i32 thread) {
+    i32 result = SILK_SUCCESS;
+    i32 tile;
+
+    // Own tiles first, front to back...
+    while((tile = silkTileRangePopFront(&job->ranges[thread])) >= 0) {
+        if(silkRenderTile(job, tile) != SILK_SUCCESS) {
+            result = SILK_FAILURE;
+        }
+    }
+
+    // ...and then the ones the other threads haven't reached yet, from the back (no new tiles show up, so one pass is enough)
+    for(i32 i = 1; i < job->thread_count; i++) {
+        volatile u64* victim = &job->ranges[(thread + i) % job->thread_count];
+
+        while((tile = silkTileRangePopBack(victim)) >= 0) {
+            if(silkRenderTile(job, tile) != SILK_SUCCESS) {
+                result = SILK_FAILURE;
+            }
+        }
+    }
+
+    return result;
+}
+
+static void silkThreadLoop(i32 thread) {
+    // Threads are only started while the pool is idle (with the generation reset to 0), so no job can be missed
+    u32 generation = 0;
+
+    for(;;) {
+        silkMutexLock(&silk_pool.mutex);
+
+        while(!silk_pool.quit && silk_pool.generation == generation) {
+            silkConditionWait(&silk_pool.wake, &silk_pool.mutex);
+        }
+
+        if(silk_pool.quit) {
+            silkMutexUnlock(&silk_pool.mutex);
+
+            return;
+        }
+
+        generation = silk_pool.generation;
+        silk_tile_job* job = silk_pool.job;
+
+        silkMutexUnlock(&silk_pool.mutex);
+
+        i32 result = silkRenderTiles(job, thread);
+
+        silkMutexLock(&silk_pool.mutex);
+
+        if(result != SILK_SUCCESS) {
+            job->result = SILK_FAILURE;
+        }
+
+        silk_pool.busy--;
+
+        if(silk_pool.busy == 0) {
+            silkConditionBroadcast(&silk_pool.done);
+        }
+
+        silkMutexUnlock(&silk_pool.mutex);
+    }
+}
+
+#if defined(_WIN32)
+
+static DWORD WINAPI silkThreadEntry(LPVOID arg) {
+    silkThreadLoop((i32) (intptr_t) arg);
+
+    return 0;
+}
+
+#else
+
+static void* silkThreadEntry(void* arg) {
+    silkThreadLoop((i32) (intptr_t) arg);
+
+    return NULL;
+}
+
+#endif // _WIN32
+
+static i32 silkStopThreads(void) {
+    silkMutexLock(&silk_pool.mutex);
+    silk_pool.quit = true;
+    silkConditionBroadcast(&silk_pool.wake);
+    silkMutexUnlock(&silk_pool.mutex);
+
+    for(i32 i = 0; i < silk_pool.worker_count; i++) {
+        silkThreadJoin(silk_pool.threads[i]);
+    }
+
+    silk_pool.worker_count = 0;
+    silk_pool.generation = 0;
+    silk_pool.quit = false;
+
+    return SILK_SUCCESS;
+}
+
+static i32 silkFlushTiles(silk_canvas* canvas, silk_command_buffer* commands) {
+    silk_tile_job job = { 0 };
+    job.canvas = canvas;
+    job.tiles = (vec2i) { (canvas->size.x + SILK_TILE_SIZE - 1) / SILK_TILE_SIZE, (canvas->size.y + SILK_TILE_SIZE - 1) / SILK_TILE_SIZE };
+    job.thread_count = silk_pool.worker_count + 1;
+
+    i32 tile_count = job.tiles.x * job.tiles.y;
+    silk_rect canvas_area = { 0, 0, canvas->size.x, canvas->size.y };
+
+    job.commands = (silk_command**) SILK_MALLOC(
+        (size_t) commands->count * sizeof(silk_command*) + (size_t) tile_count * sizeof(silk_rect) + (size_t) (tile_count + 1) * sizeof(u32)
+    );
+
+    if(job.commands == NULL) {
+        silkAssignErrorMessage(SILK_ERR_ALLOCATION_FAIL);
+
+        return SILK_FAILURE;
+    }
+
+    job.damage = (silk_rect*) (job.commands + commands->count);
+    job.bin_offsets = (u32*) (job.damage + tile_count);
+    memset(job.bin_offsets, 0, (size_t) (tile_count + 1) * sizeof(u32));
+
+    // First pass: commands per tile (counted one slot ahead, so the prefix sum leaves the first entry of every tile)...
+    i64 offset = 0;
+
+    for(i32 i = 0; i < commands->count; i++) {
+        silk_command* command = (silk_command*) (commands->data + offset);
+        job.commands[i] = command;
+        offset += command->size;
+
+        if(command->type < SILK_COMMAND_PIXEL) {
+            for(i32 tile = 0; tile < tile_count; tile++) {
+                job.bin_offsets[tile + 1]++;
+            }
+
+            continue;
+        }
+
+        silk_rect visible = silkRectIntersect(command->bounds, canvas_area);
+
+        if(visible.w <= 0 || visible.h <= 0) {
+            continue;
+        }
+
+        for(i32 y = visible.y / SILK_TILE_SIZE; y <= (visible.y + visible.h - 1) / SILK_TILE_SIZE; y++) {
+            for(i32 x = visible.x / SILK_TILE_SIZE; x <= (visible.x + visible.w - 1) / SILK_TILE_SIZE; x++) {
+                job.bin_offsets[y * job.tiles.x + x + 1]++;
+            }
+        }
+    }
+
+    for(i32 tile = 0; tile < tile_count; tile++) {
+        job.bin_offsets[tile + 1] += job.bin_offsets[tile];
+    }
+
+    job.bins = (u32*) SILK_MALLOC((size_t) job.bin_offsets[tile_count] * sizeof(u32) + sizeof(u32));
+
+    if(job.bins == NULL) {
+        SILK_FREE(job.commands);
+        silkAssignErrorMessage(SILK_ERR_ALLOCATION_FAIL);
+
+        return SILK_FAILURE;
+    }
+
+    // ...second pass: the command indices, in order (the offsets are moved to the next tile on the way, and then moved back)
+    for(i32 i = 0; i < commands->count; i++) {
+        silk_command* command = job.commands[i];
+
+        if(command->type < SILK_COMMAND_PIXEL) {
+            for(i32 tile = 0; tile < tile_count; tile++) {
+                job.bins[job.bin_offsets[tile]++] = (u32) i;
+            }
+
+            continue;
+        }
+
+        silk_rect visible = silkRectIntersect(command->bounds, canvas_area);
+
+        if(visible.w <= 0 || visible.h <= 0) {
+            continue;
+        }
+
+        for(i32 y = visible.y / SILK_TILE_SIZE; y <= (visible.y + visible.h - 1) / SILK_TILE_SIZE; y++) {
+            for(i32 x = visible.x / SILK_TILE_SIZE; x <= (visible.x + visible.w - 1) / SILK_TILE_SIZE; x++) {
+                i32 tile = y * job.tiles.x + x;
+                job.bins[job.bin_offsets[tile]++] = (u32) i;
+            }
+        }
+    }
+
+    for(i32 tile = tile_count; tile > 0; tile--) {
+        job.bin_offsets[tile] = job.bin_offsets[tile - 1];
+    }
+
+    job.bin_offsets[0] = 0;
+
+    for(i32 i = 0; i < job.thread_count; i++) {
+        u64 begin = (u64) ((i64) tile_count * i / job.thread_count);
+        u64 end = (u64) ((i64) tile_count * (i + 1) / job.thread_count);
+
+        job.ranges[i] = (end << 32) | begin;
+    }
+
+    // Kernel table is filled on the first use, so it's done here, before the workers start
+    silkGetKernels();
+
+    silkMutexLock(&silk_pool.mutex);
+    silk_pool.job = &job;
+    silk_pool.busy = silk_pool.worker_count;
+    silk_pool.generation++;
+    silkConditionBroadcast(&silk_pool.wake);
+    silkMutexUnlock(&silk_pool.mutex);
+
+    // Calling thread is the worker number 0
+    i32 result = silkRenderTiles(&job, 0);
+
+    silkMutexLock(&silk_pool.mutex);
+
+    while(silk_pool.busy > 0) {
+        silkConditionWait(&silk_pool.done, &silk_pool.mutex);
+    }
+
+    if(job.result != SILK_SUCCESS) {
+        result = SILK_FAILURE;
+    }
+
+    silkMutexUnlock(&silk_pool.mutex);
+
+    for(i32 tile = 0; tile < tile_count; tile++) {
+        silkMarkDirty(canvas, job.damage[tile]);
+    }
+
+    // Tiles only worked on the copies of the clip stack (and the blend mode), so the canvas gets it's final state (and the stack errors) here
+    for(i32 i = 0; i < commands->count; i++) {
+        silk_command* command = job.commands[i];
+
+        if(command->type == SILK_COMMAND_PUSH_CLIP || command->type == SILK_COMMAND_POP_CLIP || command->type == SILK_COMMAND_BLEND_MODE) {
+            if(silkReplayCommand(canvas, command) != SILK_SUCCESS) {
+                result = SILK_FAILURE;
+            }
+        }
+    }
+
+    SILK_FREE(job.bins);
+    SILK_FREE(job.commands);
+
+    return result;
+}
+
+#endif // SILK_THREADS_ENABLE
+
+// Lines:
+// Aliased lines are walked with the integer Bresenham algorithm, from 'start' to 'end' (both inclusive).
+// The minor coordinate of the step 'i' is 'round(i * minor_len / major_len)' (halves rounded up), which can also be
+// computed directly; thanks to that a clipped line jumps straight to it's first visible step and stops at the last one,
+// instead of walking (and testing) all the invisible pixels. Shallow lines are written as horizontal spans.
+
+typedef struct {
+    i32 major_start;    // first pixel, along the major axis (the one the line advances by 1 pixel every step)...
+    i32 minor_start;    // ...and along the minor axis
+    i32 major_sign;     // direction of the steps (-1 or 1)
+    i32 minor_sign;
+    i64 major_len;      // number of steps
+    i64 minor_len;      // number of the minor axis steps
+    i64 first;          // first and last visible step
+    i64 last;
+} silk_line;
+
+static bool silkLineClipAxis(i32 start, i32 sign, i32 low, i32 high, i64* first, i64* last) {
+    // Offsets 'k' for which 'start + sign * k' lands in [low, high]
+    i64 from = sign > 0 ? (i64) low - start : (i64) start - high;
+    i64 to = sign > 0 ? (i64) high - start : (i64) start - low;
+
+    *first = from > *first ? from : *first;
+    *last = to < *last ? to : *last;
+
+    return *first <= *last;
+}
+
+static bool silkLineClip(silk_line* line, i32 major_low, i32 major_high, i32 minor_low, i32 minor_high) {
+    if(!silkLineClipAxis(line->major_start, line->major_sign, major_low, major_high, &line->first, &line->last)) {
+        return false;
+    }
+
+    i64 minor_first = 0;
+    i64 minor_last = line->minor_len;
+
+    if(!silkLineClipAxis(line->minor_start, line->minor_sign, minor_low, minor_high, &minor_first, &minor_last)) {
+        return false;
+    }
+
+    if(line->minor_len == 0) {
+        return true;
+    }
+
+    // Minor offset of the step 'i' is 'floor((2 * i * minor_len + major_len) / (2 * major_len))', so it reaches 'm' at the step
+    // 'ceil((2 * m * major_len - major_len) / (2 * minor_len))'
+    i64 denominator = 2 * line->minor_len;
+    i64 first = -silkFloorDiv(-(2 * minor_first * line->major_len - line->major_len), denominator);
+    i64 last = -silkFloorDiv(-(2 * (minor_last + 1) * line->major_len - line->major_len), denominator) - 1;
+
+    line->first = first > line->first ? first : line->first;
+    line->last = last < line->last ? last : line->last;
+
+    return line->first <= line->last;
+}
+
+static i32 silkRasterLine(silk_canvas* canvas, silk_line* line, bool steep, pixel pix) {
+    // Bresenham's error term, advanced to the first visible step
+    i64 numerator = 2 * line->first * line->minor_len + line->major_len;
+    i64 minor = numerator / (2 * line->major_len);
+    i64 error = numerator % (2 * line->major_len);
+
+    i32 major = line->major_start + (i32) (line->first * line->major_sign);
+    i32 count = (i32) (line->last - line->first) + 1;
+
+    if(!steep) {
+        // Shallow line: every row of it is a single horizontal run
+        i32 run_start = major;
+
+        for(i32 i = 0; i < count; i++) {
+            bool row_end = i == count - 1;
+
+            error += 2 * line->minor_len;
+
+            if(error >= 2 * line->major_len) {
+                error -= 2 * line->major_len;
+                row_end = true;
+            }
+
+            if(row_end) {
+                i32 x0 = line->major_sign > 0 ? run_start : major;
+                i32 y = line->minor_start + (i32) (minor * line->minor_sign);
+
+                i32 run = (major - run_start) * line->major_sign + 1;
+
+                // Short runs (the lines close to the diagonal) aren't worth the call to the span kernel
+                if(run < 8) {
+                    for(i32 x = 0; x < run; x++) {
+                        silkWritePixel(canvas, x0 + x, y, pix);
+                    }
+                } else {
+                    silkWriteSpan(canvas, x0, y, run, pix);
+                }
+
+                run_start = major + line->major_sign;
+                minor++;
+            }
+
+            major += line->major_sign;
+        }
+
+        return SILK_SUCCESS;
+    }
+
+    // Steep line: one pixel per row
+    i32 x = line->minor_start + (i32) (minor * line->minor_sign);
+
+    for(i32 i = 0; i < count; i++) {
+        silkWritePixel(canvas, x, major, pix);
+
+        major += line->major_sign;
+        error += 2 * line->minor_len;
+
+        if(error >= 2 * line->major_len) {
+            error -= 2 * line->major_len;
+            x += line->minor_sign;
+        }
+    }
+
+    return SILK_SUCCESS;
+}
+
+// Ellipses:
+// Filled ellipse covers the pixels whose centers lie inside of the midpoint boundary: the ellipse with the radii
+// 'rx + 1/2' and 'ry + 1/2' (for the circle it's 'dx^2 + dy^2 <= r^2 + r'). That's exactly [-rx, rx] x [-ry, ry] at the axes,
+// without the single-pixel spikes the plain 'dx^2 + dy^2 <= r^2' test leaves there. Every row is a single span.
+// The half-width of the span only shrinks while walking from the center row outwards, so it's found incrementally
+// with the integer test 'dx^2 * (2 * ry + 1)^2 + dy^2 * (2 * rx + 1)^2 <= (2 * rx + 1)^2 * (2 * ry + 1)^2 / 4',
+// without any square roots, and every half-width is used for two rows: above and below the center.
+
+static i32 silkRasterEllipse(silk_canvas* canvas, vec2i center, i32 radius_x, i32 radius_y, pixel pix) {
+    silk_rect clip = silkCanvasClip(canvas);
+    i32 clip_test = silkClipBounds(&clip, center.x - radius_x, center.y - radius_y, center.x + radius_x + 1, center.y + radius_y + 1);
+
+    if(clip_test == SILK_CLIP_OUTSIDE || silkPixelTransparent(canvas, pix)) {
+        return SILK_SUCCESS;
+    }
+
+    silkMarkDirtyBounds(canvas, &clip, center.x - radius_x, center.y - radius_y, center.x + radius_x + 1, center.y + radius_y + 1);
+
+    i64 rx2 = (i64) (2 * radius_x + 1) * (2 * radius_x + 1);
+    i64 ry2 = (i64) (2 * radius_y + 1) * (2 * radius_y + 1);
+    i64 limit = rx2 * ry2;
+
+    i64 half_width = radius_x;
+
+    for(i32 dy = 0; dy <= radius_y; dy++) {
+        while(4 * (half_width * half_width * ry2 + (i64) dy * dy * rx2) > limit) {
+            half_width--;
+        }
+
+        i32 x0 = center.x - (i32) half_width;
+        i32 x1 = center.x + (i32) half_width + 1;
+
+        for(i32 side = 0; side < (dy == 0 ? 1 : 2); side++) {
+            i32 y = side == 0 ? center.y + dy : center.y - dy;
+
+            if(clip_test == SILK_CLIP_INSIDE) {
+                silkWriteSpan(canvas, x0, y, x1 - x0, pix);
+            } else {
+                silkDrawSpan(canvas, y, x0, x1, pix);
+            }
+        }
+    }
+
+    return SILK_SUCCESS;
+}
+
+// Anti-aliased lines (Xiaolin Wu's algorithm):
+// Every step along the major axis covers two neighbouring pixels of the minor axis, weighted by the distance
+// of the line from their centers. The line's position is stepped in 16.16 fixed-point, and the coverage (0 - 255)
+// scales the alpha of the color, so it's blended with the same exact source-over as everything else.
+// Source:
+// https://en.wikipedia.org/wiki/Xiaolin_Wu%27s_line_algorithm
+
+#if defined(SILK_ALPHABLEND_ENABLE)
+
+static i32 silkPlotLineCoverage(silk_canvas* canvas, silk_rect* clip, bool steep, i32 major, i32 minor, pixel pix, u32 coverage) {
+    return silkPlotPixelCoverage(canvas, clip, steep ? minor : major, steep ? major : minor, pix, coverage);
+}
+
+static i32 silkPlotLineEndpoint(silk_canvas* canvas, silk_rect* clip, bool steep, f32 major, f32 minor, f32 gradient, pixel pix, bool last, i32* major_pixel, f32* minor_at_pixel) {
+    // Endpoint covers only a part of it's pixel along the major axis ('gap')
+    f32 major_end = floorf(major + 0.5f);
+    f32 minor_end = minor + gradient * (major_end - major);
+    f32 gap = last ? (major + 0.5f) - major_end : 1.0f - ((major + 0.5f) - major_end);
+    f32 fraction = minor_end - floorf(minor_end);
+
+    *major_pixel = (i32) major_end;
+    *minor_at_pixel = minor_end;
+
+    silkPlotLineCoverage(canvas, clip, steep, (i32) major_end, (i32) floorf(minor_end), pix, (u32) ((1.0f - fraction) * gap * 255.0f + 0.5f));
+    silkPlotLineCoverage(canvas, clip, steep, (i32) major_end, (i32) floorf(minor_end) + 1, pix, (u32) (fraction * gap * 255.0f + 0.5f));
+
+    return SILK_SUCCESS;
+}
+
+#endif // SILK_ALPHABLEND_ENABLE
+
+// Frame differencing:
+// Every tile of the canvas is hashed (see: 'silkHashStripesScalar'), and compared with it's hash from the previous frame.
+// Rows of the tile are one stream of stripes: the last, partial stripe of every row is padded with zeros (the width
+// of the tile never changes, so the padding can't make two different tiles equal). Accumulators are folded into
+// one 64-bit hash at the end, with the XXH64 merge rounds and the XXH3 avalanche.
+
+static u64 silkHashAvalanche(u64 hash) {
+    hash ^= hash >> 37;
+    hash *= 0x165667919e3779f9ull;
+    hash ^= hash >> 32;
+
+    return hash;
+}
+
+static void silkHashScramble(u64* acc) {
+    const u64* key = silk_hash_keys + SILK_HASH_BLOCK_STRIPES;
+
+    for(i32 i = 0; i < 8; i++) {
+        u64 value = acc[i] ^ (acc[i] >> 47) ^ key[i];
+        acc[i] = value * SILK_HASH_PRIME32_1;
+    }
+}
+
+static u64 silkHashTile(silk_kernel_table* kernels, const u8* data, i32 stride, i32 row_size, i32 rows) {
+    u64 acc[8] = {
+        0xc2b2ae3dull, SILK_HASH_PRIME64_1, 0xc2b2ae3d27d4eb4full, 0x165667b19e3779f9ull,
+        SILK_HASH_PRIME64_4, 0x85ebca77ull, 0x27d4eb2f165667c5ull, SILK_HASH_PRIME32_1
+    };
+
+    i32 full_stripes = row_size / 64;
+    i32 tail = row_size % 64;
+    i32 position = 0; // Stripe inside of the current block
+
+    for(i32 y = 0; y < rows; y++) {
+        const u8* row = data + (size_t) y * stride;
+
+        for(i32 stripe = 0; stripe < full_stripes; ) {
+            i32 count = full_stripes - stripe < SILK_HASH_BLOCK_STRIPES - position ? full_stripes - stripe : SILK_HASH_BLOCK_STRIPES - position;
+
+            kernels->hash(acc, row + (size_t) stripe * 64, count, silk_hash_keys + position);
+
+            stripe += count;
+            position += count;
+
+            if(position == SILK_HASH_BLOCK_STRIPES) {
+                silkHashScramble(acc);
+                position = 0;
+            }
+        }
+
+        if(tail > 0) {
+            u8 last[64] = { 0 };
+            memcpy(last, row + (size_t) full_stripes * 64, (size_t) tail);
+
+            kernels->hash(acc, last, 1, silk_hash_keys + position);
+            position++;
+
+            if(position == SILK_HASH_BLOCK_STRIPES) {
+                silkHashScramble(acc);
+                position = 0;
+            }
+        }
+    }
+
+    u64 hash = (u64) row_size * (u64) rows * SILK_HASH_PRIME64_1;
+
+    for(i32 i = 0; i < 8; i++) {
+        hash ^= silkHashAvalanche(acc[i] + silk_hash_keys[i]);
+        hash = ((hash << 27) | (hash >> 37)) * SILK_HASH_PRIME64_1 + SILK_HASH_PRIME64_4;
+    }
+
+    return silkHashAvalanche(hash);
+}
+
+// Bitmap fonts:
+// Glyph is drawn straight from it's row masks (see: 'silk_bitmap_font'). Runs of the set bits of the row are found with
+// two bit scans, and every run becomes one span ('font_size' times wider), written to each of the 'font_size' rows the
+// row of the glyph covers. Wide spans of the big glyphs go through the same SIMD kernels as every other fill.
+
+static i32 silkBlitGlyph(silk_canvas* canvas, const u8* rows, i32 height, vec2i origin, i32 font_size, silk_rect bounds, pixel pix) {
+    for(i32 row = 0; row < height; row++) {
+        i64 y0 = (i64) origin.y + (i64) row * font_size;
+        i64 y1 = y0 + font_size;
+
+        y0 = y0 > bounds.y ? y0 : bounds.y;
+        y1 = y1 < (i64) bounds.y + bounds.h ? y1 : (i64) bounds.y + bounds.h;
+
+        u32 mask = rows[row];
+
+        while(mask != 0 && y0 < y1) {
+            i32 start = silkLowestBit(mask);
+            i32 length = silkLowestBit(~(mask >> start));
+
+            mask &= ~(((1u << length) - 1) << start);
+
+            i64 x0 = (i64) origin.x + (i64) start * font_size;
+            i64 x1 = x0 + (i64) length * font_size;
+
+            x0 = x0 > bounds.x ? x0 : bounds.x;
+            x1 = x1 < (i64) bounds.x + bounds.w ? x1 : (i64) bounds.x + bounds.w;
+
+            for(i64 y = y0; y < y1 && x0 < x1; y++) {
+                silkWriteSpan(canvas, (i32) x0, (i32) y, (i32) (x1 - x0), pix);
+            }
+        }
+    }
+
+    return SILK_SUCCESS;
+}
+
+// Coverage masks:
+// Runs of the fully covered pixels are written as the spans, and the partially covered ones are blended with the color
+// faded per pixel, exactly like 'silkPlotPixelCoverage' does it, but a whole run at once (through the image kernels).
+
+#if defined(SILK_ALPHABLEND_ENABLE)
+
+// Returns the faded alpha (0: the pixel is skipped, just like 'silkPlotPixelCoverage' skips it)
+static u32 silkFadePixel(pixel pix, u32 coverage, pixel* faded) {
+    u32 alpha = ((pix & SILK_PIXEL_ALPHA_MASK) >> SILK_PIXEL_ALPHA_SHIFT) * coverage + 128;
+    alpha = (alpha + (alpha >> 8)) >> 8;
+
+#if defined(SILK_PREMULTIPLIED_ALPHA)
+
+    *faded = silkScalePixel(pix, coverage);
+
+#else
+
+    *faded = (pix & ~SILK_PIXEL_ALPHA_MASK) | ((pixel) alpha << SILK_PIXEL_ALPHA_SHIFT);
+
+#endif // SILK_PREMULTIPLIED_ALPHA
+
+    return alpha;
+}
+
+#endif // SILK_ALPHABLEND_ENABLE
+
+static i32 silkWriteCoverageSpan(silk_canvas* canvas, i32 x, i32 y, const u8* coverage, i32 count, pixel pix) {
+#if defined(SILK_ALPHABLEND_ENABLE)
+
+    pixel faded[SILK_SPAN_CHUNK];
+
+    for(i32 i = 0; i < count; ) {
+        i32 start = i;
+
+        if(coverage[i] == 0) {
+            while(i < count && coverage[i] == 0) {
+                i++;
+            }
+        } else if(coverage[i] == 255) {
+            while(i < count && coverage[i] == 255) {
+                i++;
+            }
+
+            silkWriteSpan(canvas, x + start, y, i - start, pix);
+        } else if(canvas->blend_mode == SILK_BLEND_MODE_REPLACE) {
+            // "Replace" doesn't fade the color, but moves the canvas towards it (see: 'silkPlotPixelCoverage')
+            silkPlotPixelCoverage(canvas, NULL, x + i, y, pix, coverage[i]);
+            i++;
+        } else {
+            while(i < count && coverage[i] != 0 && coverage[i] != 255 && i - start < SILK_SPAN_CHUNK && silkFadePixel(pix, coverage[i], &faded[i - start]) != 0) {
+                i++;
+            }
+
+            if(i > start) {
+                silkWriteImageSpan(canvas, x + start, y, faded, i - start);
+            } else {
+                i++;
+            }
+        }
+    }
+
+#else
+
+    // Without the alpha-blending there's no way to draw the partial coverage, so the mask is simply thresholded
+    for(i32 i = 0; i < count; ) {
+        i32 start = i;
+
+        while(i < count && coverage[i] >= 128) {
+            i++;
+        }
+
+        if(i > start) {
+            silkWriteSpan(canvas, x + start, y, i - start, pix);
+        }
+
+        while(i < count && coverage[i] < 128) {
+            i++;
+        }
+    }
+
+#endif // SILK_ALPHABLEND_ENABLE
+
+    return SILK_SUCCESS;
+}
+
+// UTF-8:
+// Decodes the code point at the start of 'text', and stores the number of it's bytes into 'length'.
+// Malformed sequences (overlong, surrogates, truncated, out of the Unicode range) are U+FFFD, one byte long.
+
+static u32 silkDecodeUTF8(const char* text, i32* length) {
+    static const u32 minimum[4] = { 0, 0x80, 0x800, 0x10000 };
+
+    const u8* bytes = (const u8*) text;
+    u32 lead = bytes[0];
+
+    *length = 1;
+
+    if(lead < 0x80) {
+        return lead;
+    }
+
+    i32 count = lead >= 0xf0 ? 3 : (lead >= 0xe0 ? 2 : (lead >= 0xc0 ? 1 : 0));
+
+    if(count == 0 || lead > 0xf4) {
+        return 0xfffd;
+    }
+
+    u32 code = lead & (0x3f >> count);
+
+    for(i32 i = 1; i <= count; i++) {
+        // The terminating zero isn't a continuation byte either, so the truncated sequences stop here
+        if((bytes[i] & 0xc0) != 0x80) {
+            return 0xfffd;
+        }
+
+        code = (code << 6) | (bytes[i] & 0x3f);
+    }
+
+    if(code < minimum[count] || code > 0x10ffff || (code >= 0xd800 && code <= 0xdfff)) {
+        return 0xfffd;
+    }
+
+    *length = count + 1;
+
+    return code;
+}
+
+// Text layout:
+// Glyphs of the bitmap fonts are all as wide as the font's cell, so the text is laid out on the grid of the glyphs: columns
+// and lines. The text is decoded from UTF-8 (one column per code point), '\n' starts the next line, and with 'columns' above
+// 0 the lines are wrapped between the words. Words longer than the whole line are broken, and the spaces the line is
+// wrapped at are dropped. Every glyph is passed to 'emit', so drawing and measuring the text doesn't store anything.
+
+typedef void (*silk_text_emit)(void* user, u32 code, i32 column, i32 line);
+
+static i32 silkLayoutTextGrid(const char* text, i32 columns, silk_text_emit emit, void* user) {
+    i32 column = 0;
+    i32 line = 0;
+    i32 pending = 0;    // Spaces after the last word of the line (they're emitted once the next word fits after them)
+
+    for(i32 i = 0; ; ) {
+        i32 length = 1;
+        u32 code = text[i] != '\0' ? silkDecodeUTF8(text + i, &length) : '\n';
+
+        if(code == ' ') {
+            pending++;
+            i += length;
+
+            continue;
+        }
+
+        if(code == '\n') {
+            // Trailing spaces are kept, as long as they fit into the line
+            for(; pending > 0 && (columns <= 0 || column < columns); pending--) {
+                emit(user, ' ', column++, line);
+            }
+
+            if(text[i] == '\0') {
+                break;
+            }
+
+            line++;
+            column = 0;
+            pending = 0;
+            i += length;
+
+            continue;
+        }
+
+        // Word ends at the next space or line break (both are ASCII, so they're never a part of the longer sequences)
+        i32 word = 0;
+
+        for(i32 j = i; text[j] != '\0' && text[j] != ' ' && text[j] != '\n'; word++) {
+            i32 skip = 1;
+            silkDecodeUTF8(text + j, &skip);
+            j += skip;
+        }
+
+        if(columns > 0 && column > 0 && column + pending + word > columns) {
+            line++;
+            column = 0;
+            pending = 0;
+        }
+
+        for(i32 glyph = -pending; glyph < word; glyph++) {
+            if(glyph >= 0) {
+                code = silkDecodeUTF8(text + i, &length);
+                i += length;
+            }
+
+            if(columns > 0 && column == columns) {
+                line++;
+                column = 0;
+            }
+
+            emit(user, glyph >= 0 ? code : ' ', column++, line);
+        }
+
+        pending = 0;
+    }
+
+    return line + 1;
+}
+
+// Size (in pixels) of the 'columns' x 'lines' glyphs, with the spacing only between them
+static vec2i silkTextGridSize(const silk_bitmap_font* font, i32 font_size, i32 font_spacing, i32 columns, i32 lines) {
+    return (vec2i) {
+        columns > 0 ? (columns * (font->glyph_size.x + font_spacing) - font_spacing) * font_size : 0,
+        (lines * (font->glyph_size.y + font_spacing) - font_spacing) * font_size
+    };
+}
+
+// Number of the glyphs of 'font' fitting into 'max_width' pixels (0: the text isn't wrapped)
+static i32 silkTextGridColumns(const silk_bitmap_font* font, i32 font_size, i32 font_spacing, i32 max_width) {
+    i32 advance = (font->glyph_size.x + font_spacing) * font_size;
+
+    if(max_width <= 0 || advance <= 0) {
+        return 0;
+    }
+
+    i32 columns = (max_width + font_spacing * font_size) / advance;
+
+    return columns > 0 ? columns : 1;
+}
+
+static void silkMeasureGlyph(void* user, u32 code, i32 column, i32 line) {
+    i32* columns = (i32*) user;
+
+    SILK_UNUSED(code)
+    SILK_UNUSED(line)
+
+    *columns = column + 1 > *columns ? column + 1 : *columns;
+}
+
+static i32 silkDrawBitmapGlyph(silk_canvas* canvas, silk_rect clip, const silk_bitmap_font* font, u32 code, vec2i origin, i32 font_size, pixel pix) {
+    if(code >= (u32) font->glyph_count) {
+        return SILK_SUCCESS;
+    }
+
+    silk_rect bounds = silkRectIntersect(clip, (silk_rect) { origin.x, origin.y, font->glyph_size.x * font_size, font->glyph_size.y * font_size });
+
+    if(bounds.w == 0 || bounds.h == 0) {
+        return SILK_SUCCESS;
+    }
+
+    const u8* rows = font->rows + (size_t) code * font->glyph_size.y;
+    bool empty = true;
+
+    for(i32 y = 0; y < font->glyph_size.y; y++) {
+        empty = empty && rows[y] == 0;
+    }
+
+    if(empty) {
+        return SILK_SUCCESS;
+    }
+
+    silkMarkDirty(canvas, bounds);
+
+    return silkBlitGlyph(canvas, rows, font->glyph_size.y, origin, font_size, bounds, pix);
+}
+
+typedef struct {
+    silk_canvas* canvas;
+    silk_rect clip;
+    const silk_bitmap_font* font;
+    vec2i origin;       // Top-left corner of the first glyph
+    vec2i advance;      // Distance between the columns and the lines (in pixels)
+    i32 font_size;
+    pixel pix;
+} silk_text_draw;
+
+static void silkDrawGridGlyph(void* user, u32 code, i32 column, i32 line) {
+    silk_text_draw* draw = (silk_text_draw*) user;
+    vec2i origin = { draw->origin.x + column * draw->advance.x, draw->origin.y + line * draw->advance.y };
+
+    silkDrawBitmapGlyph(draw->canvas, draw->clip, draw->font, code, origin, draw->font_size, draw->pix);
+}
+
+// Text cache:
+// Layouts are kept in the arena of the cache, made of the blocks that never move (so the glyphs of the returned layouts
+// stay valid), and found by the hash of their key in a direct-mapped table. A layout replaced in the table is still valid,
+// it just isn't found anymore: the memory is reclaimed by 'silkResetTextCache'.
+
+typedef struct silk_text_block {
+    struct silk_text_block* next;
+    i64 size;           // Bytes following the header
+    i64 used;
+} silk_text_block;
+
+typedef struct {
+    u64 hash;
+    const char* text;   // Copy of the string, in the arena (NULL: empty entry)
+    i32 max_width;
+    silk_text_layout layout;
+} silk_text_cache_entry;
+
+// Returns 'size' bytes (8-byte aligned) from the arena, and the block they were taken from
+static void* silkTextCacheAlloc(silk_text_cache* cache, i64 size, silk_text_block** from) {
+    size = (size + 7) & ~(i64) 7;
+
+    silk_text_block* last = NULL;
+
+    for(silk_text_block* block = (silk_text_block*) cache->blocks; block != NULL; block = block->next) {
+        if(block->size - block->used >= size) {
+            *from = block;
+            block->used += size;
+
+            return (u8*) (block + 1) + block->used - size;
+        }
+
+        last = block;
+    }
+
+    // Blocks double in size, so the arena is a handful of blocks even for the big dashboards
+    i64 capacity = last != NULL ? last->size * 2 : SILK_TEXT_BLOCK_SIZE;
+    capacity = capacity > size ? capacity : size;
+
+    silk_text_block* block = (silk_text_block*) SILK_MALLOC(sizeof(silk_text_block) + (size_t) capacity);
+
+    if(block == NULL) {
+        silkAssignErrorMessage(SILK_ERR_ALLOCATION_FAIL);
+
+        return NULL;
+    }
+
+    *block = (silk_text_block) { NULL, capacity, size };
+
+    if(last != NULL) {
+        last->next = block;
+    } else {
+        cache->blocks = block;
+    }
+
+    *from = block;
+
+    return block + 1;
+}
+
+typedef struct {
+    silk_text_glyph* glyphs;
+    i32 count;
+    i32 columns;        // Widest line (in glyphs)
+    vec2i advance;
+} silk_text_store;
+
+static void silkStoreGridGlyph(void* user, u32 code, i32 column, i32 line) {
+    silk_text_store* store = (silk_text_store*) user;
+
+    store->glyphs[store->count++] = (silk_text_glyph) { code, { column * store->advance.x, line * store->advance.y } };
+    store->columns = column + 1 > store->columns ? column + 1 : store->columns;
+}
+
+static u64 silkTextCacheHash(const char* text, const silk_bitmap_font* font, i32 font_size, i32 font_spacing, i32 max_width) {
+    // FNV-1a of the string, mixed with the rest of the key
+    u64 hash = 0xcbf29ce484222325ull;
+
+    for(const u8* c = (const u8*) text; *c != '\0'; c++) {
+        hash = (hash ^ *c) * 0x100000001b3ull;
+    }
+
+    u64 key[4] = { (u64) (uintptr_t) font, (u64) (u32) font_size, (u64) (u32) font_spacing, (u64) (u32) max_width };
+
+    for(i32 i = 0; i < 4; i++) {
+        hash = (hash ^ key[i]) * SILK_HASH_PRIME64_1;
+    }
+
+    return silkHashAvalanche(hash);
+}
+
+#if defined(SILK_INCLUDE_MODULE_STB_TRUETYPE)
+
+// Fonts:
+// Glyphs of the TrueType fonts are rasterized by stb_truetype once per process, into one A8 atlas shared by every font
+// and every thread. Atlas is packed in shelves: rows as tall as the glyphs they hold (rounded up to 4 pixels), filled
+// from the left. Once it's full, the least recently used shelf that's tall enough is emptied (the glyphs it held are
+// rasterized again when they're needed), and if there's no such shelf, so is the whole atlas.
+// Glyphs are found by the (font, glyph, size) in a hash table. Laid out strings (glyph indices and their positions, with
+// the kerning applied) are cached as well, so the repeated labels skip the UTF-8 decoding and the font tables altogether.
+//
+// All of it is guarded by one mutex (with 'SILK_THREADS_ENABLE'). Coverage of the glyphs is copied out of the atlas in
+// batches and blitted with the lock released, so the atlas can change under the blits (the copy doesn't).
+
+typedef struct {
+    i32 font;
+    i32 glyph;
+    i32 size;
+    i32 next;           // Next glyph of the same hash bucket (-1: none)
+    i32 next_in_shelf;  // Next glyph of the same shelf (-1: none)
+    i32 shelf;          // -1: glyph without any pixels (i.e. space)
+    i32 x;              // Position and size in the atlas
+    i32 y;
+    i32 w;
+    i32 h;
+    i32 offset_x;       // Top-left corner, relative to the pen on the baseline
+    i32 offset_y;
+} silk_font_glyph;
+
+typedef struct {
+    i32 y;
+    i32 height;
+    i32 used;           // Width taken by the glyphs
+    i32 glyphs;         // First glyph of the shelf (-1: none)
+    u64 last_use;
+} silk_font_shelf;
+
+typedef struct {
+    i32 glyph;
+    i32 x;              // Pen position, relative to the first baseline
+    i32 y;
+} silk_font_run_glyph;
+
+typedef struct {
+    char* text;         // NULL: empty slot
+    u64 hash;
+    i32 font;
+    i32 size;
+    silk_font_run_glyph* glyphs;
+    i32 count;
+    vec2i extent;       // Size of the laid out text (in pixels)
+    i32 users;          // Draw calls using the run right now (it can't be replaced until they're done)
+    bool temporary;     // Laid out outside of the cache (it's slot was in use)
+} silk_font_run;
+
+typedef struct {
+    u8* memory;         // One block: the glyphs, the hash buckets and the atlas (NULL: not allocated yet)
+    silk_font_glyph* glyphs;
+    i32* buckets;
+    u8* pixels;
+    i32 glyph_count;    // Glyphs ever taken from the pool
+    i32 free_glyphs;    // First evicted glyph, reused before the pool (-1: none)
+    silk_font_shelf shelves[SILK_FONT_ATLAS_SIZE / SILK_FONT_SHELF_ROUNDING];
+    i32 shelf_count;
+    i32 shelf_bottom;   // Top of the unused part of the atlas
+    silk_font_run runs[SILK_FONT_RUN_CACHE_SIZE];
+    u64 clock;          // Ticks once per draw call
+    i32 next_font;
+} silk_font_cache;
+
+static silk_font_cache silk_font_atlas = { .next_font = 1 };
+
+#if defined(SILK_THREADS_ENABLE)
+static silk_mutex silk_font_mutex = SILK_MUTEX_INIT;
+#endif // SILK_THREADS_ENABLE
+
+static void silkFontLock(void) {
+#if defined(SILK_THREADS_ENABLE)
+    silkMutexLock(&silk_font_mutex);
+#endif // SILK_THREADS_ENABLE
+}
+
+static void silkFontUnlock(void) {
+#if defined(SILK_THREADS_ENABLE)
+    silkMutexUnlock(&silk_font_mutex);
+#endif // SILK_THREADS_ENABLE
+}
+
+static void silkFontResetAtlas(void) {
+    for(i32 i = 0; i < SILK_FONT_GLYPH_CAPACITY; i++) {
+        silk_font_atlas.buckets[i] = -1;
+    }
+
+    silk_font_atlas.glyph_count = 0;
+    silk_font_atlas.free_glyphs = -1;
+    silk_font_atlas.shelf_count = 0;
+    silk_font_atlas.shelf_bottom = 0;
+}
+
+static i32 silkFontInitAtlas(void) {
+    if(silk_font_atlas.memory != NULL) {
+        return SILK_SUCCESS;
+    }
+
+    size_t glyphs_size = SILK_FONT_GLYPH_CAPACITY * sizeof(silk_font_glyph);
+    size_t buckets_size = SILK_FONT_GLYPH_CAPACITY * sizeof(i32);
+    u8* memory = (u8*) SILK_MALLOC(glyphs_size + buckets_size + (size_t) SILK_FONT_ATLAS_SIZE * SILK_FONT_ATLAS_SIZE);
+
+    if(memory == NULL) {
+        silkAssignErrorMessage(SILK_ERR_ALLOCATION_FAIL);
+
+        return SILK_FAILURE;
+    }
+
+    silk_font_atlas.memory = memory;
+    silk_font_atlas.glyphs = (silk_font_glyph*) memory;
+    silk_font_atlas.buckets = (i32*) (memory + glyphs_size);
+    silk_font_atlas.pixels = memory + glyphs_size + buckets_size;
+
+    silkFontResetAtlas();
+
+    return SILK_SUCCESS;
+}
+
+static i32 silkFontBucket(i32 font, i32 glyph, i32 size) {
+    return (i32) (((u32) font * 0x9e3779b1u ^ (u32) glyph * 0x85ebca77u ^ (u32) size * 0xc2b2ae3du) % SILK_FONT_GLYPH_CAPACITY);
+}
+
+static void silkFontEvictShelf(silk_font_shelf* shelf) {
+    for(i32 index = shelf->glyphs; index >= 0; ) {
+        silk_font_glyph* glyph = &silk_font_atlas.glyphs[index];
+        i32* link = &silk_font_atlas.buckets[silkFontBucket(glyph->font, glyph->glyph, glyph->size)];
+        i32 next = glyph->next_in_shelf;
+
+        while(*link != index) {
+            link = &silk_font_atlas.glyphs[*link].next;
+        }
+
+        *link = glyph->next;
+
+        glyph->next = silk_font_atlas.free_glyphs;
+        silk_font_atlas.free_glyphs = index;
+
+        index = next;
+    }
+
+    shelf->glyphs = -1;
+    shelf->used = 0;
+}
+
+// Finds the room for the glyph of the 'size' (see: 'Fonts' above), and returns the shelf it's placed in
+static i32 silkFontPlace(vec2i size, vec2i* position) {
+    i32 height = (size.y + SILK_FONT_SHELF_ROUNDING - 1) / SILK_FONT_SHELF_ROUNDING * SILK_FONT_SHELF_ROUNDING;
+    i32 shelf = -1;
+
+    for(i32 i = 0; i < silk_font_atlas.shelf_count && shelf < 0; i++) {
+        if(silk_font_atlas.shelves[i].height == height && silk_font_atlas.shelves[i].used + size.x <= SILK_FONT_ATLAS_SIZE) {
+            shelf = i;
+        }
+    }
+
+    if(shelf < 0 && silk_font_atlas.shelf_bottom + height <= SILK_FONT_ATLAS_SIZE) {
+        shelf = silk_font_atlas.shelf_count++;
+        silk_font_atlas.shelves[shelf] = (silk_font_shelf) { silk_font_atlas.shelf_bottom, height, 0, -1, 0 };
+        silk_font_atlas.shelf_bottom += height;
+    }
+
+    if(shelf < 0) {
+        for(i32 i = 0; i < silk_font_atlas.shelf_count; i++) {
+            silk_font_shelf* candidate = &silk_font_atlas.shelves[i];
+
+            if(candidate->height >= height && (shelf < 0 || candidate->last_use < silk_font_atlas.shelves[shelf].last_use)) {
+                shelf = i;
+            }
+        }
+
+        if(shelf < 0) {
+            // Every shelf is too short: the atlas starts over (the glyph is never taller than the atlas)
+            silkFontResetAtlas();
+
+            return silkFontPlace(size, position);
+        }
+
+        silkFontEvictShelf(&silk_font_atlas.shelves[shelf]);
+    }
+
+    silk_font_shelf* target = &silk_font_atlas.shelves[shelf];
+
+    *position = (vec2i) { target->used, target->y };
+    target->used += size.x;
+
+    return shelf;
+}
+
+// Glyph of the font at the pixel height 'size', rasterized into the atlas on it's first use.
+// Returns NULL for the glyphs too big to be cached (they're rasterized on every use).
+static silk_font_glyph* silkFontGetGlyph(silk_font* font, i32 glyph, i32 size, f32 scale) {
+    i32 bucket = silkFontBucket(font->id, glyph, size);
+
+    for(i32 index = silk_font_atlas.buckets[bucket]; index >= 0; index = silk_font_atlas.glyphs[index].next) {
+        silk_font_glyph* cached = &silk_font_atlas.glyphs[index];
+
+        if(cached->font == font->id && cached->glyph == glyph && cached->size == size) {
+            if(cached->shelf >= 0) {
+                silk_font_atlas.shelves[cached->shelf].last_use = silk_font_atlas.clock;
+            }
+
+            return cached;
+        }
+    }
+
+    i32 x0 = 0, y0 = 0, x1 = 0, y1 = 0;
+    stbtt_GetGlyphBitmapBox((const stbtt_fontinfo*) font->info, glyph, scale, scale, &x0, &y0, &x1, &y1);
+
+    vec2i extent = { x1 - x0, y1 - y0 };
+
+    if(extent.x > SILK_FONT_ATLAS_SIZE || extent.y > SILK_FONT_ATLAS_SIZE || (i64) extent.x * extent.y > SILK_FONT_BATCH_SIZE) {
+        return NULL;
+    }
+
+    if(silk_font_atlas.free_glyphs < 0 && silk_font_atlas.glyph_count == SILK_FONT_GLYPH_CAPACITY) {
+        silkFontResetAtlas();
+    }
+
+    // Placed before the glyph is taken from the pool, as the placing can evict the glyphs (or reset the atlas)
+    i32 shelf = -1;
+    vec2i position = { 0 };
+
+    if(extent.x > 0 && extent.y > 0) {
+        shelf = silkFontPlace(extent, &position);
+        silk_font_atlas.shelves[shelf].last_use = silk_font_atlas.clock;
+
+        stbtt_MakeGlyphBitmap(
+            (const stbtt_fontinfo*) font->info,
+            silk_font_atlas.pixels + (size_t) position.y * SILK_FONT_ATLAS_SIZE + position.x,
+            extent.x,
+            extent.y,
+            SILK_FONT_ATLAS_SIZE,
+            scale,
+            scale,
+            glyph
+        );
+    }
+
+    i32 index = silk_font_atlas.free_glyphs;
+
+    if(index >= 0) {
+        silk_font_atlas.free_glyphs = silk_font_atlas.glyphs[index].next;
+    } else {
+        index = silk_font_atlas.glyph_count++;
+    }
+
+    silk_font_glyph* result = &silk_font_atlas.glyphs[index];
+
+    *result = (silk_font_glyph) {
+        font->id, glyph, size,
+        silk_font_atlas.buckets[bucket],
+        shelf >= 0 ? silk_font_atlas.shelves[shelf].glyphs : -1,
+        shelf,
+        position.x, position.y, extent.x, extent.y,
+        x0, y0
+    };
+
+    silk_font_atlas.buckets[bucket] = index;
+
+    if(shelf >= 0) {
+        silk_font_atlas.shelves[shelf].glyphs = index;
+    }
+
+    return result;
+}
+
+static void silkFontFreeRun(silk_font_run* run) {
+    SILK_FREE(run->text);
+    SILK_FREE(run->glyphs);
+
+    *run = (silk_font_run) { 0 };
+}
+
+static i32 silkFontLayout(silk_font* font, const char* text, i32 size, silk_font_run* run) {
+    const stbtt_fontinfo* info = (const stbtt_fontinfo*) font->info;
+    f32 scale = stbtt_ScaleForPixelHeight(info, (f32) size);
+    i32 line_height = (i32) ceilf((f32) (font->ascent - font->descent + font->line_gap) * scale);
+    size_t length = strlen(text);
+
+    // Every glyph takes at least one byte of the text
+    run->glyphs = (silk_font_run_glyph*) SILK_MALLOC((length + 1) * sizeof(silk_font_run_glyph));
+    run->text = (char*) SILK_MALLOC(length + 1);
+
+    if(run->glyphs == NULL || run->text == NULL) {
+        silkAssignErrorMessage(SILK_ERR_ALLOCATION_FAIL);
+
+        return SILK_FAILURE;
+    }
+
+    memcpy(run->text, text, length + 1);
+
+    f32 pen = 0.0f;
+    f32 width = 0.0f;
+    i32 line = 0;
+    i32 previous = -1;
+
+    for(size_t i = 0; i < length; ) {
+        i32 bytes = 1;
+        u32 code = silkDecodeUTF8(text + i, &bytes);
+
+        i += (size_t) bytes;
+
+        if(code == '\n') {
+            width = pen > width ? pen : width;
+            pen = 0.0f;
+            previous = -1;
+            line++;
+
+            continue;
+        }
+
+        i32 glyph = stbtt_FindGlyphIndex(info, (int) code);
+
+        if(previous >= 0) {
+            pen += (f32) stbtt_GetGlyphKernAdvance(info, previous, glyph) * scale;
+        }
+
+        run->glyphs[run->count++] = (silk_font_run_glyph) { glyph, (i32) floorf(pen + 0.5f), line * line_height };
+
+        i32 advance = 0, bearing = 0;
+        stbtt_GetGlyphHMetrics(info, glyph, &advance, &bearing);
+
+        pen += (f32) advance * scale;
+        previous = glyph;
+    }
+
+    width = pen > width ? pen : width;
+    run->extent = (vec2i) { (i32) ceilf(width), (line + 1) * line_height };
+
+    return SILK_SUCCESS;
+}
+
+// Laid out 'text', from the run cache if it's there. Run stays valid until it's released (see: 'silkFontReleaseRun').
+static silk_font_run* silkFontGetRun(silk_font* font, const char* text, i32 size) {
+    // FNV-1a of the text, mixed with the font and the size
+    u64 hash = 0xcbf29ce484222325ull;
+
+    for(const u8* c = (const u8*) text; *c != '\0'; c++) {
+        hash = (hash ^ *c) * 0x100000001b3ull;
+    }
+
+    hash ^= ((u64) (u32) font->id << 32) | (u32) size;
+
+    silk_font_run* run = &silk_font_atlas.runs[hash % SILK_FONT_RUN_CACHE_SIZE];
+
+    if(run->text != NULL && run->hash == hash && run->font == font->id && run->size == size && strcmp(run->text, text) == 0) {
+        run->users++;
+
+        return run;
+    }
+
+    if(run->users > 0) {
+        // Slot is used by another draw call, so the text is laid out just for this one
+        run = (silk_font_run*) SILK_CALLOC(1, sizeof(silk_font_run));
+
+        if(run == NULL) {
+            silkAssignErrorMessage(SILK_ERR_ALLOCATION_FAIL);
+
+            return NULL;
+        }
+
+        run->temporary = true;
+    } else {
+        silkFontFreeRun(run);
+    }
+
+    run->hash = hash;
+    run->font = font->id;
+    run->size = size;
+
+    if(silkFontLayout(font, text, size, run) != SILK_SUCCESS) {
+        bool temporary = run->temporary;
+
+        silkFontFreeRun(run);
+
+        if(temporary) {
+            SILK_FREE(run);
+        }
+
+        return NULL;
+    }
+
+    run->users++;
+
+    return run;
+}
+
+static void silkFontReleaseRun(silk_font_run* run) {
+    if(run->temporary) {
+        silkFontFreeRun(run);
+        SILK_FREE(run);
+
+        return;
+    }
+
+    run->users--;
+}
+
+static i32 silkFontBlit(silk_canvas* canvas, silk_rect rect, const u8* coverage, i32 stride, pixel pix) {
+    silkMarkDirty(canvas, rect);
+
+    for(i32 y = 0; y < rect.h; y++) {
+        silkWriteCoverageSpan(canvas, rect.x, rect.y + y, coverage + (size_t) y * stride, rect.w, pix);
+    }
+
+    return SILK_SUCCESS;
+}
+
+// Glyphs too big for the atlas are rasterized into a temporary buffer every time (no lock is needed for that)
+static i32 silkFontBlitUncached(silk_canvas* canvas, silk_font* font, i32 glyph, f32 scale, vec2i origin, pixel pix) {
+    i32 x0 = 0, y0 = 0, x1 = 0, y1 = 0;
+    stbtt_GetGlyphBitmapBox((const stbtt_fontinfo*) font->info, glyph, scale, scale, &x0, &y0, &x1, &y1);
+
+    silk_rect bounds = { origin.x + x0, origin.y + y0, x1 - x0, y1 - y0 };
+    silk_rect rect = silkRectIntersect(silkCanvasClip(canvas), bounds);
+
+    if(rect.w == 0 || rect.h == 0) {
+        return SILK_SUCCESS;
+    }
+
+    if(bounds.w > (1 << 15) || bounds.h > (1 << 15)) {
+        silkAssignErrorMessage(SILK_ERR_OUT_OF_BOUNDS);
+
+        return SILK_FAILURE;
+    }
+
+    u8* coverage = (u8*) SILK_MALLOC((size_t) bounds.w * bounds.h);
+
+    if(coverage == NULL) {
+        silkAssignErrorMessage(SILK_ERR_ALLOCATION_FAIL);
+
+        return SILK_FAILURE;
+    }
+
+    stbtt_MakeGlyphBitmap((const stbtt_fontinfo*) font->info, coverage, bounds.w, bounds.h, bounds.w, scale, scale, glyph);
+
+    silkFontBlit(canvas, rect, coverage + (size_t) (rect.y - bounds.y) * bounds.w + (rect.x - bounds.x), bounds.w, pix);
+
+    SILK_FREE(coverage);
+
+    return SILK_SUCCESS;
+}
+
+typedef struct {
+    silk_rect rect;     // Clipped glyph on the canvas
+    i32 offset;         // Start of it's coverage in the batch (-1: glyph too big for the atlas)
+    i32 glyph;
+    vec2i origin;       // Pen on the baseline
+} silk_font_blit;
+
+static i32 silkFontDrawText(silk_canvas* canvas, silk_font* font, const char* text, vec2i position, i32 font_size, pixel pix) {
+    u8 batch[SILK_FONT_BATCH_SIZE];
+    silk_font_blit blits[SILK_FONT_BATCH_GLYPHS];
+
+    f32 scale = stbtt_ScaleForPixelHeight((const stbtt_fontinfo*) font->info, (f32) font_size);
+    i32 baseline = position.y + (i32) floorf((f32) font->ascent * scale + 0.5f);
+    silk_rect clip = silkCanvasClip(canvas);
+
+    silkFontLock();
+
+    silk_font_run* run = silkFontInitAtlas() == SILK_SUCCESS ? silkFontGetRun(font, text, font_size) : NULL;
+    silk_font_atlas.clock++;
+
+    silkFontUnlock();
+
+    if(run == NULL) {
+        return SILK_FAILURE;
+    }
+
+    for(i32 index = 0; index < run->count; ) {
+        i32 count = 0;
+        i32 used = 0;
+
+        silkFontLock();
+
+        for(; index < run->count && count < SILK_FONT_BATCH_GLYPHS; index++) {
+            silk_font_run_glyph placed = run->glyphs[index];
+            silk_font_glyph* glyph = silkFontGetGlyph(font, placed.glyph, font_size, scale);
+            vec2i origin = { position.x + placed.x, baseline + placed.y };
+
+            if(glyph == NULL) {
+                blits[count++] = (silk_font_blit) { { 0 }, -1, placed.glyph, origin };
+
+                continue;
+            }
+
+            silk_rect bounds = { origin.x + glyph->offset_x, origin.y + glyph->offset_y, glyph->w, glyph->h };
+            silk_rect rect = silkRectIntersect(clip, bounds);
+
+            if(rect.w == 0 || rect.h == 0) {
+                continue;
+            }
+
+            if(used + rect.w * rect.h > SILK_FONT_BATCH_SIZE) {
+                break;
+            }
+
+            const u8* source = silk_font_atlas.pixels + (size_t) (glyph->y + rect.y - bounds.y) * SILK_FONT_ATLAS_SIZE + glyph->x + (rect.x - bounds.x);
+
+            for(i32 y = 0; y < rect.h; y++) {
+                memcpy(batch + used + y * rect.w, source + (size_t) y * SILK_FONT_ATLAS_SIZE, (size_t) rect.w);
+            }
+
+            blits[count++] = (silk_font_blit) { rect, used, placed.glyph, origin };
+            used += rect.w * rect.h;
+        }
+
+        silkFontUnlock();
+
+        for(i32 i = 0; i < count; i++) {
+            if(blits[i].offset >= 0) {
+                silkFontBlit(canvas, blits[i].rect, batch + blits[i].offset, blits[i].rect.w, pix);
+            } else {
+                silkFontBlitUncached(canvas, font, blits[i].glyph, scale, blits[i].origin, pix);
+            }
+        }
+    }
+
+    silkFontLock();
+    silkFontReleaseRun(run);
+    silkFontUnlock();
+
+    return SILK_SUCCESS;
+}
+
+#endif // SILK_INCLUDE_MODULE_STB_TRUETYPE
+
+// Signed distance fields:
+// Every glyph is stored as the distance of it's texels to the nearest edge of the glyph: 128 on the edge, rising inside and
+// falling outside, saturated 'SILK_SDF_SPREAD' atlas pixels away from it. Sampling the field bilinearly gives the distance
+// at any point of the glyph, so one atlas draws the text at any scale: the pixels closer than half a pixel to the edge
+// get the partial coverage, the rest are either inside or outside of the glyph.
+// Source: https://steamcdn-a.akamaihd.net/apps/valve/2007/SIGGRAPH2007_AlphaTestedMagnification.pdf
+
+static u8 silkSDFValue(f32 distance) {
+    f32 value = 128.0f + distance * (128.0f / SILK_SDF_SPREAD);
+
+    return (u8) (value < 0.0f ? 0.0f : (value > 255.0f ? 255.0f : value + 0.5f));
+}
+
+// Distance field of the bitmap font's glyph, 'cell' pixels per font cell. Cells are squares, so the exact distance of
+// the texel is the distance to the nearest cell of the opposite kind (the area around the glyph counts as the empty cells).
+static void silkSDFFromBitmap(const u8* rows, vec2i glyph_size, i32 cell, u8* field, vec2i field_size) {
+    f32 width = (f32) (glyph_size.x * cell);
+    f32 height = (f32) (glyph_size.y * cell);
+
+    for(i32 y = 0; y < field_size.y; y++) {
+        for(i32 x = 0; x < field_size.x; x++) {
+            f32 px = (f32) (x - SILK_SDF_SPREAD) + 0.5f;
+            f32 py = (f32) (y - SILK_SDF_SPREAD) + 0.5f;
+
+            bool inside = px > 0.0f && py > 0.0f && px < width && py < height &&
+                ((rows[(i32) py / cell] >> ((i32) px / cell)) & 1);
+
+            // Inside texels are bounded by the edges of the glyph's box as well
+            f32 nearest = inside ? fminf(fminf(px, width - px), fminf(py, height - py)) : (f32) SILK_SDF_SPREAD;
+            nearest = nearest < (f32) SILK_SDF_SPREAD ? nearest : (f32) SILK_SDF_SPREAD;
+
+            for(i32 cy = 0; cy < glyph_size.y; cy++) {
+                for(i32 cx = 0; cx < glyph_size.x; cx++) {
+                    if((bool) ((rows[cy] >> cx) & 1) == inside) {
+                        continue;
+                    }
+
+                    f32 x0 = (f32) (cx * cell);
+                    f32 y0 = (f32) (cy * cell);
+                    f32 dx = fmaxf(fmaxf(x0 - px, 0.0f), px - (x0 + (f32) cell));
+                    f32 dy = fmaxf(fmaxf(y0 - py, 0.0f), py - (y0 + (f32) cell));
+                    f32 distance = sqrtf(dx * dx + dy * dy);
+
+                    nearest = distance < nearest ? distance : nearest;
+                }
+            }
+
+            field[(size_t) y * field_size.x + x] = silkSDFValue(inside ? nearest : -nearest);
+        }
+    }
+}
+
+// Packs the fields of the glyphs (their sizes are already set) into the rows of the atlas, and frees them.
+// Glyph with the size, but without the field, is the field that couldn't be allocated.
+static i32 silkSDFPackAtlas(silk_sdf_font* font, u8** fields) {
+    vec2i pen = { 0 };
+    i32 row_height = 0;
+    bool missing = false;
+
+    for(i32 i = 0; i < font->glyph_count; i++) {
+        missing = missing || (fields[i] == NULL && font->glyphs[i].size.x > 0);
+    }
+
+    for(i32 i = 0; i < font->glyph_count && !missing; i++) {
+        silk_sdf_glyph* glyph = &font->glyphs[i];
+
+        if(fields[i] == NULL) {
+            continue;
+        }
+
+        if(pen.x + glyph->size.x > SILK_SDF_ATLAS_WIDTH) {
+            pen = (vec2i) { 0, pen.y + row_height };
+            row_height = 0;
+        }
+
+        glyph->position = pen;
+        pen.x += glyph->size.x;
+        row_height = glyph->size.y > row_height ? glyph->size.y : row_height;
+    }
+
+    font->atlas_size = (vec2i) { SILK_SDF_ATLAS_WIDTH, pen.y + row_height };
+    font->atlas = missing ? NULL : (u8*) SILK_CALLOC((size_t) font->atlas_size.x * (font->atlas_size.y > 0 ? font->atlas_size.y : 1), 1);
+
+    for(i32 i = 0; i < font->glyph_count; i++) {
+        silk_sdf_glyph* glyph = &font->glyphs[i];
+
+        for(i32 y = 0; font->atlas != NULL && fields[i] != NULL && y < glyph->size.y; y++) {
+            memcpy(
+                font->atlas + (size_t) (glyph->position.y + y) * font->atlas_size.x + glyph->position.x,
+                fields[i] + (size_t) y * glyph->size.x,
+                (size_t) glyph->size.x
+            );
+        }
+
+        SILK_FREE(fields[i]);
+    }
+
+    if(font->atlas == NULL) {
+        silkAssignErrorMessage(SILK_ERR_ALLOCATION_FAIL);
+
+        return SILK_FAILURE;
+    }
+
+    return SILK_SUCCESS;
+}
+
+// Draws the glyph's field scaled by 'scale', with it's top-left corner at 'corner'
+static i32 silkBlitSDFGlyph(silk_canvas* canvas, silk_rect clip, const silk_sdf_font* font, const silk_sdf_glyph* glyph, vec2f corner, f32 scale, pixel pix) {
+    f32 right = corner.x + (f32) glyph->size.x * scale;
+    f32 bottom = corner.y + (f32) glyph->size.y * scale;
+
+    // Compared in floats first, so the glyphs far off the canvas don't overflow the pixel coordinates
+    if(right <= (f32) clip.x || bottom <= (f32) clip.y || corner.x >= (f32) (clip.x + clip.w) || corner.y >= (f32) (clip.y + clip.h)) {
+        return SILK_SUCCESS;
+    }
+
+    i32 x0 = corner.x > (f32) clip.x ? (i32) floorf(corner.x) : clip.x;
+    i32 y0 = corner.y > (f32) clip.y ? (i32) floorf(corner.y) : clip.y;
+    i32 x1 = right < (f32) (clip.x + clip.w) ? (i32) ceilf(right) : clip.x + clip.w;
+    i32 y1 = bottom < (f32) (clip.y + clip.h) ? (i32) ceilf(bottom) : clip.y + clip.h;
+
+    silkMarkDirty(canvas, (silk_rect) { x0, y0, x1 - x0, y1 - y0 });
+
+    // Pixel centers are mapped onto the texel centers of the field (16.16 fixed point), clamped to the glyph's rectangle.
+    // Columns are stepped from the left edge of the glyph, not of the clip, so the tiles of 'silkFlush' sample the same texels.
+    // Distance (in the 8.8 field units) is turned into the coverage by 'gain': half a pixel inside is fully covered.
+    i64 step = (i64) (65536.0f / scale);
+    i64 left = (i64) floorf(corner.x);
+    i64 u_left = (i64) ((((f32) left + 0.5f - corner.x) / scale - 0.5f) * 65536.0f);
+    i32 max_u = (glyph->size.x - 1) << 16;
+    i32 max_v = (glyph->size.y - 1) << 16;
+    i64 gain = (i64) ((f32) SILK_SDF_SPREAD * scale * (255.0f / 128.0f) * 256.0f);
+    u8 coverage[SILK_SPAN_CHUNK];
+
+    for(i32 y = y0; y < y1; y++) {
+        f32 v_start = (((f32) y + 0.5f - corner.y) / scale - 0.5f) * 65536.0f;
+        i32 v = v_start < 0.0f ? 0 : (v_start > (f32) max_v ? max_v : (i32) v_start);
+        i32 fy = (v >> 8) & 0xff;
+        i32 ty = v >> 16;
+
+        const u8* row0 = font->atlas + (size_t) (glyph->position.y + ty) * font->atlas_size.x + glyph->position.x;
+        const u8* row1 = ty + 1 < glyph->size.y ? row0 + font->atlas_size.x : row0;
+
+        for(i32 x = x0; x < x1; x += SILK_SPAN_CHUNK) {
+            i32 count = x1 - x < SILK_SPAN_CHUNK ? x1 - x : SILK_SPAN_CHUNK;
+            i64 u = u_left + (x - left) * step;
+
+            for(i32 i = 0; i < count; i++, u += step) {
+                i32 clamped = u < 0 ? 0 : (u > max_u ? max_u : (i32) u);
+                i32 fx = (clamped >> 8) & 0xff;
+                i32 tx = clamped >> 16;
+                i32 next = tx + 1 < glyph->size.x ? tx + 1 : tx;
+
+                i32 top = row0[tx] * (256 - fx) + row0[next] * fx;
+                i32 low = row1[tx] * (256 - fx) + row1[next] * fx;
+                i32 value = (top * (256 - fy) + low * fy) >> 8;
+
+                i64 cover = (((i64) (value - 32768) * gain) >> 16) + 128;
+                coverage[i] = (u8) (cover < 0 ? 0 : (cover > 255 ? 255 : cover));
+            }
+
+            silkWriteCoverageSpan(canvas, x, y, coverage, count, pix);
+        }
+    }
+
+    return SILK_SUCCESS;
+}
+
+// --------------------------------------------------------------------------------------------------------------------------------
+// SECTION: API
+// --------------------------------------------------------------------------------------------------------------------------------
+
+// --------------------------------------------------------------------------------------------------------------------------------
+// SECTION MODULE: Canvas
+// --------------------------------------------------------------------------------------------------------------------------------
+
+SILK_API silk_canvas silkLoadCanvas(vec2i size) {
+    return silkLoadCanvasFormat(size, SILK_PIXELFORMAT_RGBA8888);
+}
+
+SILK_API silk_canvas silkLoadCanvasFormat(vec2i size, i32 format) {
+    if(format < 0 || format >= SILK_PIXELFORMAT_COUNT) {
+        silkAssignErrorMessage(SILK_ERR_PIXEL_FORMAT_INVALID);
+
+        return (silk_canvas) { 0 };
+    }
+
+    if(size.x <= 0 || size.y <= 0) {
+        silkAssignErrorMessage(SILK_ERR_CANVAS_INVALID_SIZE);
+
+        return (silk_canvas) { 0 };
+    }
+
+    // Every row starts on it's own cache-line...
+    i32 stride = (size.x * silk_pixel_format_sizes[format] + SILK_CANVAS_ALIGNMENT - 1) & ~(SILK_CANVAS_ALIGNMENT - 1);
+
+    // ... and if the stride is a multiple of 4 KB, the same column of the neighbouring rows lands at the same
+    // 4 KB offset (4K-aliasing), which stalls loads behind stores. One extra cache-line per row breaks that pattern.
+    if(size.y > 1 && stride % 4096 == 0) {
+        stride += SILK_CANVAS_ALIGNMENT;
+    }
+
+    silk_canvas result = { 0 };
+    result.memory = SILK_MALLOC((size_t) stride * size.y + SILK_CANVAS_ALIGNMENT);
+
+    if(result.memory == NULL) {
+        silkAssignErrorMessage(SILK_ERR_ALLOCATION_FAIL);
+
+        return (silk_canvas) { 0 };
+    }
+
+    result.data = (u8*) (((uintptr_t) result.memory + SILK_CANVAS_ALIGNMENT - 1) & ~(uintptr_t) (SILK_CANVAS_ALIGNMENT - 1));
+    result.size = size;
+    result.stride = stride;
+    result.format = format;
+
+    silkFillRegion(&result, size, 0);
+
+    return result;
+}
+
+SILK_API silk_canvas silkCanvasFromBuffer(void* buffer, vec2i size, i32 stride) {
+    return silkCanvasFromBufferFormat(buffer, size, stride, SILK_PIXELFORMAT_RGBA8888);
+}
+
+SILK_API silk_canvas silkCanvasFromBufferFormat(void* buffer, vec2i size, i32 stride, i32 format) {
+    if(buffer == NULL) {
+        silkAssignErrorMessage(SILK_ERR_BUF_INVALID);
+
+        return (silk_canvas) { 0 };
+    }
+
+    if(format < 0 || format >= SILK_PIXELFORMAT_COUNT) {
+        silkAssignErrorMessage(SILK_ERR_PIXEL_FORMAT_INVALID);
+
+        return (silk_canvas) { 0 };
+    }
+
+    if(size.x <= 0 || size.y <= 0 || stride < size.x * silk_pixel_format_sizes[format]) {
+        silkAssignErrorMessage(SILK_ERR_CANVAS_INVALID_SIZE);
+
+        return (silk_canvas) { 0 };
+    }
+
+    silk_canvas result = { 0 };
+    result.data = (u8*) buffer;
+    result.size = size;
+    result.stride = stride;
+    result.format = format;
+
+    return result;
+}
+
+SILK_API i32 silkPixelFormatSize(i32 format) {
+    if(format < 0 || format >= SILK_PIXELFORMAT_COUNT) {
+        silkAssignErrorMessage(SILK_ERR_PIXEL_FORMAT_INVALID);
+
+        return 0;
+    }
+
+    return silk_pixel_format_sizes[format];
+}
+
+SILK_API i32 silkConvertPixels(const void* src, i32 src_format, i32 src_stride, void* dest, i32 dest_format, i32 dest_stride, silk_rect rect) {
+    if(src == NULL || dest == NULL) {
+        silkAssignErrorMessage(SILK_ERR_BUF_INVALID);
+
+        return SILK_FAILURE;
+    }
+
+    if(src_format < 0 || src_format >= SILK_PIXELFORMAT_COUNT || dest_format < 0 || dest_format >= SILK_PIXELFORMAT_COUNT) {
+        silkAssignErrorMessage(SILK_ERR_PIXEL_FORMAT_INVALID);
+
+        return SILK_FAILURE;
+    }
+
+    i32 src_size = silk_pixel_format_sizes[src_format];
+    i32 dest_size = silk_pixel_format_sizes[dest_format];
+
+    // Rectangle is in the same place in both of the buffers, and it can't reach past the end of their rows
+    if(rect.x < 0 || rect.y < 0 || rect.w < 0 || rect.h < 0 ||
+       (i64) (rect.x + (i64) rect.w) * src_size > src_stride || (i64) (rect.x + (i64) rect.w) * dest_size > dest_stride) {
+        silkAssignErrorMessage(SILK_ERR_BUF_ACCESS_OUT_OF_BOUNDS);
+
+        return SILK_FAILURE;
+    }
+
+    silk_kernel_table* kernels = silkGetKernels();
+    pixel scratch[SILK_SPAN_CHUNK];
+
+    // Conversions from and to RGBA8888 are a single pass over the row; the other ones go through it, one chunk at a time
+    for(i32 y = rect.y; y < rect.y + rect.h; y++) {
+        const u8* src_row = (const u8*) src + (size_t) y * src_stride + (size_t) rect.x * src_size;
+        u8* dest_row = (u8*) dest + (size_t) y * dest_stride + (size_t) rect.x * dest_size;
+
+        if(src_format == dest_format) {
+            memcpy(dest_row, src_row, (size_t) rect.w * src_size);
+        } else if(src_format == SILK_PIXELFORMAT_RGBA8888) {
+            kernels->pack[dest_format](dest_row, src_row, rect.w);
+        } else if(dest_format == SILK_PIXELFORMAT_RGBA8888) {
+            kernels->unpack[src_format](dest_row, src_row, rect.w);
+        } else {
+            for(i32 x = 0; x < rect.w; x += SILK_SPAN_CHUNK) {
+                i32 chunk = rect.w - x < SILK_SPAN_CHUNK ? rect.w - x : SILK_SPAN_CHUNK;
+
+                kernels->unpack[src_format](scratch, src_row + (size_t) x * src_size, chunk);
+                kernels->pack[dest_format](dest_row + (size_t) x * dest_size, scratch, chunk);
+            }
+        }
+    }
+
+    return SILK_SUCCESS;
+}
+
+SILK_API image silkCanvasToImage(silk_canvas* canvas) {
+    if(canvas == NULL || canvas->data == NULL) {
+        silkAssignErrorMessage(SILK_ERR_BUF_INVALID);
+
+        return (image) { 0 };
+    }
+
+    image result;
+    result.size = canvas->size;
+    result.data = (pixel*) SILK_MALLOC(canvas->size.x * canvas->size.y * sizeof(pixel));
+    result.channels = 4;
+
+    if(result.data == NULL) {
+        silkAssignErrorMessage(SILK_ERR_ALLOCATION_FAIL);
+        return (image) { 0 };
+    }
+
+    // Images are always tightly packed RGBA8888, so the padding of the canvas rows is dropped here (and the pixels are converted)
+    for(i32 y = 0; y < canvas->size.y; y++) {
+        silkGetKernels()->unpack[canvas->format](
+            result.data + y * canvas->size.x,
+            silkCanvasAddress(canvas, 0, y),
+            canvas->size.x
+        );
+    }
+
+    return result;
+}
+
+SILK_API i32 silkUnloadCanvas(silk_canvas* canvas) {
+    if(canvas == NULL) {
+        silkAssignErrorMessage(SILK_ERR_BUF_INVALID);
+
+        return SILK_FAILURE;
+    }
+
+    if(canvas->memory != NULL) {
+        SILK_FREE(canvas->memory);
+    }
+
+    *canvas = (silk_canvas) { 0 };
+
+    return SILK_SUCCESS;
+}
+
+SILK_API i32 silkPushClipRect(silk_canvas* canvas, silk_rect rect) {
+    if(canvas != NULL && canvas->recording != NULL) {
+        silk_command command = silkCommandInit(SILK_COMMAND_PUSH_CLIP, 0);
+        command.args.clip = rect;
+
+        return silkRecordCommand(canvas, command, NULL, 0, NULL, 0);
+    }
+
+    if(canvas == NULL) {
+        silkAssignErrorMessage(SILK_ERR_BUF_INVALID);
+
+        return SILK_FAILURE;
+    }
+
+    if(canvas->clip_count >= SILK_CLIP_STACK_SIZE) {
+        silkAssignErrorMessage(SILK_ERR_CLIP_STACK_OVERFLOW);
+
+        return SILK_FAILURE;
+    }
+
+    if(rect.w < 0) {
+        rect.w = 0;
+    }
+
+    if(rect.h < 0) {
+        rect.h = 0;
+    }
+
+    // Nested clip rectangles can only shrink the drawable area
+    canvas->clip_stack[canvas->clip_count] = silkRectIntersect(silkCanvasClip(canvas), rect);
+    canvas->clip_count++;
+
+    return SILK_SUCCESS;
+}
+
+SILK_API i32 silkPopClipRect(silk_canvas* canvas) {
+    if(canvas != NULL && canvas->recording != NULL) {
+        silk_command command = silkCommandInit(SILK_COMMAND_POP_CLIP, 0);
+
+        return silkRecordCommand(canvas, command, NULL, 0, NULL, 0);
+    }
+
+    if(canvas == NULL) {
+        silkAssignErrorMessage(SILK_ERR_BUF_INVALID);
+
+        return SILK_FAILURE;
+    }
+
+    if(canvas->clip_count <= 0) {
+        silkAssignErrorMessage(SILK_ERR_CLIP_STACK_UNDERFLOW);
+
+        return SILK_FAILURE;
+    }
+
+    canvas->clip_count--;
+
+    return SILK_SUCCESS;
+}
+
+SILK_API silk_rect silkGetClipRect(silk_canvas* canvas) {
+    if(canvas == NULL) {
+        silkAssignErrorMessage(SILK_ERR_BUF_INVALID);
+
+        return (silk_rect) { 0 };
+    }
+
+    return silkCanvasClip(canvas);
+}
+
+SILK_API i32 silkSetBlendMode(silk_canvas* canvas, i32 mode) {
+    // Invalid mode is reported right away, even while recording
+    if(mode < 0 || mode >= SILK_BLEND_MODE_COUNT) {
+        silkAssignErrorMessage(SILK_ERR_BLEND_MODE_INVALID);
+
+        return SILK_FAILURE;
+    }
+
+    if(canvas != NULL && canvas->recording != NULL) {
+        silk_command command = silkCommandInit(SILK_COMMAND_BLEND_MODE, 0);
+        command.args.blend_mode = mode;
+
+        return silkRecordCommand(canvas, command, NULL, 0, NULL, 0);
+    }
+
+    if(canvas == NULL) {
+        silkAssignErrorMessage(SILK_ERR_BUF_INVALID);
+
+        return SILK_FAILURE;
+    }
+
+    canvas->blend_mode = mode;
+
+    return SILK_SUCCESS;
+}
+
+SILK_API i32 silkGetBlendMode(silk_canvas* canvas) {
+    if(canvas == NULL) {
+        silkAssignErrorMessage(SILK_ERR_BUF_INVALID);
+
+        return SILK_BLEND_MODE_ALPHA;
+    }
+
+    return canvas->blend_mode;
+}
+
+SILK_API i32 silkGetDirtyRectCount(silk_canvas* canvas) {
+    if(canvas == NULL) {
+        silkAssignErrorMessage(SILK_ERR_BUF_INVALID);
+
+        return 0;
+    }
+
+    return canvas->dirty_count;
+}
+
+SILK_API silk_rect silkGetDirtyRect(silk_canvas* canvas, i32 index) {
+    if(canvas == NULL) {
+        silkAssignErrorMessage(SILK_ERR_BUF_INVALID);
+
+        return (silk_rect) { 0 };
+    }
+
+    if(index < 0 || index >= canvas->dirty_count) {
+        silkAssignErrorMessage(SILK_ERR_OUT_OF_BOUNDS);
+
+        return (silk_rect) { 0 };
+    }
+
+    return canvas->dirty_rects[index];
+}
+
+SILK_API i32 silkAddDirtyRect(silk_canvas* canvas, silk_rect rect) {
+    if(canvas == NULL) {
+        silkAssignErrorMessage(SILK_ERR_BUF_INVALID);
+
+        return SILK_FAILURE;
+    }
+
+    // For the pixels written around Silk, straight into the buffer (it's cut to the canvas, but not to the clip rectangle)
+    return silkMarkDirty(canvas, rect);
+}
+
+SILK_API i32 silkResetDirtyRects(silk_canvas* canvas) {
+    if(canvas == NULL) {
+        silkAssignErrorMessage(SILK_ERR_BUF_INVALID);
+
+        return SILK_FAILURE;
+    }
+
+    canvas->dirty_count = 0;
+
+    return SILK_SUCCESS;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------------------
+// SECTION MODULE: Pixel buffer
+// --------------------------------------------------------------------------------------------------------------------------------
+
+SILK_API i32 silkClearPixelBuffer(silk_canvas* canvas) {
+    if(canvas != NULL && canvas->recording != NULL) {
+        silk_command command = silkCommandInit(SILK_COMMAND_CLEAR, 0);
+
+        return silkRecordCommand(canvas, command, NULL, 0, NULL, 0);
+    }
+
+    if(canvas == NULL || canvas->data == NULL) {
+        silkAssignErrorMessage(SILK_ERR_BUF_INVALID);
+
+        return SILK_FAILURE;
+    }
+
+    silkMarkDirty(canvas, (silk_rect) { 0, 0, canvas->size.x, canvas->size.y });
+    silkFillRegion(canvas, canvas->size, 0);
+
+    return SILK_SUCCESS;
+}
+
+SILK_API i32 silkClearPixelBufferRegion(silk_canvas* canvas, vec2i region) {
+    if(canvas != NULL && canvas->recording != NULL) {
+        silk_command command = silkCommandInit(SILK_COMMAND_CLEAR_REGION, 0);
+        command.args.region = region;
+
+        return silkRecordCommand(canvas, command, NULL, 0, NULL, 0);
+    }
+
+    if(canvas == NULL || canvas->data == NULL) {
+        silkAssignErrorMessage(SILK_ERR_BUF_INVALID);
+
+        return SILK_FAILURE;
+    }
+
+    silkMarkDirty(canvas, (silk_rect) { 0, 0, region.x, region.y });
+    silkFillRegion(canvas, region, 0);
+
+    return SILK_SUCCESS;
+}
+
+SILK_API i32 silkClearPixelBufferColor(silk_canvas* canvas, pixel pix) {
+    if(canvas != NULL && canvas->recording != NULL) {
+        silk_command command = silkCommandInit(SILK_COMMAND_CLEAR, pix);
+
+        return silkRecordCommand(canvas, command, NULL, 0, NULL, 0);
+    }
+
+    if(canvas == NULL || canvas->data == NULL) {
+        silkAssignErrorMessage(SILK_ERR_BUF_INVALID);
+
+        return SILK_FAILURE;
+    }
+
+    silkMarkDirty(canvas, (silk_rect) { 0, 0, canvas->size.x, canvas->size.y });
+    silkFillRegion(canvas, canvas->size, pix);
+
+    return SILK_SUCCESS;
+}
+
+SILK_API i32 silkClearPixelBufferColorRegion(silk_canvas* canvas, vec2i region, pixel pix) {
+    if(canvas != NULL && canvas->recording != NULL) {
+        silk_command command = silkCommandInit(SILK_COMMAND_CLEAR_REGION, pix);
+        command.args.region = region;
+
+        return silkRecordCommand(canvas, command, NULL, 0, NULL, 0);
+    }
+
+    if(canvas == NULL || canvas->data == NULL) {
+        silkAssignErrorMessage(SILK_ERR_BUF_INVALID);
+
+        return SILK_FAILURE;
+    }
+
+    silkMarkDirty(canvas, (silk_rect) { 0, 0, region.x, region.y });
+    silkFillRegion(canvas, region, pix);
+
+    return SILK_SUCCESS;
+}
+
+SILK_API pixel silkGetPixel(pixel* buffer, vec2i position, i32 stride) {
+    return buffer[position.y * stride + position.x];
+}
+
+SILK_API i32 silkSetPixel(pixel* buffer, vec2i position, i32 stride, pixel pix) {
+    buffer[position.y * stride + position.x] = pix;
+
+    return SILK_SUCCESS;
+}
+
+SILK_API i32 silkUnloadBuffer(pixel* buffer) {
+    if(buffer == NULL) {
+        silkAssignErrorMessage(SILK_ERR_BUF_INVALID);
+
+        return SILK_FAILURE;
+    }
+
+    SILK_FREE(buffer);
+
+    return SILK_SUCCESS;
+}
+
+// --------------------------------------------------------------------------------------------------------------------------------
+// SECTION MODULE: Pixels and Colors
+// --------------------------------------------------------------------------------------------------------------------------------
+
+SILK_API color silkPixelToColor(pixel pix) {
+    color result = { 0 };
+
+#if defined(SILK_PREMULTIPLIED_ALPHA)
+
+    // Colors are always the straight ones
+    pix = silkPixelUnpremultiply(pix);
+
+#endif // SILK_PREMULTIPLIED_ALPHA
+
+#if defined(SILK_BYTEORDER_LITTLE_ENDIAN)
+
+    result.r = (pix >> 8 * 0) & 0xFF;
+    result.g = (pix >> 8 * 1) & 0xFF;
+    result.b = (pix >> 8 * 2) & 0xFF;
+    result.a = (pix >> 8 * 3) & 0xFF;
+
+#elif defined(SILK_BYTEORDER_BIG_ENDIAN)
+
+    result.r = (pix >> 8 * 3) & 0xFF;
+    result.g = (pix >> 8 * 2) & 0xFF;
+    result.b = (pix >> 8 * 1) & 0xFF;
+    result.a = (pix >> 8 * 0) & 0xFF;
+
+#endif
+
+    return result;
+}
+
+SILK_API pixel silkColorToPixel(color col) {
+    pixel result = 0;
+
+#if defined(SILK_BYTEORDER_LITTLE_ENDIAN)
+
+    result =
+        col.r       |
+        col.g << 8  |
+        col.b << 16 |
+        col.a << 24;
+
+#elif defined(SILK_BYTEORDER_BIG_ENDIAN)
+
+    result =
+        col.r << 24 |
+        col.g << 16 |
+        col.b << 8  |
+        col.a;
+
+#endif
+
+#if defined(SILK_PREMULTIPLIED_ALPHA)
+
+    result = silkPixelPremultiply(result);
+
+#endif // SILK_PREMULTIPLIED_ALPHA
+
+    return result;
+}
+
+SILK_API pixel silkAlphaBlend(pixel base_pixel, pixel return_pixel, color_channel value) {
+    if((return_pixel & SILK_PIXEL_ALPHA_MASK) == 0) {
+        return base_pixel;
+    }
+
+#if defined(SILK_PREMULTIPLIED_ALPHA)
+
+    // Premultiplied pixel is faded by the 'value' first, and then laid over with it's own (faded) alpha
+    pixel faded = silkScalePixel(return_pixel, value);
+
+    return silkBlendPixel(base_pixel, faded, (faded & SILK_PIXEL_ALPHA_MASK) >> SILK_PIXEL_ALPHA_SHIFT);
+
+#else
+
+    // Exact integer "source-over"; the resulting alpha is 'value + base_alpha * (255 - value) / 255' (see: 'silkBlendPixel')
+    return silkBlendPixel(base_pixel, return_pixel, value);
+
+#endif // SILK_PREMULTIPLIED_ALPHA
+}
+
+SILK_API pixel silkPixelFade(pixel pix, f32 factor) {
+    color result = { 0 };
+
+    result.r = silkPixelToColor(pix).r;
+    result.g = silkPixelToColor(pix).g;
+    result.b = silkPixelToColor(pix).b;
+    result.a = factor * 255;
+
+    return silkColorToPixel(result);
+}
+
+SILK_API pixel silkPixelTint(pixel pix, pixel tint) {
+    pixel result = 0;
+
+    // Channels are multiplied as they're stored: the product of two premultiplied colors is premultiplied as well
+    for(i32 shift = 0; shift < 32; shift += 8) {
+        result |= (((pix >> shift) & 0xff) * ((tint >> shift) & 0xff) / 255) << shift;
+    }
+
+    return result;
+}
+
+SILK_API pixel silkPixelPremultiply(pixel pix) {
+    u32 alpha = (pix & SILK_PIXEL_ALPHA_MASK) >> SILK_PIXEL_ALPHA_SHIFT;
+
+    return (silkScalePixel(pix, alpha) & ~SILK_PIXEL_ALPHA_MASK) | (pix & SILK_PIXEL_ALPHA_MASK);
+}
+
+SILK_API pixel silkPixelUnpremultiply(pixel pix) {
+    u32 alpha = (pix & SILK_PIXEL_ALPHA_MASK) >> SILK_PIXEL_ALPHA_SHIFT;
+
+    if(alpha == 0) {
+        return 0;
+    }
+
+    pixel result = pix & SILK_PIXEL_ALPHA_MASK;
+
+    for(i32 shift = 0; shift < 32; shift += 8) {
+        if(shift == SILK_PIXEL_ALPHA_SHIFT) {
+            continue;
+        }
+
+        u32 channel = (((pix >> shift) & 0xff) * 255 + alpha / 2) / alpha;
+        result |= (channel > 255 ? 255 : channel) << shift;
+    }
+
+    return result;
+}
+
+SILK_API color_channel silkPixelChannelRed(pixel pix) {
+    
+#if defined(SILK_BYTEORDER_LITTLE_ENDIAN)
+
+    return (0x000000ff & pix) >> (8 * 0);
+
+#elif defined(SILK_BYTEORDER_BIG_ENDIAN)
+
+    return (0x000000ff & pix) >> (8 * 3);
+
+#endif
+
+}
+
+SILK_API color_channel silkPixelChannelGreen(pixel pix) {
+
+#if defined(SILK_BYTEORDER_LITTLE_ENDIAN)
+
+    return (0x0000ff00 & pix) >> (8 * 0);
+
+#elif defined(SILK_BYTEORDER_BIG_ENDIAN)
+
+    return (0x0000ff00 & pix) >> (8 * 3);
+
+#endif
+
+}
+
+SILK_API color_channel silkPixelChannelBlue(pixel pix) {
+
+#if defined(SILK_BYTEORDER_LITTLE_ENDIAN)
+
+    return (0x00ff0000 & pix) >> (8 * 0);
+
+#elif defined(SILK_BYTEORDER_BIG_ENDIAN)
+
+    return (0x00ff0000 & pix) >> (8 * 3);
+
+#endif
+
+}
+
+SILK_API color_channel silkPixelChannelAlpha(pixel pix) {
+
+#if defined(SILK_BYTEORDER_LITTLE_ENDIAN)
+
+    return (0xff000000 & pix) >> (8 * 0);
+
+#elif defined(SILK_BYTEORDER_BIG_ENDIAN)
+
+    return (0xff000000 & pix) >> (8 * 3);
 
 #endif
 
 }
 
 // --------------------------------------------------------------------------------------------------------------------------------
-// SECTION MODULE: Rendering
+// SECTION MODULE: Rendering
+// --------------------------------------------------------------------------------------------------------------------------------
+
+SILK_API i32 silkDrawPixel(silk_canvas* canvas, vec2i position, pixel pix) {
+    if(canvas != NULL && canvas->recording != NULL) {
+        silk_command command = silkCommandInit(SILK_COMMAND_PIXEL, pix);
+        command.args.points.a = position;
+        command.args.points.b = position;
+        command.args.points.c = position;
+
+        return silkRecordCommand(canvas, command, NULL, 0, NULL, 0);
+    }
+
+    if(canvas == NULL || canvas->data == NULL) {
+        silkAssignErrorMessage(SILK_ERR_BUF_INVALID);
+
+        return SILK_FAILURE;
+    }
+
+    if( (position.x < 0 || position.x >= canvas->size.x) ||
+        (position.y < 0 || position.y >= canvas->size.y)) {
+        silkAssignErrorMessage(SILK_ERR_BUF_ACCESS_OUT_OF_BOUNDS);
+
+        return SILK_FAILURE;
+    }
+
+    // If the pixel from this position is the same as the color that overwrites it (or the color is fully transparent),
+    // we can return, as there won't be any change in this specific position.
+    if(silkPixelTransparent(canvas, pix) ||
+       (silkPixelOverwrites(canvas, pix) && canvas->format == SILK_PIXELFORMAT_RGBA8888 && *(pixel*) silkCanvasAddress(canvas, position.x, position.y) == pix)) {
+        return SILK_SUCCESS;
+    }
+
+    // Pixels outside of the clip rectangle aren't an error, they're simply not drawn
+    silk_rect clip = silkCanvasClip(canvas);
+    silkMarkDirtyBounds(canvas, &clip, position.x, position.y, position.x + 1, position.y + 1);
+
+    return silkPlotPixel(canvas, &clip, position.x, position.y, pix);
+}
+
+SILK_API i32 silkDrawLine(silk_canvas* canvas, vec2i start, vec2i end, pixel pix) {
+    if(canvas != NULL && canvas->recording != NULL) {
+        silk_command command = silkCommandInit(SILK_COMMAND_LINE, pix);
+        command.args.points.a = start;
+        command.args.points.b = end;
+        command.args.points.c = end;
+
+        return silkRecordCommand(canvas, command, NULL, 0, NULL, 0);
+    }
+
+    if(canvas == NULL || canvas->data == NULL) {
+        silkAssignErrorMessage(SILK_ERR_BUF_INVALID);
+
+        return SILK_FAILURE;
+    }
+
+    // Beyond this range the Bresenham's error term could overflow the 64-bit integers
+    if(start.x < -SILK_RASTER_MAX_COORD || start.x > SILK_RASTER_MAX_COORD || start.y < -SILK_RASTER_MAX_COORD || start.y > SILK_RASTER_MAX_COORD ||
+       end.x < -SILK_RASTER_MAX_COORD || end.x > SILK_RASTER_MAX_COORD || end.y < -SILK_RASTER_MAX_COORD || end.y > SILK_RASTER_MAX_COORD) {
+        silkAssignErrorMessage(SILK_ERR_OUT_OF_BOUNDS);
+
+        return SILK_FAILURE;
+    }
+
+    i32 left = start.x < end.x ? start.x : end.x;
+    i32 top = start.y < end.y ? start.y : end.y;
+    i32 right = (start.x > end.x ? start.x : end.x) + 1;
+    i32 bottom = (start.y > end.y ? start.y : end.y) + 1;
+
+    silk_rect clip = silkCanvasClip(canvas);
+    i32 clip_test = silkClipBounds(&clip, left, top, right, bottom);
+
+    if(clip_test == SILK_CLIP_OUTSIDE || silkPixelTransparent(canvas, pix)) {
+        return SILK_SUCCESS;
+    }
+
+    silkMarkDirtyBounds(canvas, &clip, left, top, right, bottom);
+
+    i64 dx = (i64) end.x - start.x;
+    i64 dy = (i64) end.y - start.y;
+    i64 abs_dx = dx < 0 ? -dx : dx;
+    i64 abs_dy = dy < 0 ? -dy : dy;
+
+    // Line is walked along it's longer (major) axis, one pixel per step
+    bool steep = abs_dy > abs_dx;
+
+    silk_line line = { 0 };
+    line.major_start = steep ? start.y : start.x;
+    line.minor_start = steep ? start.x : start.y;
+    line.major_sign = (steep ? dy : dx) < 0 ? -1 : 1;
+    line.minor_sign = (steep ? dx : dy) < 0 ? -1 : 1;
+    line.major_len = steep ? abs_dy : abs_dx;
+    line.minor_len = steep ? abs_dx : abs_dy;
+    line.first = 0;
+    line.last = line.major_len;
+
+    if(line.major_len == 0) {
+        return silkPlotPixel(canvas, NULL, start.x, start.y, pix);
+    }
+
+    if(clip_test == SILK_CLIP_PARTIAL) {
+        i32 major_low = steep ? clip.y : clip.x;
+        i32 major_high = steep ? clip.y + clip.h - 1 : clip.x + clip.w - 1;
+        i32 minor_low = steep ? clip.x : clip.y;
+        i32 minor_high = steep ? clip.x + clip.w - 1 : clip.y + clip.h - 1;
+
+        if(!silkLineClip(&line, major_low, major_high, minor_low, minor_high)) {
+            return SILK_SUCCESS;
+        }
+    }
+
+    return silkRasterLine(canvas, &line, steep, pix);
+}
+
+SILK_API i32 silkDrawLineAA(silk_canvas* canvas, vec2f start, vec2f end, pixel pix) {
+    if(canvas != NULL && canvas->recording != NULL) {
+        silk_command command = silkCommandInit(SILK_COMMAND_LINE_AA, pix);
+        command.args.points_float.a = start;
+        command.args.points_float.b = end;
+        command.args.points_float.c = end;
+
+        return silkRecordCommand(canvas, command, NULL, 0, NULL, 0);
+    }
+
+    if(canvas == NULL || canvas->data == NULL) {
+        silkAssignErrorMessage(SILK_ERR_BUF_INVALID);
+
+        return SILK_FAILURE;
+    }
+
+    // NOTE: The negated comparison rejects NaN as well
+    if(!(start.x >= -SILK_RASTER_MAX_COORD && start.x <= SILK_RASTER_MAX_COORD && start.y >= -SILK_RASTER_MAX_COORD && start.y <= SILK_RASTER_MAX_COORD &&
+         end.x >= -SILK_RASTER_MAX_COORD && end.x <= SILK_RASTER_MAX_COORD && end.y >= -SILK_RASTER_MAX_COORD && end.y <= SILK_RASTER_MAX_COORD)) {
+        silkAssignErrorMessage(SILK_ERR_OUT_OF_BOUNDS);
+
+        return SILK_FAILURE;
+    }
+
+#if !defined(SILK_ALPHABLEND_ENABLE)
+
+    // Without the alpha-blending there's no way to draw the partial coverage, so the line is simply aliased
+    return silkDrawLine(
+        canvas,
+        (vec2i) { (i32) floorf(start.x + 0.5f), (i32) floorf(start.y + 0.5f) },
+        (vec2i) { (i32) floorf(end.x + 0.5f), (i32) floorf(end.y + 0.5f) },
+        pix
+    );
+
+#else
+
+    // Endpoints move up to half a pixel (to the pixel centers) and cover two pixels across the line,
+    // so the last touched pixel can be two pixels after the largest coordinate
+    i32 left = (i32) floorf(start.x < end.x ? start.x : end.x) - 1;
+    i32 top = (i32) floorf(start.y < end.y ? start.y : end.y) - 1;
+    i32 right = (i32) floorf(start.x > end.x ? start.x : end.x) + 3;
+    i32 bottom = (i32) floorf(start.y > end.y ? start.y : end.y) + 3;
+
+    silk_rect clip = silkCanvasClip(canvas);
+    i32 clip_test = silkClipBounds(&clip, left, top, right, bottom);
+
+    if(clip_test == SILK_CLIP_OUTSIDE || silkPixelTransparent(canvas, pix)) {
+        return SILK_SUCCESS;
+    }
+
+    silkMarkDirtyBounds(canvas, &clip, left, top, right, bottom);
+
+    silk_rect* clip_ptr = clip_test == SILK_CLIP_INSIDE ? NULL : &clip;
+
+    bool steep = fabsf(end.y - start.y) > fabsf(end.x - start.x);
+
+    // Working in the (major, minor) coordinates, always stepping forward along the major axis
+    f32 major_a = steep ? start.y : start.x;
+    f32 minor_a = steep ? start.x : start.y;
+    f32 major_b = steep ? end.y : end.x;
+    f32 minor_b = steep ? end.x : end.y;
+
+    if(major_a > major_b) {
+        f32 temp = major_a; major_a = major_b; major_b = temp;
+        temp = minor_a; minor_a = minor_b; minor_b = temp;
+    }
+
+    f32 gradient = major_b - major_a == 0.0f ? 0.0f : (minor_b - minor_a) / (major_b - major_a);
+
+    i32 major_first;
+    i32 major_last;
+    f32 minor_first;
+    f32 minor_last;
+
+    silkPlotLineEndpoint(canvas, clip_ptr, steep, major_a, minor_a, gradient, pix, false, &major_first, &minor_first);
+    silkPlotLineEndpoint(canvas, clip_ptr, steep, major_b, minor_b, gradient, pix, true, &major_last, &minor_last);
+
+    // Pixels between the endpoints, limited to the visible part of the major axis
+    i32 from = major_first + 1;
+    i32 to = major_last - 1;
+
+    if(clip_ptr != NULL) {
+        i32 major_low = steep ? clip.y : clip.x;
+        i32 major_high = steep ? clip.y + clip.h - 1 : clip.x + clip.w - 1;
+
+        from = from < major_low ? major_low : from;
+        to = to > major_high ? major_high : to;
+    }
+
+    // Jumping over the clipped pixels in the fixed-point, so the visible ones are exactly the same as without the clipping
+    i64 minor_step = (i64) (gradient * 65536.0f);
+    i64 minor = (i64) (minor_first * 65536.0f) + minor_step * (from - major_first);
+
+    for(i32 major = from; major <= to; major++) {
+        i32 minor_pixel = (i32) (minor >> 16);
+        u32 fraction = (u32) (minor >> 8) & 0xff;
+
+        silkPlotLineCoverage(canvas, clip_ptr, steep, major, minor_pixel, pix, 255 - fraction);
+        silkPlotLineCoverage(canvas, clip_ptr, steep, major, minor_pixel + 1, pix, fraction);
+
+        minor += minor_step;
+    }
+
+    return SILK_SUCCESS;
+
+#endif // SILK_ALPHABLEND_ENABLE
+}
+
+SILK_API i32 silkDrawRect(silk_canvas* canvas, vec2i position, vec2i size, pixel pix) {
+    silkDrawRectPro(
+        canvas,
+        position,
+        size,
+        (i32) 0,
+        (vec2i) { 0 },
+        pix
+    );
+
+    return SILK_SUCCESS;
+}
+
+SILK_API i32 silkDrawRectPro(silk_canvas* canvas, vec2i position, vec2i size, i32 angle, vec2i offset, pixel pix) {
+    if(canvas != NULL && canvas->recording != NULL) {
+        silk_command command = silkCommandInit(SILK_COMMAND_RECT, pix);
+        command.args.rect.position = position;
+        command.args.rect.size = size;
+        command.args.rect.offset = offset;
+        command.args.rect.angle = angle;
+
+        return silkRecordCommand(canvas, command, NULL, 0, NULL, 0);
+    }
+
+    vec2f points[4] = {
+        { 0, 0 }, // top-left
+        { 0, 0 }, // top_right
+        { 0, 0 }, // bottom_left
+        { 0, 0 }  // bottom_right
+    };
+
+    if(canvas == NULL || canvas->data == NULL) {
+        silkAssignErrorMessage(SILK_ERR_BUF_INVALID);
+
+        return SILK_FAILURE;
+    }
+
+    if(silkPixelTransparent(canvas, pix)) {
+        return SILK_SUCCESS;
+    }
+
+    if(angle == 0) {
+        // Axis-aligned rectangle doesn't need the triangle setup at all:
+        // it's simply a stack of identical spans.
+        silk_rect rect = silkRectIntersect(
+            silkCanvasClip(canvas),
+            (silk_rect) { position.x - offset.x, position.y - offset.y, size.x, size.y }
+        );
+
+        silkMarkDirty(canvas, rect);
+
+        for(i32 y = rect.y; y < rect.y + rect.h; y++) {
+            silkWriteSpan(canvas, rect.x, y, rect.w, pix);
+        }
+
+        return SILK_SUCCESS;
+    }
+
+    vec2i delta = {
+        -offset.x,
+        -offset.y
+    };
+
+    f32 angle_to_radians = angle * 3.14 / 180;
+
+    points[0].x = position.x + delta.x * cos(angle_to_radians) - delta.y * sin(angle_to_radians);
+    points[0].y = position.y + delta.x * sin(angle_to_radians) + delta.y * cos(angle_to_radians);
+
+    points[1].x = position.x + (delta.x + size.x) * cos(angle_to_radians) - delta.y * sin(angle_to_radians);
+    points[1].y = position.y + (delta.x + size.x) * sin(angle_to_radians) + delta.y * cos(angle_to_radians);
+
+    points[2].x = position.x + delta.x * cos(angle_to_radians) - (delta.y + size.y) * sin(angle_to_radians);
+    points[2].y = position.y + delta.x * sin(angle_to_radians) + (delta.y + size.y) * cos(angle_to_radians);
+
+    points[3].x = position.x + (delta.x + size.x) * cos(angle_to_radians) - (delta.y + size.y) * sin(angle_to_radians);
+    points[3].y = position.y + (delta.x + size.x) * sin(angle_to_radians) + (delta.y + size.y) * cos(angle_to_radians);
+
+    // Indices:
+    // 0 - 1 - 2
+    // 1 - 2 - 3
+    // Both triangles share the exact (sub-pixel) corners, so the diagonal is drawn exactly once.
+
+    silkDrawTriangleFloat(
+        canvas,
+        points[0],
+        points[1],
+        points[2],
+        pix
+    );
+
+    silkDrawTriangleFloat(
+        canvas,
+        points[1],
+        points[2],
+        points[3],
+        pix
+    );
+
+    return SILK_SUCCESS;
+}
+
+SILK_API i32 silkDrawRectLines(silk_canvas* canvas, vec2i position, vec2i size, i32 angle, vec2i offset, pixel pix) {
+    if(canvas != NULL && canvas->recording != NULL) {
+        silk_command command = silkCommandInit(SILK_COMMAND_RECT_LINES, pix);
+        command.args.rect.position = position;
+        command.args.rect.size = size;
+        command.args.rect.offset = offset;
+        command.args.rect.angle = angle;
+
+        return silkRecordCommand(canvas, command, NULL, 0, NULL, 0);
+    }
+
+    vec2i points[4] = {
+        { 0 }, // top-left
+        { 0 }, // top_right
+        { 0 }, // bottom_left
+        { 0 }  // bottom_right
+    };
+
+    if(angle == 0) {
+        points[0].x = position.x - offset.x;
+        points[0].y = position.y - offset.y;
+
+        points[1].x = position.x + size.x - offset.x;
+        points[1].y = position.y - offset.y;
+
+        points[2].x = position.x + size.x - offset.y;
+        points[2].y = position.y + size.y - offset.y;
+
+        points[3].x = position.x - offset.y;
+        points[3].y = position.y + size.y - offset.y;
+
+    } else {
+        vec2i delta = {
+            -offset.x,
+            -offset.y
+        };
+
+        f32 angle_to_radians = angle * 3.14 / 180;
+
+        points[0].x = position.x + delta.x * cos(angle_to_radians) - delta.y * sin(angle_to_radians);
+        points[0].y = position.y + delta.x * sin(angle_to_radians) + delta.y * cos(angle_to_radians);
+
+        points[1].x = position.x + (delta.x + size.x) * cos(angle_to_radians) - delta.y * sin(angle_to_radians);
+        points[1].y = position.y + (delta.x + size.x) * sin(angle_to_radians) + delta.y * cos(angle_to_radians);
+
+        points[2].x = position.x + (delta.x + size.x) * cos(angle_to_radians) - (delta.y + size.y) * sin(angle_to_radians);
+        points[2].y = position.y + (delta.x + size.x) * sin(angle_to_radians) + (delta.y + size.y) * cos(angle_to_radians);
+
+        points[3].x = position.x + delta.x * cos(angle_to_radians) - (delta.y + size.y) * sin(angle_to_radians);
+        points[3].y = position.y + delta.x * sin(angle_to_radians) + (delta.y + size.y) * cos(angle_to_radians);
+    }
+
+    for(i32 i = 0; i < 4; i++) {
+        silkDrawLine(
+            canvas,
+            points[i],
+            i + 1 < 4 ? points[i + 1] : points[0],
+            pix
+        );
+    }
+    return SILK_SUCCESS;
+}
+
+SILK_API i32 silkDrawCircle(silk_canvas* canvas, vec2i position, i32 radius, pixel pix) {
+    if(canvas != NULL && canvas->recording != NULL) {
+        silk_command command = silkCommandInit(SILK_COMMAND_CIRCLE, pix);
+        command.args.shape.position = position;
+        command.args.shape.radius.x = radius;
+        command.args.shape.radius.y = radius;
+
+        return silkRecordCommand(canvas, command, NULL, 0, NULL, 0);
+    }
+
+    if(canvas == NULL || canvas->data == NULL) {
+        silkAssignErrorMessage(SILK_ERR_BUF_INVALID);
+
+        return SILK_FAILURE;
+    }
+
+    if(radius > SILK_RASTER_MAX_RADIUS) {
+        silkAssignErrorMessage(SILK_ERR_OUT_OF_BOUNDS);
+
+        return SILK_FAILURE;
+    }
+
+    if(radius <= 0) {
+        return SILK_SUCCESS;
+    }
+
+    return silkRasterEllipse(canvas, position, radius, radius, pix);
+}
+
+SILK_API i32 silkDrawCircleAA(silk_canvas* canvas, vec2f position, f32 radius, pixel pix) {
+    if(canvas != NULL && canvas->recording != NULL) {
+        silk_command command = silkCommandInit(SILK_COMMAND_CIRCLE_AA, pix);
+        command.args.circle.position = position;
+        command.args.circle.radius = radius;
+
+        return silkRecordCommand(canvas, command, NULL, 0, NULL, 0);
+    }
+
+    if(canvas == NULL || canvas->data == NULL) {
+        silkAssignErrorMessage(SILK_ERR_BUF_INVALID);
+
+        return SILK_FAILURE;
+    }
+
+    // NOTE: The negated comparison rejects NaN as well
+    if(!(position.x >= -SILK_RASTER_MAX_COORD && position.x <= SILK_RASTER_MAX_COORD &&
+         position.y >= -SILK_RASTER_MAX_COORD && position.y <= SILK_RASTER_MAX_COORD &&
+         radius <= SILK_RASTER_MAX_COORD)) {
+        silkAssignErrorMessage(SILK_ERR_OUT_OF_BOUNDS);
+
+        return SILK_FAILURE;
+    }
+
+    if(!(radius > 0.0f)) {
+        return SILK_SUCCESS;
+    }
+
+#if !defined(SILK_ALPHABLEND_ENABLE)
+
+    // Without the alpha-blending there's no way to draw the partial coverage, so the circle is simply aliased
+    return silkDrawCircle(canvas, (vec2i) { (i32) floorf(position.x + 0.5f), (i32) floorf(position.y + 0.5f) }, (i32) floorf(radius + 0.5f), pix);
+
+#else
+
+    // Coverage of the pixel is approximated by the distance of it's center from the circle's edge: 'radius + 0.5 - distance',
+    // clamped to [0, 1]. Pixels closer to the center than 'radius - 0.5' are fully covered, so the interior of every row
+    // is still a single span, and only the few pixels at it's ends have their coverage computed.
+    f32 outer = radius + 0.5f;
+    f32 inner = radius - 0.5f;
+
+    i32 left = (i32) floorf(position.x - outer);
+    i32 top = (i32) floorf(position.y - outer);
+    i32 right = (i32) ceilf(position.x + outer) + 1;
+    i32 bottom = (i32) ceilf(position.y + outer) + 1;
+
+    silk_rect clip = silkCanvasClip(canvas);
+    i32 clip_test = silkClipBounds(&clip, left, top, right, bottom);
+
+    if(clip_test == SILK_CLIP_OUTSIDE || silkPixelTransparent(canvas, pix)) {
+        return SILK_SUCCESS;
+    }
+
+    silkMarkDirtyBounds(canvas, &clip, left, top, right, bottom);
+
+    silk_rect* clip_ptr = clip_test == SILK_CLIP_INSIDE ? NULL : &clip;
+
+    i32 y0 = (i32) ceilf(position.y - outer);
+    i32 y1 = (i32) floorf(position.y + outer);
+
+    if(clip_ptr != NULL) {
+        y0 = y0 < clip.y ? clip.y : y0;
+        y1 = y1 > clip.y + clip.h - 1 ? clip.y + clip.h - 1 : y1;
+    }
+
+    for(i32 y = y0; y <= y1; y++) {
+        f32 dy = y - position.y;
+        f32 outer_squared = outer * outer - dy * dy;
+
+        if(outer_squared <= 0.0f) {
+            continue;
+        }
+
+        f32 outer_half_width = sqrtf(outer_squared);
+        i32 x0 = (i32) ceilf(position.x - outer_half_width);
+        i32 x1 = (i32) floorf(position.x + outer_half_width);
+
+        // Fully covered part of the row: [full_x0, full_x1]
+        i32 full_x0 = x1 + 1;
+        i32 full_x1 = x1;
+
+        if(inner > 0.0f && inner * inner - dy * dy > 0.0f) {
+            f32 inner_half_width = sqrtf(inner * inner - dy * dy);
+
+            full_x0 = (i32) ceilf(position.x - inner_half_width);
+            full_x1 = (i32) floorf(position.x + inner_half_width);
+        }
+
+        for(i32 x = x0; x <= x1; x++) {
+            if(x == full_x0 && full_x0 <= full_x1) {
+                if(clip_ptr == NULL) {
+                    silkWriteSpan(canvas, full_x0, y, full_x1 - full_x0 + 1, pix);
+                } else {
+                    silkDrawSpan(canvas, y, full_x0, full_x1 + 1, pix);
+                }
+
+                x = full_x1;
+
+                continue;
+            }
+
+            f32 dx = x - position.x;
+            f32 coverage = outer - sqrtf(dx * dx + dy * dy);
+
+            coverage = coverage < 0.0f ? 0.0f : (coverage > 1.0f ? 1.0f : coverage);
+
+            silkPlotPixelCoverage(canvas, clip_ptr, x, y, pix, (u32) (coverage * 255.0f + 0.5f));
+        }
+    }
+
+    return SILK_SUCCESS;
+
+#endif // SILK_ALPHABLEND_ENABLE
+}
+
+SILK_API i32 silkDrawEllipse(silk_canvas* canvas, vec2i position, vec2i radius, pixel pix) {
+    if(canvas != NULL && canvas->recording != NULL) {
+        silk_command command = silkCommandInit(SILK_COMMAND_ELLIPSE, pix);
+        command.args.shape.position = position;
+        command.args.shape.radius = radius;
+
+        return silkRecordCommand(canvas, command, NULL, 0, NULL, 0);
+    }
+
+    if(canvas == NULL || canvas->data == NULL) {
+        silkAssignErrorMessage(SILK_ERR_BUF_INVALID);
+
+        return SILK_FAILURE;
+    }
+
+    if(radius.x > SILK_RASTER_MAX_RADIUS || radius.y > SILK_RASTER_MAX_RADIUS) {
+        silkAssignErrorMessage(SILK_ERR_OUT_OF_BOUNDS);
+
+        return SILK_FAILURE;
+    }
+
+    if(radius.x <= 0 || radius.y <= 0) {
+        return SILK_SUCCESS;
+    }
+
+    return silkRasterEllipse(canvas, position, radius.x, radius.y, pix);
+}
+
+SILK_API i32 silkDrawCircleLines(silk_canvas* canvas, vec2i position, i32 radius, pixel pix) {
+    if(canvas != NULL && canvas->recording != NULL) {
+        silk_command command = silkCommandInit(SILK_COMMAND_CIRCLE_LINES, pix);
+        command.args.shape.position = position;
+        command.args.shape.radius.x = radius;
+        command.args.shape.radius.y = radius;
+
+        return silkRecordCommand(canvas, command, NULL, 0, NULL, 0);
+    }
+
+    // Source:
+    // https://www.geeksforgeeks.org/bresenhams-circle-drawing-algorithm/
+
+    if(canvas == NULL || canvas->data == NULL) {
+        silkAssignErrorMessage(SILK_ERR_BUF_INVALID);
+
+        return SILK_FAILURE;
+    }
+
+    // Last step of the loop below overshoots the circle, so the zero radius still reaches one pixel around the center
+    i32 reach = radius == 0 ? 1 : radius;
+
+    silk_rect clip = silkCanvasClip(canvas);
+    i32 clip_test = silkClipBounds(&clip, position.x - reach, position.y - reach, position.x + reach + 1, position.y + reach + 1);
+
+    if(clip_test == SILK_CLIP_OUTSIDE || silkPixelTransparent(canvas, pix)) {
+        return SILK_SUCCESS;
+    }
+
+    silkMarkDirtyBounds(canvas, &clip, position.x - reach, position.y - reach, position.x + reach + 1, position.y + reach + 1);
+
+    silk_rect* clip_ptr = clip_test == SILK_CLIP_INSIDE ? NULL : &clip;
+
+    i32 x = 0;
+    i32 y = radius;
+    i32 d = 3 - 2 * radius;
+
+    silkPlotCircleOctants(canvas, clip_ptr, position, x, y, pix);
+
+    while(y >= x) {
+        x++;
+
+        if(d > 0) {
+            y--;
+            d += 4 * (x - y) + 10;
+        } else {
+            d += 4 * x + 6;
+        }
+
+        silkPlotCircleOctants(canvas, clip_ptr, position, x, y, pix);
+    }
+
+    return SILK_SUCCESS;
+}
+
+SILK_API i32 silkSetRasterizer(i32 rasterizer) {
+    if(rasterizer != SILK_RASTERIZER_SCANLINE && rasterizer != SILK_RASTERIZER_HALFSPACE) {
+        silkAssignErrorMessage(SILK_ERR_RASTERIZER_INVALID);
+
+        return SILK_FAILURE;
+    }
+
+    silk_rasterizer = rasterizer;
+
+    return SILK_SUCCESS;
+}
+
+SILK_API i32 silkGetRasterizer(void) {
+    return silk_rasterizer;
+}
+
+SILK_API i32 silkDrawTriangle(silk_canvas* canvas, vec2i point_a, vec2i point_b, vec2i point_c, pixel pix) {
+    if(canvas != NULL && canvas->recording != NULL) {
+        silk_command command = silkCommandInit(SILK_COMMAND_TRIANGLE, pix);
+        command.args.points.a = point_a;
+        command.args.points.b = point_b;
+        command.args.points.c = point_c;
+
+        return silkRecordCommand(canvas, command, NULL, 0, NULL, 0);
+    }
+
+    if(canvas == NULL || canvas->data == NULL) {
+        silkAssignErrorMessage(SILK_ERR_BUF_INVALID);
+
+        return SILK_FAILURE;
+    }
+
+    vec2i points[3] = { point_a, point_b, point_c };
+
+    for(i32 i = 0; i < 3; i++) {
+        if(points[i].x < -SILK_RASTER_MAX_COORD || points[i].x > SILK_RASTER_MAX_COORD ||
+           points[i].y < -SILK_RASTER_MAX_COORD || points[i].y > SILK_RASTER_MAX_COORD) {
+            silkAssignErrorMessage(SILK_ERR_OUT_OF_BOUNDS);
+
+            return SILK_FAILURE;
+        }
+
+        points[i].x = SILK_SUBPIXEL(points[i].x);
+        points[i].y = SILK_SUBPIXEL(points[i].y);
+    }
+
+    return silkRasterTriangle(canvas, points[0], points[1], points[2], pix);
+}
+
+SILK_API i32 silkDrawTriangleFloat(silk_canvas* canvas, vec2f point_a, vec2f point_b, vec2f point_c, pixel pix) {
+    if(canvas != NULL && canvas->recording != NULL) {
+        silk_command command = silkCommandInit(SILK_COMMAND_TRIANGLE_FLOAT, pix);
+        command.args.points_float.a = point_a;
+        command.args.points_float.b = point_b;
+        command.args.points_float.c = point_c;
+
+        return silkRecordCommand(canvas, command, NULL, 0, NULL, 0);
+    }
+
+    if(canvas == NULL || canvas->data == NULL) {
+        silkAssignErrorMessage(SILK_ERR_BUF_INVALID);
+
+        return SILK_FAILURE;
+    }
+
+    vec2f points[3] = { point_a, point_b, point_c };
+
+    for(i32 i = 0; i < 3; i++) {
+        // NOTE: The negated comparison rejects NaN as well
+        if(!(points[i].x >= -SILK_RASTER_MAX_COORD && points[i].x <= SILK_RASTER_MAX_COORD &&
+             points[i].y >= -SILK_RASTER_MAX_COORD && points[i].y <= SILK_RASTER_MAX_COORD)) {
+            silkAssignErrorMessage(SILK_ERR_OUT_OF_BOUNDS);
+
+            return SILK_FAILURE;
+        }
+    }
+
+    return silkRasterTriangle(
+        canvas,
+        silkToSubpixel(points[0].x, points[0].y),
+        silkToSubpixel(points[1].x, points[1].y),
+        silkToSubpixel(points[2].x, points[2].y),
+        pix
+    );
+}
+
+SILK_API i32 silkDrawTriangleFixed(silk_canvas* canvas, vec2i point_a, vec2i point_b, vec2i point_c, pixel pix) {
+    if(canvas != NULL && canvas->recording != NULL) {
+        silk_command command = silkCommandInit(SILK_COMMAND_TRIANGLE_FIXED, pix);
+        command.args.points.a = point_a;
+        command.args.points.b = point_b;
+        command.args.points.c = point_c;
+
+        return silkRecordCommand(canvas, command, NULL, 0, NULL, 0);
+    }
+
+    if(canvas == NULL || canvas->data == NULL) {
+        silkAssignErrorMessage(SILK_ERR_BUF_INVALID);
+
+        return SILK_FAILURE;
+    }
+
+    return silkRasterTriangle(canvas, point_a, point_b, point_c, pix);
+}
+
+SILK_API i32 silkDrawTriangleLines(silk_canvas* canvas, vec2i point_a, vec2i point_b, vec2i point_c, pixel pix) {
+    if(canvas != NULL && canvas->recording != NULL) {
+        silk_command command = silkCommandInit(SILK_COMMAND_TRIANGLE_LINES, pix);
+        command.args.points.a = point_a;
+        command.args.points.b = point_b;
+        command.args.points.c = point_c;
+
+        return silkRecordCommand(canvas, command, NULL, 0, NULL, 0);
+    }
+
+    if(point_a.y > point_b.y) silkVectorSwap(&point_a, &point_b);
+    if(point_a.y > point_c.y) silkVectorSwap(&point_a, &point_c);
+    if(point_b.y > point_c.y) silkVectorSwap(&point_b, &point_c);
+
+    silkDrawLine(canvas, point_a, point_b, pix);
+    silkDrawLine(canvas, point_b, point_c, pix);
+    silkDrawLine(canvas, point_a, point_c, pix);
+
+    return SILK_SUCCESS;
+}
+
+SILK_API i32 silkDrawTriangleEquilateral(silk_canvas* canvas, vec2i position, i32 radius, i32 angle, pixel pix) {
+    if(canvas != NULL && canvas->recording != NULL) {
+        silk_command command = silkCommandInit(SILK_COMMAND_TRIANGLE_EQUILATERAL, pix);
+        command.args.shape.position = position;
+        command.args.shape.radius.x = radius;
+        command.args.shape.radius.y = radius;
+        command.args.shape.angle = angle;
+        command.args.shape.n = 3;
+
+        return silkRecordCommand(canvas, command, NULL, 0, NULL, 0);
+    }
+
+    // Source:
+    // https://www.quora.com/How-do-you-calculate-the-triangle-vertices-coordinates-on-a-circumcircle-triangle-with-a-given-centre-point-and-radius-Assuming-the-triangle-is-acute-with-all-equal-length-sides-and-that-one-point-is-straight-up
+
+    if(canvas == NULL || canvas->data == NULL) {
+        silkAssignErrorMessage(SILK_ERR_BUF_INVALID);
+
+        return SILK_FAILURE;
+    }
+
+    vec2f points[3] = {
+        { position.x, position.y - radius },                                    // point: 0 (top)
+        { position.x - sqrt(3) * radius / 2, position.y + radius / 2.0f },      // point: 1 (left)
+        { position.x + sqrt(3) * radius / 2, position.y + radius / 2.0f },      // point: 2 (bottom)
+    };
+
+    // Big thanks to @zet23t for help:
+    // https://twitter.com/zet23t
+
+    f32 angle_to_radians = angle * 3.14f / 180.0f;
+    f32 x_right = cos(angle_to_radians);
+    f32 y_right = sin(angle_to_radians);
+    f32 x_up = -y_right;
+    f32 y_up = x_right;
+
+    for(i32 i = 0; i < 3; i++) {
+        f32 dx = points[i].x - position.x;
+        f32 dy = points[i].y - position.y;
+
+        points[i].x = position.x + (x_right * dx + x_up * dy);
+        points[i].y = position.y + (y_right * dx + y_up * dy);
+    }
+
+    silkDrawTriangleFloat(canvas, points[0], points[1], points[2], pix);
+
+    return SILK_SUCCESS;
+}
+
+SILK_API i32 silkDrawTriangleEquilateralLines(silk_canvas* canvas, vec2i position, i32 radius, i32 angle, pixel pix) {
+    if(canvas != NULL && canvas->recording != NULL) {
+        silk_command command = silkCommandInit(SILK_COMMAND_TRIANGLE_EQUILATERAL_LINES, pix);
+        command.args.shape.position = position;
+        command.args.shape.radius.x = radius;
+        command.args.shape.radius.y = radius;
+        command.args.shape.angle = angle;
+        command.args.shape.n = 3;
+
+        return silkRecordCommand(canvas, command, NULL, 0, NULL, 0);
+    }
+
+    vec2i points[3] = {
+        { position.x, position.y - radius },                                // point: 0 (top)
+        { position.x - sqrt(3) * radius / 2, position.y + radius / 2 },     // point: 1 (left)
+        { position.x + sqrt(3) * radius / 2, position.y + radius / 2 },     // point: 2 (bottom)
+    };
+
+    // Big thanks to @zet23t for help:
+    // https://twitter.com/zet23t
+
+    f32 angle_to_radians = angle * 3.14f / 180.0f;
+    f32 x_right = cos(angle_to_radians);
+    f32 y_right = sin(angle_to_radians);
+    f32 x_up = -y_right;
+    f32 y_up = x_right;
+
+    for(i32 i = 0; i < 3; i++) {
+        f32 dx = points[i].x - position.x;
+        f32 dy = points[i].y - position.y;
+
+        points[i].x = position.x + (x_right * dx + x_up * dy);
+        points[i].y = position.y + (y_right * dx + y_up * dy);
+    }
+
+    silkDrawTriangleLines(canvas, points[0], points[1], points[2], pix);
+
+    return SILK_SUCCESS;
+}
+
+SILK_API i32 silkDrawPolygon(silk_canvas* canvas, vec2i position, i32 radius, i32 angle, i32 n, pixel pix) {
+    if(canvas != NULL && canvas->recording != NULL) {
+        silk_command command = silkCommandInit(SILK_COMMAND_POLYGON, pix);
+        command.args.shape.position = position;
+        command.args.shape.radius.x = radius;
+        command.args.shape.radius.y = radius;
+        command.args.shape.angle = angle;
+        command.args.shape.n = n;
+
+        return silkRecordCommand(canvas, command, NULL, 0, NULL, 0);
+    }
+
+    if(canvas == NULL || canvas->data == NULL) {
+        silkAssignErrorMessage(SILK_ERR_BUF_INVALID);
+
+        return SILK_FAILURE;
+    }
+
+    if(n < 3) {
+        n = 3;
+    }
+
+    f32 theta = 360.0f / n;
+
+    // Small polygons don't allocate any memory
+    vec2f stack_points[SILK_POLYGON_STACK_EDGES];
+    vec2f* points = stack_points;
+
+    if(n > SILK_POLYGON_STACK_EDGES) {
+        points = (vec2f*) SILK_MALLOC((size_t) n * sizeof(vec2f));
+
+        if(points == NULL) {
+            silkAssignErrorMessage(SILK_ERR_ALLOCATION_FAIL);
+
+            return SILK_FAILURE;
+        }
+    }
+
+    // Calculating the positions of each point of our polygon
+    for(i32 i = 0; i < n; i++) {
+        // Equation: https://www.wyzant.com/resources/answers/601887/calculate-point-given-x-y-angle-and-distance
+        points[i] = (vec2f) {
+            .x = position.x + radius * cosf(((theta * i) + angle) * 3.14f / 180.0f),
+            .y = position.y + radius * sinf(((theta * i) + angle) * 3.14f / 180.0f)
+        };
+    }
+
+    i32 result = silkDrawPolygonPoints(canvas, points, n, SILK_FILL_RULE_NON_ZERO, pix);
+
+    if(points != stack_points) {
+        SILK_FREE(points);
+    }
+
+    return result;
+}
+
+SILK_API i32 silkDrawPolygonPoints(silk_canvas* canvas, const vec2f* points, i32 count, i32 fill_rule, pixel pix) {
+    if(canvas != NULL && canvas->recording != NULL && (points != NULL || count <= 0)) {
+        silk_command command = silkCommandInit(SILK_COMMAND_POLYGON_POINTS, pix);
+        command.args.polygon.count = count > 0 ? count : 0;
+        command.args.polygon.fill_rule = fill_rule;
+
+        return silkRecordCommand(canvas, command, points, (i64) command.args.polygon.count * (i64) sizeof(vec2f), NULL, 0);
+    }
+
+    if(canvas == NULL || canvas->data == NULL || (points == NULL && count > 0)) {
+        silkAssignErrorMessage(SILK_ERR_BUF_INVALID);
+
+        return SILK_FAILURE;
+    }
+
+    if(fill_rule != SILK_FILL_RULE_EVEN_ODD && fill_rule != SILK_FILL_RULE_NON_ZERO) {
+        silkAssignErrorMessage(SILK_ERR_FILL_RULE_INVALID);
+
+        return SILK_FAILURE;
+    }
+
+    if(count < 3) {
+        return SILK_SUCCESS;
+    }
+
+    for(i32 i = 0; i < count; i++) {
+        // NOTE: The negated comparison rejects NaN as well
+        if(!(points[i].x >= -SILK_RASTER_MAX_COORD && points[i].x <= SILK_RASTER_MAX_COORD &&
+             points[i].y >= -SILK_RASTER_MAX_COORD && points[i].y <= SILK_RASTER_MAX_COORD)) {
+            silkAssignErrorMessage(SILK_ERR_OUT_OF_BOUNDS);
+
+            return SILK_FAILURE;
+        }
+    }
+
+    vec2i stack_points[SILK_POLYGON_STACK_EDGES];
+    vec2i* fixed_points = stack_points;
+
+    if(count > SILK_POLYGON_STACK_EDGES) {
+        fixed_points = (vec2i*) SILK_MALLOC((size_t) count * sizeof(vec2i));
+
+        if(fixed_points == NULL) {
+            silkAssignErrorMessage(SILK_ERR_ALLOCATION_FAIL);
+
+            return SILK_FAILURE;
+        }
+    }
+
+    for(i32 i = 0; i < count; i++) {
+        fixed_points[i] = silkToSubpixel(points[i].x, points[i].y);
+    }
+
+    i32 result = silkRasterPolygon(canvas, fixed_points, count, fill_rule, pix);
+
+    if(fixed_points != stack_points) {
+        SILK_FREE(fixed_points);
+    }
+
+    return result;
+}
+
+SILK_API i32 silkDrawStar(silk_canvas* canvas, vec2i position, i32 radius, i32 angle, i32 n, pixel pix) {
+    if(canvas != NULL && canvas->recording != NULL) {
+        silk_command command = silkCommandInit(SILK_COMMAND_STAR, pix);
+        command.args.shape.position = position;
+        command.args.shape.radius.x = radius;
+        command.args.shape.radius.y = radius;
+        command.args.shape.angle = angle;
+        command.args.shape.n = n;
+
+        return silkRecordCommand(canvas, command, NULL, 0, NULL, 0);
+    }
+
+    if(n < 3) {
+        n = 3;
+    }
+
+    i32 theta = 360 / n;
+
+    // Calculating the positions of each point of our star and rendering it to the screen
+    for(i32 i = 0; i < n; i++) {
+        // Equation: https://www.wyzant.com/resources/answers/601887/calculate-point-given-x-y-angle-and-distance
+        vec2f point_a;
+        vec2f point_b;
+        vec2f point_c;
+
+        point_a.x = position.x + radius * cos(((theta * i) + angle) * 3.14 / 180);
+        point_a.y = position.y + radius * sin(((theta * i) + angle) * 3.14 / 180);
+
+        point_b.x = position.x + (radius / n * 2) * cos(((theta * i) - 90 + angle) * 3.14 / 180);
+        point_b.y = position.y + (radius / n * 2) * sin(((theta * i) - 90 + angle) * 3.14 / 180);
+
+        point_c.x = position.x + (radius / n * 2) * cos(((theta * i) + 90 + angle) * 3.14 / 180);
+        point_c.y = position.y + (radius / n * 2) * sin(((theta * i) + 90 + angle) * 3.14 / 180);
+
+        silkDrawTriangleFloat(
+            canvas,
+            point_a,
+            point_b,
+            point_c,
+            pix
+        );
+    }
+
+
+    return SILK_SUCCESS;
+}
+
+SILK_API i32 silkDrawImage(silk_canvas* canvas, image* img, vec2i position) {
+    if(!img) {
+        silkAssignErrorMessage(SILK_ERR_BUF_IMG_INVALID);
+
+        return SILK_FAILURE;
+    }
+
+    silkDrawImagePro(
+        canvas,
+        img,
+        position,
+        (vec2i) { 0 },
+        img->size,
+        0xffffffff
+    );
+
+    return SILK_SUCCESS;
+}
+
+SILK_API i32 silkDrawImageScaled(silk_canvas* canvas, image* img, vec2i position, vec2i size_dest) {
+    if(!img) {
+        silkAssignErrorMessage(SILK_ERR_BUF_IMG_INVALID);
+
+        return SILK_FAILURE;
+    }
+
+    silkDrawImagePro(
+        canvas,
+        img,
+        position,
+        (vec2i) { 0 },
+        size_dest,
+        0xffffffff
+    );
+
+    return SILK_SUCCESS;
+}
+
+SILK_API i32 silkDrawImagePro(silk_canvas* canvas, image* img, vec2i position, vec2i offset, vec2i size_dest, pixel tint) {
+    // NOTE: Only the image's address is recorded, so it has to stay alive (and unchanged) until the commands are replayed
+    if(canvas != NULL && canvas->recording != NULL && img != NULL) {
+        silk_command command = silkCommandInit(SILK_COMMAND_IMAGE, 0);
+        command.args.image.img = img;
+        command.args.image.position = position;
+        command.args.image.offset = offset;
+        command.args.image.size = size_dest;
+        command.args.image.tint = tint;
+
+        return silkRecordCommand(canvas, command, NULL, 0, NULL, 0);
+    }
+
+    if(!img) {
+        silkAssignErrorMessage(SILK_ERR_BUF_IMG_INVALID);
+
+        return SILK_FAILURE;
+    }
+
+    if(canvas == NULL || canvas->data == NULL) {
+        silkAssignErrorMessage(SILK_ERR_BUF_INVALID);
+
+        return SILK_FAILURE;
+    }
+
+    // Tint scales the alpha of every image pixel, so the fully transparent one hides the whole image
+    if(size_dest.x <= 0 || size_dest.y <= 0 || silkPixelTransparent(canvas, tint)) {
+        return SILK_SUCCESS;
+    }
+
+    vec2i origin = {
+        position.x - offset.x,
+        position.y - offset.y
+    };
+
+    // Clipping the destination rectangle once for the whole image, instead of once per pixel
+    silk_rect clip = silkCanvasClip(canvas);
+
+    i32 x0 = origin.x < clip.x ? clip.x - origin.x : 0;
+    i32 x1 = origin.x + size_dest.x > clip.x + clip.w ? clip.x + clip.w - origin.x : size_dest.x;
+    i32 y0 = origin.y < clip.y ? clip.y - origin.y : 0;
+    i32 y1 = origin.y + size_dest.y > clip.y + clip.h ? clip.y + clip.h - origin.y : size_dest.y;
+
+    if(x0 >= x1 || y0 >= y1) {
+        return SILK_SUCCESS;
+    }
+
+    silkMarkDirty(canvas, (silk_rect) { origin.x + x0, origin.y + y0, x1 - x0, y1 - y0 });
+
+    // Source column is 'x * img->size.x / size_dest.x'. We're stepping it incrementally (quotient + remainder),
+    // so there's no division in the inner loop, but the result stays exactly the same.
+    i32 step_quotient = img->size.x / size_dest.x;
+    i32 step_remainder = img->size.x % size_dest.x;
+
+    // Unscaled and untinted rows are blended straight from the image. Otherwise the source pixels are gathered
+    // (and tinted) into a small scratch row first, so the blending still goes through the span kernels.
+    bool direct = step_quotient == 1 && step_remainder == 0 && tint == 0xffffffff;
+    pixel scratch[SILK_SPAN_CHUNK];
+
+    for(i32 y = y0; y < y1; y++) {
+        i32 dest_y = origin.y + y;
+
+        pixel* src_row = img->data + (y * img->size.y / size_dest.y) * img->size.x;
+
+        i32 src_x = (i32) ((i64) x0 * img->size.x / size_dest.x);
+        i32 src_remainder = (i32) ((i64) x0 * img->size.x % size_dest.x);
+
+        if(direct) {
+            silkWriteImageSpan(canvas, origin.x + x0, dest_y, src_row + src_x, x1 - x0);
+
+            continue;
+        }
+
+        for(i32 x = x0; x < x1; x += SILK_SPAN_CHUNK) {
+            i32 count = x1 - x < SILK_SPAN_CHUNK ? x1 - x : SILK_SPAN_CHUNK;
+
+            for(i32 i = 0; i < count; i++) {
+                scratch[i] = tint == 0xffffffff ? src_row[src_x] : silkPixelTint(src_row[src_x], tint);
+
+                src_x += step_quotient;
+                src_remainder += step_remainder;
+
+                if(src_remainder >= size_dest.x) {
+                    src_x++;
+                    src_remainder -= size_dest.x;
+                }
+            }
+
+            silkWriteImageSpan(canvas, origin.x + x, dest_y, scratch, count);
+        }
+    }
+
+    return SILK_SUCCESS;
+}
+
+SILK_API i32 silkDrawTextDefault(silk_canvas* canvas, const char* text, vec2i position, i32 font_size, i32 font_spacing, pixel pix) {
+    return silkDrawTextBitmap(canvas, &silk_default_font, text, position, font_size, font_spacing, pix);
+}
+
+SILK_API i32 silkDrawTextBitmap(silk_canvas* canvas, const silk_bitmap_font* font, const char* text, vec2i position, i32 font_size, i32 font_spacing, pixel pix) {
+    if(canvas != NULL && canvas->recording != NULL && font != NULL && text != NULL) {
+        silk_command command = silkCommandInit(SILK_COMMAND_TEXT, pix);
+        command.args.text.font = font;
+        command.args.text.position = position;
+        command.args.text.font_size = font_size;
+        command.args.text.font_spacing = font_spacing;
+
+        return silkRecordCommand(canvas, command, text, (i64) strlen(text) + 1, NULL, 0);
+    }
+
+    if(canvas == NULL || canvas->data == NULL || font == NULL || font->rows == NULL || text == NULL) {
+        silkAssignErrorMessage(SILK_ERR_BUF_INVALID);
+
+        return SILK_FAILURE;
+    }
+
+    if(font->glyph_size.x <= 0 || font->glyph_size.x > 8 || font->glyph_size.y <= 0) {
+        silkAssignErrorMessage(SILK_ERR_OUT_OF_BOUNDS);
+
+        return SILK_FAILURE;
+    }
+
+    if(font_size <= 0 || silkPixelTransparent(canvas, pix)) {
+        return SILK_SUCCESS;
+    }
+
+    // Text is placed on the grid of the font's cells ('font_size' pixels each)
+    silk_text_draw draw = {
+        canvas,
+        silkCanvasClip(canvas),
+        font,
+        { position.x / font_size * font_size, position.y / font_size * font_size },
+        { (font->glyph_size.x + font_spacing) * font_size, (font->glyph_size.y + font_spacing) * font_size },
+        font_size,
+        pix
+    };
+
+    silkLayoutTextGrid(text, 0, silkDrawGridGlyph, &draw);
+
+    return SILK_SUCCESS;
+}
+
+SILK_API const silk_bitmap_font* silkGetDefaultFont(void) {
+    return &silk_default_font;
+}
+
+// --------------------------------------------------------------------------------------------------------------------------------
+// SECTION MODULE: Paths
+// --------------------------------------------------------------------------------------------------------------------------------
+
+SILK_API silk_path silkLoadPath(void) {
+    // Path doesn't allocate anything until the first point is added
+    return (silk_path) { 0 };
+}
+
+SILK_API i32 silkUnloadPath(silk_path* path) {
+    if(path == NULL) {
+        silkAssignErrorMessage(SILK_ERR_BUF_INVALID);
+
+        return SILK_FAILURE;
+    }
+
+    SILK_FREE(path->points);
+    SILK_FREE(path->contours);
+
+    *path = (silk_path) { 0 };
+
+    return SILK_SUCCESS;
+}
+
+SILK_API i32 silkPathReset(silk_path* path) {
+    if(path == NULL) {
+        silkAssignErrorMessage(SILK_ERR_BUF_INVALID);
+
+        return SILK_FAILURE;
+    }
+
+    // Memory is kept, so the path rebuilt every frame doesn't allocate
+    path->point_count = 0;
+    path->contour_count = 0;
+
+    return SILK_SUCCESS;
+}
+
+SILK_API i32 silkPathMoveTo(silk_path* path, vec2f point) {
+    if(path == NULL) {
+        silkAssignErrorMessage(SILK_ERR_BUF_INVALID);
+
+        return SILK_FAILURE;
+    }
+
+    // Contour that is nothing but a single point is replaced instead of being kept
+    if(path->contour_count > 0 && path->contours[path->contour_count - 1] == path->point_count - 1) {
+        path->point_count--;
+        path->contour_count--;
+    }
+
+    if(path->contour_count == path->contour_capacity) {
+        i32 capacity = path->contour_capacity > 0 ? path->contour_capacity * 2 : 8;
+        i32* contours = (i32*) SILK_REALLOC(path->contours, (size_t) capacity * sizeof(i32));
+
+        if(contours == NULL) {
+            silkAssignErrorMessage(SILK_ERR_ALLOCATION_FAIL);
+
+            return SILK_FAILURE;
+        }
+
+        path->contours = contours;
+        path->contour_capacity = capacity;
+    }
+
+    if(silkPathPushPoint(path, point) != SILK_SUCCESS) {
+        return SILK_FAILURE;
+    }
+
+    path->contours[path->contour_count++] = path->point_count - 1;
+
+    return SILK_SUCCESS;
+}
+
+SILK_API i32 silkPathLineTo(silk_path* path, vec2f point) {
+    if(path == NULL) {
+        silkAssignErrorMessage(SILK_ERR_BUF_INVALID);
+
+        return SILK_FAILURE;
+    }
+
+    // Path without the 'silkPathMoveTo' starts at the current point (the origin, for the empty path)
+    if(path->contour_count == 0 && silkPathMoveTo(path, silkPathCurrentPoint(path)) != SILK_SUCCESS) {
+        return SILK_FAILURE;
+    }
+
+    return silkPathPushPoint(path, point);
+}
+
+SILK_API i32 silkPathQuadTo(silk_path* path, vec2f control, vec2f point) {
+    if(path == NULL) {
+        silkAssignErrorMessage(SILK_ERR_BUF_INVALID);
+
+        return SILK_FAILURE;
+    }
+
+    vec2f start = silkPathCurrentPoint(path);
+
+    f32 dx = start.x - 2.0f * control.x + point.x;
+    f32 dy = start.y - 2.0f * control.y + point.y;
+    i32 n = silkPathSegmentCount(sqrtf(dx * dx + dy * dy), 0.25f);
+
+    for(i32 i = 1; i <= n; i++) {
+        f32 t = (f32) i / n;
+        f32 u = 1.0f - t;
+
+        vec2f p = {
+            u * u * start.x + 2.0f * u * t * control.x + t * t * point.x,
+            u * u * start.y + 2.0f * u * t * control.y + t * t * point.y
+        };
+
+        if(silkPathLineTo(path, i == n ? point : p) != SILK_SUCCESS) {
+            return SILK_FAILURE;
+        }
+    }
+
+    return SILK_SUCCESS;
+}
+
+SILK_API i32 silkPathCubicTo(silk_path* path, vec2f control_a, vec2f control_b, vec2f point) {
+    if(path == NULL) {
+        silkAssignErrorMessage(SILK_ERR_BUF_INVALID);
+
+        return SILK_FAILURE;
+    }
+
+    vec2f start = silkPathCurrentPoint(path);
+
+    f32 dx0 = start.x - 2.0f * control_a.x + control_b.x;
+    f32 dy0 = start.y - 2.0f * control_a.y + control_b.y;
+    f32 dx1 = control_a.x - 2.0f * control_b.x + point.x;
+    f32 dy1 = control_a.y - 2.0f * control_b.y + point.y;
+    f32 deviation0 = sqrtf(dx0 * dx0 + dy0 * dy0);
+    f32 deviation1 = sqrtf(dx1 * dx1 + dy1 * dy1);
+    i32 n = silkPathSegmentCount(deviation0 > deviation1 ? deviation0 : deviation1, 0.75f);
+
+    for(i32 i = 1; i <= n; i++) {
+        f32 t = (f32) i / n;
+        f32 u = 1.0f - t;
+
+        vec2f p = {
+            u * u * u * start.x + 3.0f * u * u * t * control_a.x + 3.0f * u * t * t * control_b.x + t * t * t * point.x,
+            u * u * u * start.y + 3.0f * u * u * t * control_a.y + 3.0f * u * t * t * control_b.y + t * t * t * point.y
+        };
+
+        if(silkPathLineTo(path, i == n ? point : p) != SILK_SUCCESS) {
+            return SILK_FAILURE;
+        }
+    }
+
+    return SILK_SUCCESS;
+}
+
+SILK_API i32 silkPathClose(silk_path* path) {
+    if(path == NULL) {
+        silkAssignErrorMessage(SILK_ERR_BUF_INVALID);
+
+        return SILK_FAILURE;
+    }
+
+    if(path->contour_count == 0) {
+        return SILK_SUCCESS;
+    }
+
+    // Every contour is closed when it's filled anyway; closing only moves the current point back to the contour's start,
+    // where the next one begins
+    return silkPathMoveTo(path, path->points[path->contours[path->contour_count - 1]]);
+}
+
+SILK_API i32 silkDrawPath(silk_canvas* canvas, silk_path* path, i32 fill_rule, pixel pix) {
+    if(canvas != NULL && canvas->recording != NULL && path != NULL) {
+        silk_command command = silkCommandInit(SILK_COMMAND_PATH, pix);
+        command.args.polygon.count = path->point_count;
+        command.args.polygon.contour_count = path->contour_count;
+        command.args.polygon.fill_rule = fill_rule;
+
+        return silkRecordCommand(
+            canvas, command,
+            path->points, (i64) path->point_count * (i64) sizeof(vec2f),
+            path->contours, (i64) path->contour_count * (i64) sizeof(i32)
+        );
+    }
+
+    if(canvas == NULL || canvas->data == NULL || path == NULL) {
+        silkAssignErrorMessage(SILK_ERR_BUF_INVALID);
+
+        return SILK_FAILURE;
+    }
+
+    if(fill_rule != SILK_FILL_RULE_EVEN_ODD && fill_rule != SILK_FILL_RULE_NON_ZERO) {
+        silkAssignErrorMessage(SILK_ERR_FILL_RULE_INVALID);
+
+        return SILK_FAILURE;
+    }
+
+    if(path->point_count < 3) {
+        return SILK_SUCCESS;
+    }
+
+    f32 min_x = path->points[0].x;
+    f32 min_y = path->points[0].y;
+    f32 max_x = path->points[0].x;
+    f32 max_y = path->points[0].y;
+
+    for(i32 i = 1; i < path->point_count; i++) {
+        min_x = path->points[i].x < min_x ? path->points[i].x : min_x;
+        min_y = path->points[i].y < min_y ? path->points[i].y : min_y;
+        max_x = path->points[i].x > max_x ? path->points[i].x : max_x;
+        max_y = path->points[i].y > max_y ? path->points[i].y : max_y;
+    }
+
+    silk_rect bounds = silkRectIntersect(
+        silkCanvasClip(canvas),
+        (silk_rect) {
+            (i32) floorf(min_x),
+            (i32) floorf(min_y),
+            (i32) ceilf(max_x) - (i32) floorf(min_x),
+            (i32) ceilf(max_y) - (i32) floorf(min_y)
+        }
+    );
+
+    if(bounds.w <= 0 || bounds.h <= 0 || silkPixelTransparent(canvas, pix)) {
+        return SILK_SUCCESS;
+    }
+
+    silkMarkDirty(canvas, bounds);
+
+    i32 stride = bounds.w;
+    i32 words = (stride + 31) / 32;
+    i32* accumulation = (i32*) SILK_CALLOC((size_t) stride * SILK_PATH_BAND_HEIGHT, sizeof(i32));
+    u32* touched = (u32*) SILK_CALLOC((size_t) words * SILK_PATH_BAND_HEIGHT, sizeof(u32));
+
+    if(accumulation == NULL || touched == NULL) {
+        SILK_FREE(accumulation);
+        SILK_FREE(touched);
+
+        silkAssignErrorMessage(SILK_ERR_ALLOCATION_FAIL);
+
+        return SILK_FAILURE;
+    }
+
+    for(i32 band = 0; band < bounds.h; band += SILK_PATH_BAND_HEIGHT) {
+        i32 band_height = bounds.h - band < SILK_PATH_BAND_HEIGHT ? bounds.h - band : SILK_PATH_BAND_HEIGHT;
+        silk_rect band_area = { bounds.x, bounds.y + band, bounds.w, band_height };
+        f32 band_top = (f32) band_area.y;
+        f32 band_bottom = band_top + band_height;
+
+        for(i32 contour = 0; contour < path->contour_count; contour++) {
+            i32 first = path->contours[contour];
+            i32 last = contour + 1 < path->contour_count ? path->contours[contour + 1] : path->point_count;
+
+            for(i32 i = first; i < last; i++) {
+                vec2f from = path->points[i];
+                vec2f to = path->points[i + 1 < last ? i + 1 : first];
+
+                if((from.y <= band_top && to.y <= band_top) || (from.y >= band_bottom && to.y >= band_bottom)) {
+                    continue;
+                }
+
+                silkPathAccumulateLine(accumulation, touched, stride, band_area, from, to);
+            }
+        }
+
+        for(i32 y = 0; y < band_height; y++) {
+            i32* row = accumulation + (size_t) y * stride;
+            u32* row_touched = touched + (size_t) y * words;
+            i32 sum = 0;
+
+            for(i32 x = 0; x < bounds.w; ) {
+                sum += row[x];
+                row[x] = 0;
+
+                u32 coverage = (u32) (sum < 0 ? -sum : sum);
+
+                if(fill_rule == SILK_FILL_RULE_NON_ZERO) {
+                    coverage = coverage > SILK_PATH_COVERAGE_ONE ? SILK_PATH_COVERAGE_ONE : coverage;
+                } else {
+                    coverage = coverage % (2 * SILK_PATH_COVERAGE_ONE);
+                    coverage = coverage > SILK_PATH_COVERAGE_ONE ? 2 * SILK_PATH_COVERAGE_ONE - coverage : coverage;
+                }
+
+                u32 coverage_byte = (coverage * 255 + SILK_PATH_COVERAGE_ONE / 2) / SILK_PATH_COVERAGE_ONE;
+
+#if !defined(SILK_ALPHABLEND_ENABLE)
+
+                // Without the alpha-blending there's no way to draw the partial coverage, so the path is simply aliased
+                coverage_byte = coverage_byte >= 128 ? 255 : 0;
+
+#endif // SILK_ALPHABLEND_ENABLE
+
+                // Coverage only changes where some segment left it's area, so the pixels up to the next one are the same
+                i32 run_end = silkPathNextTouched(row_touched, x + 1, bounds.w);
+
+                if(coverage_byte == 255) {
+                    silkWriteSpan(canvas, bounds.x + x, bounds.y + band + y, run_end - x, pix);
+                } else if(coverage_byte != 0) {
+                    for(i32 i = x; i < run_end; i++) {
+                        silkPlotPixelCoverage(canvas, NULL, bounds.x + i, bounds.y + band + y, pix, coverage_byte);
+                    }
+                }
+
+                x = run_end;
+            }
+
+            memset(row_touched, 0, (size_t) words * sizeof(u32));
+        }
+    }
+
+    SILK_FREE(accumulation);
+    SILK_FREE(touched);
+
+    return SILK_SUCCESS;
+}
+
+// --------------------------------------------------------------------------------------------------------------------------------
+// SECTION MODULE: Command buffer
+// --------------------------------------------------------------------------------------------------------------------------------
+
+SILK_API silk_command_buffer silkLoadCommandBuffer(void) {
+    // Command buffer doesn't allocate anything until the first command is recorded
+    return (silk_command_buffer) { 0 };
+}
+
+SILK_API i32 silkUnloadCommandBuffer(silk_command_buffer* commands) {
+    if(commands == NULL) {
+        silkAssignErrorMessage(SILK_ERR_BUF_INVALID);
+
+        return SILK_FAILURE;
+    }
+
+    SILK_FREE(commands->data);
+
+    *commands = (silk_command_buffer) { 0 };
+
+    return SILK_SUCCESS;
+}
+
+SILK_API i32 silkResetCommandBuffer(silk_command_buffer* commands) {
+    if(commands == NULL) {
+        silkAssignErrorMessage(SILK_ERR_BUF_INVALID);
+
+        return SILK_FAILURE;
+    }
+
+    // Arena is kept, so the buffer recorded every frame stops allocating after the first one
+    commands->size = 0;
+    commands->count = 0;
+
+    return SILK_SUCCESS;
+}
+
+SILK_API i32 silkBeginRecording(silk_canvas* canvas, silk_command_buffer* commands) {
+    if(canvas == NULL || commands == NULL) {
+        silkAssignErrorMessage(SILK_ERR_BUF_INVALID);
+
+        return SILK_FAILURE;
+    }
+
+    canvas->recording = commands;
+
+    return SILK_SUCCESS;
+}
+
+SILK_API i32 silkEndRecording(silk_canvas* canvas) {
+    if(canvas == NULL) {
+        silkAssignErrorMessage(SILK_ERR_BUF_INVALID);
+
+        return SILK_FAILURE;
+    }
+
+    canvas->recording = NULL;
+
+    return SILK_SUCCESS;
+}
+
+SILK_API i32 silkFlush(silk_canvas* canvas, silk_command_buffer* commands) {
+    if(canvas == NULL || commands == NULL) {
+        silkAssignErrorMessage(SILK_ERR_BUF_INVALID);
+
+        return SILK_FAILURE;
+    }
+
+    // Replaying the buffer into itself would never end
+    if(canvas->recording == commands) {
+        silkAssignErrorMessage(SILK_ERR_COMMAND_BUFFER_RECORDING);
+
+        return SILK_FAILURE;
+    }
+
+#if defined(SILK_THREADS_ENABLE)
+    // Commands re-recorded into another buffer have to be appended in order, so that's always done serially
+    if(silk_thread_count > 1 && canvas->recording == NULL && canvas->data != NULL && canvas->size.x > 0 && canvas->size.y > 0) {
+        return silkFlushTiles(canvas, commands);
+    }
+#endif // SILK_THREADS_ENABLE
+
+    // Every command is replayed, even if some of them fail (the last error is kept)
+    i32 result = SILK_SUCCESS;
+
+    for(i64 offset = 0; offset < commands->size; ) {
+        silk_command* command = (silk_command*) (commands->data + offset);
+
+        if(silkReplayCommand(canvas, command) != SILK_SUCCESS) {
+            result = SILK_FAILURE;
+        }
+
+        offset += command->size;
+    }
+
+    return result;
+}
+
+SILK_API i32 silkSetThreadCount(i32 count) {
+    if(count < 1 || count > SILK_MAX_THREADS) {
+        silkAssignErrorMessage(SILK_ERR_OUT_OF_BOUNDS);
+
+        return SILK_FAILURE;
+    }
+
+#if defined(SILK_THREADS_ENABLE)
+    if(count == silk_thread_count) {
+        return SILK_SUCCESS;
+    }
+
+    // Pool is rebuilt from scratch (it's only meant to be resized once in a while, not every frame)
+    silkStopThreads();
+    silk_thread_count = 1;
+
+    for(i32 i = 1; i < count; i++) {
+        if(silkThreadCreate(&silk_pool.threads[i - 1], (void*) (intptr_t) i) != SILK_SUCCESS) {
+            silkAssignErrorMessage(SILK_ERR_THREAD_CREATE_FAIL);
+
+            // Threads started so far are kept
+            return SILK_FAILURE;
+        }
+
+        silk_pool.worker_count++;
+        silk_thread_count++;
+    }
+#else
+    if(count > 1) {
+        silkAssignErrorMessage(SILK_ERR_THREADS_DISABLED);
+
+        return SILK_FAILURE;
+    }
+#endif // SILK_THREADS_ENABLE
+
+    return SILK_SUCCESS;
+}
+
+SILK_API i32 silkGetThreadCount(void) {
+    return silk_thread_count;
+}
+
+// --------------------------------------------------------------------------------------------------------------------------------
+// SECTION MODULE: Frame differencing
+// --------------------------------------------------------------------------------------------------------------------------------
+
+SILK_API silk_frame_diff silkLoadFrameDiff(i32 tile_size) {
+    if(tile_size <= 0) {
+        silkAssignErrorMessage(SILK_ERR_OUT_OF_BOUNDS);
+
+        return (silk_frame_diff) { 0 };
+    }
+
+    // Hashes are allocated by the first 'silkCompareFrame', when the size of the canvas is known
+    return (silk_frame_diff) { .tile_size = tile_size };
+}
+
+SILK_API i32 silkUnloadFrameDiff(silk_frame_diff* diff) {
+    if(diff == NULL) {
+        silkAssignErrorMessage(SILK_ERR_BUF_INVALID);
+
+        return SILK_FAILURE;
+    }
+
+    SILK_FREE(diff->hashes);
+
+    *diff = (silk_frame_diff) { .tile_size = diff->tile_size };
+
+    return SILK_SUCCESS;
+}
+
+SILK_API i32 silkCompareFrame(silk_frame_diff* diff, silk_canvas* canvas) {
+    if(diff == NULL || canvas == NULL || canvas->data == NULL) {
+        silkAssignErrorMessage(SILK_ERR_BUF_INVALID);
+
+        return SILK_FAILURE;
+    }
+
+    if(diff->tile_size <= 0) {
+        silkAssignErrorMessage(SILK_ERR_OUT_OF_BOUNDS);
+
+        return SILK_FAILURE;
+    }
+
+    // First frame (or a resized canvas) has nothing to be compared with, so every tile of it is changed
+    bool first = diff->size.x != canvas->size.x || diff->size.y != canvas->size.y;
+
+    if(first) {
+        vec2i tiles = { (canvas->size.x + diff->tile_size - 1) / diff->tile_size, (canvas->size.y + diff->tile_size - 1) / diff->tile_size };
+        i64 tile_count = (i64) tiles.x * tiles.y;
+        i64 words = (tile_count + 31) / 32;
+
+        // One block: the hashes, followed by the bitmap
+        u64* hashes = (u64*) SILK_REALLOC(diff->hashes, (size_t) tile_count * sizeof(u64) + (size_t) words * sizeof(u32));
+
+        if(hashes == NULL) {
+            silkAssignErrorMessage(SILK_ERR_ALLOCATION_FAIL);
+
+            return SILK_FAILURE;
+        }
+
+        diff->hashes = hashes;
+        diff->changed = (u32*) (hashes + tile_count);
+        diff->size = canvas->size;
+        diff->tiles = tiles;
+    }
+
+    silk_kernel_table* kernels = silkGetKernels();
+    i32 size = silk_pixel_format_sizes[canvas->format];
+
+    memset(diff->changed, 0, (size_t) ((diff->tiles.x * diff->tiles.y + 31) / 32) * sizeof(u32));
+    diff->changed_count = 0;
+
+    for(i32 y = 0; y < diff->tiles.y; y++) {
+        for(i32 x = 0; x < diff->tiles.x; x++) {
+            i32 tile = y * diff->tiles.x + x;
+            i32 width = canvas->size.x - x * diff->tile_size < diff->tile_size ? canvas->size.x - x * diff->tile_size : diff->tile_size;
+            i32 height = canvas->size.y - y * diff->tile_size < diff->tile_size ? canvas->size.y - y * diff->tile_size : diff->tile_size;
+
+            u64 hash = silkHashTile(kernels, silkCanvasAddress(canvas, x * diff->tile_size, y * diff->tile_size), canvas->stride, width * size, height);
+
+            if(first || hash != diff->hashes[tile]) {
+                diff->changed[tile / 32] |= 1u << (tile % 32);
+                diff->changed_count++;
+            }
+
+            diff->hashes[tile] = hash;
+        }
+    }
+
+    return SILK_SUCCESS;
+}
+
+// Returns 1 if the tile was changed by the last compared frame, 0 otherwise
+SILK_API i32 silkTileChanged(silk_frame_diff* diff, vec2i tile) {
+    if(diff == NULL || diff->changed == NULL) {
+        silkAssignErrorMessage(SILK_ERR_BUF_INVALID);
+
+        return 0;
+    }
+
+    if(tile.x < 0 || tile.x >= diff->tiles.x || tile.y < 0 || tile.y >= diff->tiles.y) {
+        silkAssignErrorMessage(SILK_ERR_OUT_OF_BOUNDS);
+
+        return 0;
+    }
+
+    i32 index = tile.y * diff->tiles.x + tile.x;
+
+    return (i32) ((diff->changed[index / 32] >> (index % 32)) & 1);
+}
+
+// --------------------------------------------------------------------------------------------------------------------------------
+// SECTION MODULE: Text Measurements
+// --------------------------------------------------------------------------------------------------------------------------------
+
+SILK_API vec2i silkMeasureText(const char* text, i32 font_size, i32 font_spacing) {
+    return silkMeasureTextBitmap(&silk_default_font, text, font_size, font_spacing);
+}
+
+SILK_API vec2i silkMeasureTextBitmap(const silk_bitmap_font* font, const char* text, i32 font_size, i32 font_spacing) {
+    if(font == NULL || text == NULL) {
+        return (vec2i) { 0 };
+    }
+
+    // Widest line (in glyphs) and the number of the lines, laid out just like 'silkDrawTextBitmap' lays them out
+    i32 columns = 0;
+    i32 lines = silkLayoutTextGrid(text, 0, silkMeasureGlyph, &columns);
+
+    return silkTextGridSize(font, font_size, font_spacing, columns, lines);
+}
+
+// --------------------------------------------------------------------------------------------------------------------------------
+// SECTION MODULE: Text Layout
 // --------------------------------------------------------------------------------------------------------------------------------
 
-SILK_API i32 silkDrawPixel(pixel* buffer, vec2i buf_size, i32 buf_stride, vec2i position, pixel pix) {
-    if(buffer == NULL) {
+SILK_API silk_text_cache silkLoadTextCache(void) {
+    return (silk_text_cache) { 0 };
+}
+
+SILK_API i32 silkUnloadTextCache(silk_text_cache* cache) {
+    if(cache == NULL) {
         silkAssignErrorMessage(SILK_ERR_BUF_INVALID);
 
         return SILK_FAILURE;
     }
 
-    if( (position.x < 0 || position.x >= buf_size.x) ||
-        (position.y < 0 || position.y >= buf_size.y)) {
-        silkAssignErrorMessage(SILK_ERR_BUF_ACCESS_OUT_OF_BOUNDS);
+    for(silk_text_block* block = (silk_text_block*) cache->blocks; block != NULL; ) {
+        silk_text_block* next = block->next;
 
-        return SILK_FAILURE;
+        SILK_FREE(block);
+        block = next;
     }
 
-    // If the pixel from this position is the same as the pixel we want to draw, we can return,
-    // as there won't be any change in this specific position.
-    if(silkGetPixel(buffer, position, buf_stride) == pix) {
-        return SILK_SUCCESS;
-    } 
+    SILK_FREE(cache->entries);
 
-#if defined(SILK_ALPHABLEND_ENABLE)
+    *cache = (silk_text_cache) { 0 };
 
-    pix = silkAlphaBlend(
-        silkGetPixel(buffer, position, buf_stride), 
-        pix, 
-        silkPixelToColor(pix).a
-    );
+    return SILK_SUCCESS;
+}
 
-#endif // SILK_ALPHABLEND_ENABLE
+SILK_API i32 silkResetTextCache(silk_text_cache* cache) {
+    if(cache == NULL) {
+        silkAssignErrorMessage(SILK_ERR_BUF_INVALID);
 
-    silkSetPixel(
-        buffer,
-        position,
-        buf_stride,
-        pix
-    );
+        return SILK_FAILURE;
+    }
+
+    // Blocks are kept, so the cache refilled after the reset doesn't allocate
+    for(silk_text_block* block = (silk_text_block*) cache->blocks; block != NULL; block = block->next) {
+        block->used = 0;
+    }
+
+    if(cache->entries != NULL) {
+        memset(cache->entries, 0, SILK_TEXT_CACHE_SIZE * sizeof(silk_text_cache_entry));
+    }
+
+    cache->count = 0;
 
     return SILK_SUCCESS;
 }
 
-SILK_API i32 silkDrawLine(pixel* buffer, vec2i buf_size, i32 buf_stride, vec2i start, vec2i end, pixel pix) {
-    if(start.x < end.x) {
-        silkVectorSwap(&start, &end);
+SILK_API silk_text_layout silkLayoutText(silk_text_cache* cache, const silk_bitmap_font* font, const char* text, i32 font_size, i32 font_spacing, i32 max_width) {
+    if(cache == NULL || font == NULL || font->rows == NULL || text == NULL) {
+        silkAssignErrorMessage(SILK_ERR_BUF_INVALID);
+
+        return (silk_text_layout) { 0 };
     }
 
-    f32 x = start.x;
-    f32 y = start.y;
+    if(cache->entries == NULL) {
+        cache->entries = SILK_CALLOC(SILK_TEXT_CACHE_SIZE, sizeof(silk_text_cache_entry));
 
-    f32 dx = end.x - start.x;
-    f32 dy = end.y - start.y;
+        if(cache->entries == NULL) {
+            silkAssignErrorMessage(SILK_ERR_ALLOCATION_FAIL);
 
-    f32 steps = fabs(dx) >= fabs(dy) ? fabs(dx) : fabs(dy);
+            return (silk_text_layout) { 0 };
+        }
+    }
 
-    dx /= steps;
-    dy /= steps;
+    u64 hash = silkTextCacheHash(text, font, font_size, font_spacing, max_width);
+    silk_text_cache_entry* entry = &((silk_text_cache_entry*) cache->entries)[hash % SILK_TEXT_CACHE_SIZE];
 
-    for(int i = 0; i <= steps; i++) {
-        silkDrawPixel(buffer, buf_size, buf_stride, (vec2i) { round(x), round(y) } , pix);
-        x += dx;
-        y += dy;
+    if(
+        entry->text != NULL && entry->hash == hash && entry->layout.font == font && entry->layout.font_size == font_size &&
+        entry->layout.font_spacing == font_spacing && entry->max_width == max_width && strcmp(entry->text, text) == 0
+    ) {
+        return entry->layout;
     }
 
-    return SILK_SUCCESS;
-}
+    // Every code point takes at least one byte, so the text never has more glyphs than bytes (the rest is given back)
+    size_t length = strlen(text);
+    silk_text_block* text_block = NULL;
+    silk_text_block* glyph_block = NULL;
 
-SILK_API i32 silkDrawRect(pixel* buffer, vec2i buf_size, i32 buf_stride, vec2i position, vec2i size, pixel pix) {
-    silkDrawRectPro(
-        buffer,
-        buf_size,
-        buf_stride,
-        position,
-        size,
-        (i32) 0,
-        (vec2i) { 0 },
-        pix
-    );
+    char* copy = (char*) silkTextCacheAlloc(cache, (i64) length + 1, &text_block);
+    silk_text_glyph* glyphs = (silk_text_glyph*) silkTextCacheAlloc(cache, (i64) (length * sizeof(silk_text_glyph)), &glyph_block);
 
-    return SILK_SUCCESS;
-}
+    if(copy == NULL || glyphs == NULL) {
+        return (silk_text_layout) { 0 };
+    }
 
-SILK_API i32 silkDrawRectPro(pixel* buffer, vec2i buf_size, i32 buf_stride, vec2i position, vec2i size, i32 angle, vec2i offset, pixel pix) {
-    vec2i points[4] = {
-        { 0 }, // top-left
-        { 0 }, // top_right
-        { 0 }, // bottom_left
-        { 0 }  // bottom_right
+    memcpy(copy, text, length + 1);
+
+    silk_text_store store = {
+        glyphs, 0, 0,
+        { (font->glyph_size.x + font_spacing) * font_size, (font->glyph_size.y + font_spacing) * font_size }
     };
 
-    if(angle == 0) {
-        points[0].x = position.x - offset.x;
-        points[0].y = position.y - offset.y;
+    i32 columns = silkTextGridColumns(font, font_size, font_spacing, max_width);
+    i32 lines = silkLayoutTextGrid(text, columns, silkStoreGridGlyph, &store);
 
-        points[1].x = position.x + size.x - offset.x;
-        points[1].y = position.y - offset.y;
+    glyph_block->used -= (i64) ((length - (size_t) store.count) * sizeof(silk_text_glyph)) & ~(i64) 7;
 
-        points[2].x = position.x - offset.y;
-        points[2].y = position.y + size.y - offset.y;
+    *entry = (silk_text_cache_entry) {
+        hash, copy, max_width,
+        { font, font_size, font_spacing, glyphs, store.count, lines, silkTextGridSize(font, font_size, font_spacing, store.columns, lines) }
+    };
 
-        points[3].x = position.x + size.x - offset.y;
-        points[3].y = position.y + size.y - offset.y;
+    cache->count++;
 
-    } else {
-        vec2i delta = {
-            -offset.x,
-            -offset.y
-        };
+    return entry->layout;
+}
 
-        f32 angle_to_radians = angle * 3.14 / 180;
+SILK_API i32 silkDrawTextLayout(silk_canvas* canvas, const silk_text_layout* layout, vec2i position, pixel pix) {
+    if(canvas != NULL && canvas->recording != NULL && layout != NULL && layout->font != NULL) {
+        silk_command command = silkCommandInit(SILK_COMMAND_TEXT_LAYOUT, pix);
+        command.args.text_layout.font = layout->font;
+        command.args.text_layout.position = position;
+        command.args.text_layout.size = layout->size;
+        command.args.text_layout.font_size = layout->font_size;
+        command.args.text_layout.count = layout->glyph_count;
 
-        points[0].x = position.x + delta.x * cos(angle_to_radians) - delta.y * sin(angle_to_radians);
-        points[0].y = position.y + delta.x * sin(angle_to_radians) + delta.y * cos(angle_to_radians);
+        return silkRecordCommand(canvas, command, layout->glyphs, (i64) layout->glyph_count * (i64) sizeof(silk_text_glyph), NULL, 0);
+    }
 
-        points[1].x = position.x + (delta.x + size.x) * cos(angle_to_radians) - delta.y * sin(angle_to_radians);
-        points[1].y = position.y + (delta.x + size.x) * sin(angle_to_radians) + delta.y * cos(angle_to_radians);
+    if(canvas == NULL || canvas->data == NULL || layout == NULL || layout->font == NULL || layout->font->rows == NULL) {
+        silkAssignErrorMessage(SILK_ERR_BUF_INVALID);
+
+        return SILK_FAILURE;
+    }
 
-        points[2].x = position.x + delta.x * cos(angle_to_radians) - (delta.y + size.y) * sin(angle_to_radians);
-        points[2].y = position.y + delta.x * sin(angle_to_radians) + (delta.y + size.y) * cos(angle_to_radians);
+    const silk_bitmap_font* font = layout->font;
 
-        points[3].x = position.x + (delta.x + size.x) * cos(angle_to_radians) - (delta.y + size.y) * sin(angle_to_radians);
-        points[3].y = position.y + (delta.x + size.x) * sin(angle_to_radians) + (delta.y + size.y) * cos(angle_to_radians);
+    if(font->glyph_size.x <= 0 || font->glyph_size.x > 8 || font->glyph_size.y <= 0) {
+        silkAssignErrorMessage(SILK_ERR_OUT_OF_BOUNDS);
 
+        return SILK_FAILURE;
     }
 
-    // Indices:
-    // 0 - 1 - 2
-    // 1 - 2 - 3
+    if(layout->font_size <= 0 || silkPixelTransparent(canvas, pix)) {
+        return SILK_SUCCESS;
+    }
 
-    silkDrawTriangle(
-        buffer,
-        buf_size,
-        buf_stride,
-        points[0],
-        points[1],
-        points[2],
-        pix
-    );
+    silk_rect clip = silkCanvasClip(canvas);
 
-    silkDrawTriangle(
-        buffer,
-        buf_size,
-        buf_stride,
-        points[1],
-        points[2],
-        points[3],
-        pix
-    );
+    for(i32 i = 0; i < layout->glyph_count; i++) {
+        const silk_text_glyph* glyph = &layout->glyphs[i];
+        vec2i origin = { position.x + glyph->position.x, position.y + glyph->position.y };
+
+        silkDrawBitmapGlyph(canvas, clip, font, glyph->code, origin, layout->font_size, pix);
+    }
 
     return SILK_SUCCESS;
 }
 
-SILK_API i32 silkDrawRectLines(pixel* buffer, vec2i buf_size, i32 buf_stride, vec2i position, vec2i size, i32 angle, vec2i offset, pixel pix) {
-    vec2i points[4] = {
-        { 0 }, // top-left
-        { 0 }, // top_right
-        { 0 }, // bottom_left
-        { 0 }  // bottom_right
-    };
+// --------------------------------------------------------------------------------------------------------------------------------
+// SECTION MODULE: Fonts
+// --------------------------------------------------------------------------------------------------------------------------------
 
-    if(angle == 0) {
-        points[0].x = position.x - offset.x;
-        points[0].y = position.y - offset.y;
+#if defined(SILK_INCLUDE_MODULE_STB_TRUETYPE)
 
-        points[1].x = position.x + size.x - offset.x;
-        points[1].y = position.y - offset.y;
+// Takes the ownership of the 'data' (it's freed on failure as well)
+static silk_font silkCreateFont(u8* data) {
+    silk_font font = { 0 };
+    stbtt_fontinfo* info = (stbtt_fontinfo*) SILK_MALLOC(sizeof(stbtt_fontinfo));
 
-        points[2].x = position.x + size.x - offset.y;
-        points[2].y = position.y + size.y - offset.y;
+    if(info == NULL) {
+        silkAssignErrorMessage(SILK_ERR_ALLOCATION_FAIL);
+        SILK_FREE(data);
 
-        points[3].x = position.x - offset.y;
-        points[3].y = position.y + size.y - offset.y;
+        return font;
+    }
 
-    } else {
-        vec2i delta = {
-            -offset.x,
-            -offset.y
-        };
+    i32 offset = stbtt_GetFontOffsetForIndex(data, 0);
 
-        f32 angle_to_radians = angle * 3.14 / 180;
+    if(offset < 0 || !stbtt_InitFont(info, data, offset)) {
+        silkAssignErrorMessage(SILK_ERR_FONT_LOAD_FAIL);
+        SILK_FREE(info);
+        SILK_FREE(data);
 
-        points[0].x = position.x + delta.x * cos(angle_to_radians) - delta.y * sin(angle_to_radians);
-        points[0].y = position.y + delta.x * sin(angle_to_radians) + delta.y * cos(angle_to_radians);
+        return font;
+    }
 
-        points[1].x = position.x + (delta.x + size.x) * cos(angle_to_radians) - delta.y * sin(angle_to_radians);
-        points[1].y = position.y + (delta.x + size.x) * sin(angle_to_radians) + delta.y * cos(angle_to_radians);
+    font.data = data;
+    font.info = info;
 
-        points[2].x = position.x + (delta.x + size.x) * cos(angle_to_radians) - (delta.y + size.y) * sin(angle_to_radians);
-        points[2].y = position.y + (delta.x + size.x) * sin(angle_to_radians) + (delta.y + size.y) * cos(angle_to_radians);
+    stbtt_GetFontVMetrics(info, &font.ascent, &font.descent, &font.line_gap);
 
-        points[3].x = position.x + delta.x * cos(angle_to_radians) - (delta.y + size.y) * sin(angle_to_radians);
-        points[3].y = position.y + delta.x * sin(angle_to_radians) + (delta.y + size.y) * cos(angle_to_radians);
+    // Id tells the fonts apart in the shared glyph atlas (pointers could be reused by the next font)
+    silkFontLock();
+    font.id = silk_font_atlas.next_font++;
+    silkFontUnlock();
+
+    return font;
+}
+
+#endif // SILK_INCLUDE_MODULE_STB_TRUETYPE
+
+SILK_API silk_font silkLoadFont(const string path) {
+#if defined(SILK_INCLUDE_MODULE_STB_TRUETYPE)
+
+    FILE* file = path != NULL ? fopen(path, "rb") : NULL;
+
+    if(file == NULL) {
+        silkAssignErrorMessage(SILK_ERR_FILE_OPEN_FAIL);
+
+        return (silk_font) { 0 };
     }
 
-    for(i32 i = 0; i < 4; i++) {
-        silkDrawLine(
-            buffer,
-            buf_size,
-            buf_stride,
-            points[i],
-            i + 1 < 4 ? points[i + 1] : points[0],
-            pix
-        );
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    u8* data = size > 0 ? (u8*) SILK_MALLOC((size_t) size) : NULL;
+
+    if(data == NULL || fread(data, 1, (size_t) size, file) != (size_t) size) {
+        // Empty file isn't a font; otherwise either the allocation or the read failed
+        if(size <= 0) {
+            silkAssignErrorMessage(SILK_ERR_FONT_LOAD_FAIL);
+        } else if(data == NULL) {
+            silkAssignErrorMessage(SILK_ERR_ALLOCATION_FAIL);
+        } else {
+            silkAssignErrorMessage(SILK_ERR_FILE_OPEN_FAIL);
+        }
+
+        SILK_FREE(data);
+        fclose(file);
+
+        return (silk_font) { 0 };
     }
-    return SILK_SUCCESS;
+
+    fclose(file);
+
+    return silkCreateFont(data);
+
+#else
+
+    SILK_UNUSED(path)
+    silkAssignErrorMessage(SILK_ERR_MODULE_NOT_INCLUDED);
+
+    return (silk_font) { 0 };
+
+#endif // SILK_INCLUDE_MODULE_STB_TRUETYPE
 }
 
-SILK_API i32 silkDrawCircle(pixel* buffer, vec2i buf_size, i32 buf_stride, vec2i position, i32 radius, pixel pix) {
-    i32 x0 = position.x - radius;
-    i32 x1 = position.x + radius;
+SILK_API silk_font silkLoadFontFromMemory(const u8* data, i32 size) {
+#if defined(SILK_INCLUDE_MODULE_STB_TRUETYPE)
 
-    i32 y0 = position.y - radius;
-    i32 y1 = position.y + radius;
+    if(data == NULL || size <= 0) {
+        silkAssignErrorMessage(SILK_ERR_FONT_INVALID);
 
-    for(i32 y = y0; y < y1; y++) {
-        for(i32 x = x0; x < x1; x++) {
-            vec2i delta = {
-                x - position.x,
-                y - position.y
-            };
+        return (silk_font) { 0 };
+    }
 
-            if((delta.x * delta.x) + (delta.y * delta.y) <= (radius * radius)) {
-                silkDrawPixel(buffer, buf_size, buf_stride, (vec2i) { x, y }, pix);
-            }
-        }
+    // Font keeps it's own copy, so the caller's buffer can be freed right away
+    u8* copy = (u8*) SILK_MALLOC((size_t) size);
+
+    if(copy == NULL) {
+        silkAssignErrorMessage(SILK_ERR_ALLOCATION_FAIL);
+
+        return (silk_font) { 0 };
+    }
+
+    memcpy(copy, data, (size_t) size);
+
+    return silkCreateFont(copy);
+
+#else
+
+    SILK_UNUSED(data)
+    SILK_UNUSED(size)
+    silkAssignErrorMessage(SILK_ERR_MODULE_NOT_INCLUDED);
+
+    return (silk_font) { 0 };
+
+#endif // SILK_INCLUDE_MODULE_STB_TRUETYPE
+}
+
+SILK_API i32 silkUnloadFont(silk_font* font) {
+    if(font == NULL) {
+        silkAssignErrorMessage(SILK_ERR_FONT_INVALID);
+
+        return SILK_FAILURE;
     }
 
+    // Glyphs of the font stay in the atlas until they're evicted (the id is never reused)
+    SILK_FREE(font->data);
+    SILK_FREE(font->info);
+
+    *font = (silk_font) { 0 };
+
     return SILK_SUCCESS;
 }
 
-SILK_API i32 silkDrawCircleLines(pixel* buffer, vec2i buf_size, i32 buf_stride, vec2i position, i32 radius, pixel pix) {
-    // Source:
-    // https://www.geeksforgeeks.org/bresenhams-circle-drawing-algorithm/
+SILK_API i32 silkDrawTextFont(silk_canvas* canvas, silk_font* font, const char* text, vec2i position, i32 font_size, pixel pix) {
+#if defined(SILK_INCLUDE_MODULE_STB_TRUETYPE)
 
-    i32 x = 0;
-    i32 y = radius;
-    i32 d = 3 - 2 * radius;
+    if(canvas != NULL && canvas->recording != NULL && font != NULL && text != NULL) {
+        silk_command command = silkCommandInit(SILK_COMMAND_TEXT_FONT, pix);
+        command.args.text_font.font = font;
+        command.args.text_font.position = position;
+        command.args.text_font.font_size = font_size;
 
-    silkDrawPixel(buffer, buf_size, buf_stride, (vec2i) { position.x + x, position.y + y }, pix);
-    silkDrawPixel(buffer, buf_size, buf_stride, (vec2i) { position.x - x, position.y + y }, pix);
-    silkDrawPixel(buffer, buf_size, buf_stride, (vec2i) { position.x + x, position.y - y }, pix);
-    silkDrawPixel(buffer, buf_size, buf_stride, (vec2i) { position.x - x, position.y - y }, pix);
-    silkDrawPixel(buffer, buf_size, buf_stride, (vec2i) { position.x + y, position.y + x }, pix);
-    silkDrawPixel(buffer, buf_size, buf_stride, (vec2i) { position.x - y, position.y + x }, pix);
-    silkDrawPixel(buffer, buf_size, buf_stride, (vec2i) { position.x + y, position.y - x }, pix);
-    silkDrawPixel(buffer, buf_size, buf_stride, (vec2i) { position.x - y, position.y - x }, pix);
+        return silkRecordCommand(canvas, command, text, (i64) strlen(text) + 1, NULL, 0);
+    }
 
-    while(y >= x) {
-        x++;
+    if(canvas == NULL || canvas->data == NULL) {
+        silkAssignErrorMessage(SILK_ERR_BUF_INVALID);
 
-        if(d > 0) {
-            y--;
-            d += 4 * (x - y) + 10;
-        } else {
-            d += 4 * x + 6;
-        }
+        return SILK_FAILURE;
+    }
+
+    if(font == NULL || font->info == NULL || text == NULL) {
+        silkAssignErrorMessage(SILK_ERR_FONT_INVALID);
+
+        return SILK_FAILURE;
+    }
+
+    if(font_size <= 0 || silkPixelTransparent(canvas, pix)) {
+        return SILK_SUCCESS;
+    }
+
+    return silkFontDrawText(canvas, font, text, position, font_size, pix);
+
+#else
+
+    SILK_UNUSED(canvas)
+    SILK_UNUSED(font)
+    SILK_UNUSED(text)
+    SILK_UNUSED(position)
+    SILK_UNUSED(font_size)
+    SILK_UNUSED(pix)
+    silkAssignErrorMessage(SILK_ERR_MODULE_NOT_INCLUDED);
+
+    return SILK_FAILURE;
+
+#endif // SILK_INCLUDE_MODULE_STB_TRUETYPE
+}
+
+SILK_API vec2i silkMeasureTextFont(silk_font* font, const char* text, i32 font_size) {
+#if defined(SILK_INCLUDE_MODULE_STB_TRUETYPE)
+
+    vec2i extent = { 0 };
+
+    if(font == NULL || font->info == NULL || text == NULL || font_size <= 0) {
+        return extent;
+    }
+
+    // Measured text is laid out into the run cache, so drawing it afterwards is cheap
+    silkFontLock();
+
+    silk_font_run* run = silkFontGetRun(font, text, font_size);
+
+    if(run != NULL) {
+        extent = run->extent;
+        silkFontReleaseRun(run);
+    }
+
+    silkFontUnlock();
+
+    return extent;
+
+#else
+
+    SILK_UNUSED(font)
+    SILK_UNUSED(text)
+    SILK_UNUSED(font_size)
+
+    return (vec2i) { 0 };
+
+#endif // SILK_INCLUDE_MODULE_STB_TRUETYPE
+}
+
+SILK_API i32 silkResetFontCache(void) {
+#if defined(SILK_INCLUDE_MODULE_STB_TRUETYPE)
 
-        silkDrawPixel(buffer, buf_size, buf_stride, (vec2i) { position.x + x, position.y + y }, pix);
-        silkDrawPixel(buffer, buf_size, buf_stride, (vec2i) { position.x - x, position.y + y }, pix);
-        silkDrawPixel(buffer, buf_size, buf_stride, (vec2i) { position.x + x, position.y - y }, pix);
-        silkDrawPixel(buffer, buf_size, buf_stride, (vec2i) { position.x - x, position.y - y }, pix);
-        silkDrawPixel(buffer, buf_size, buf_stride, (vec2i) { position.x + y, position.y + x }, pix);
-        silkDrawPixel(buffer, buf_size, buf_stride, (vec2i) { position.x - y, position.y + x }, pix);
-        silkDrawPixel(buffer, buf_size, buf_stride, (vec2i) { position.x + y, position.y - x }, pix);
-        silkDrawPixel(buffer, buf_size, buf_stride, (vec2i) { position.x - y, position.y - x }, pix);
+    // NOTE: Must not be called while any thread draws the text
+    silkFontLock();
+
+    for(i32 i = 0; i < SILK_FONT_RUN_CACHE_SIZE; i++) {
+        silkFontFreeRun(&silk_font_atlas.runs[i]);
     }
 
+    SILK_FREE(silk_font_atlas.memory);
+
+    silk_font_atlas.memory = NULL;
+    silk_font_atlas.glyphs = NULL;
+    silk_font_atlas.buckets = NULL;
+    silk_font_atlas.pixels = NULL;
+
+    silkFontUnlock();
+
     return SILK_SUCCESS;
+
+#else
+
+    silkAssignErrorMessage(SILK_ERR_MODULE_NOT_INCLUDED);
+
+    return SILK_FAILURE;
+
+#endif // SILK_INCLUDE_MODULE_STB_TRUETYPE
 }
 
-SILK_API i32 silkDrawTriangle(pixel* buffer, vec2i buf_size, i32 buf_stride, vec2i point_a, vec2i point_b, vec2i point_c, pixel pix) {
-    // Source:
-    // https://github.com/tsoding/olive.c/commit/633c657dbea3435a64114570ecb3f703fa276f28
+// --------------------------------------------------------------------------------------------------------------------------------
+// SECTION MODULE: SDF Text
+// --------------------------------------------------------------------------------------------------------------------------------
 
-    if(point_a.y > point_b.y) silkVectorSwap(&point_a, &point_b);
-    if(point_a.y > point_c.y) silkVectorSwap(&point_a, &point_c);
-    if(point_b.y > point_c.y) silkVectorSwap(&point_b, &point_c);
+SILK_API silk_sdf_font silkLoadSDFFontBitmap(const silk_bitmap_font* font) {
+    silk_sdf_font result = { 0 };
+
+    if(font == NULL || font->rows == NULL || font->glyph_count <= 0) {
+        silkAssignErrorMessage(SILK_ERR_BUF_INVALID);
+
+        return result;
+    }
+
+    if(font->glyph_size.x <= 0 || font->glyph_size.x > 8 || font->glyph_size.y <= 0) {
+        silkAssignErrorMessage(SILK_ERR_OUT_OF_BOUNDS);
 
-    vec2i delta_vector_ab = {
-        point_b.x - point_a.x,
-        point_b.y - point_a.y
-    };
+        return result;
+    }
 
-    vec2i delta_vector_ac = {
-        point_c.x - point_a.x,
-        point_c.y - point_a.y
-    };
+    // Glyphs are generated about 'SILK_SDF_GLYPH_SIZE' pixels tall, so one font cell is drawn at the 'font_size' of 1
+    i32 cell = SILK_SDF_GLYPH_SIZE / font->glyph_size.y > 0 ? SILK_SDF_GLYPH_SIZE / font->glyph_size.y : 1;
+    vec2i field_size = { font->glyph_size.x * cell + 2 * SILK_SDF_SPREAD, font->glyph_size.y * cell + 2 * SILK_SDF_SPREAD };
 
-    vec2i delta_vector_cb = {
-        point_b.x - point_c.x,
-        point_b.y - point_c.y
-    };
+    result.glyphs = (silk_sdf_glyph*) SILK_CALLOC((size_t) font->glyph_count, sizeof(silk_sdf_glyph));
+    u8** fields = (u8**) SILK_CALLOC((size_t) font->glyph_count, sizeof(u8*));
 
-    vec2i delta_vector_ca = {
-        point_a.x - point_c.x,
-        point_a.y - point_c.y
-    };
+    if(result.glyphs == NULL || fields == NULL) {
+        silkAssignErrorMessage(SILK_ERR_ALLOCATION_FAIL);
+        SILK_FREE(result.glyphs);
+        SILK_FREE(fields);
 
-    for(i32 y = point_a.y; y < point_b.y; y++) {
-        if(y > 0 && y < SILK_PIXELBUFFER_HEIGHT) {
-            i32 s1 = delta_vector_ab.y != 0 ?
-                (y - point_a.y) * delta_vector_ab.x / delta_vector_ab.y + point_a.x :
-                point_a.x;
+        return (silk_sdf_font) { 0 };
+    }
 
-            i32 s2 = delta_vector_ac.y != 0 ?
-                (y - point_a.y) * delta_vector_ac.x / delta_vector_ac.y + point_a.x :
-                point_a.x;
+    result.glyph_count = font->glyph_count;
+    result.em = (f32) cell;
+    result.line_height = (f32) ((font->glyph_size.y + 1) * cell);
 
-            if(s1 > s2) {
-                silkIntSwap(&s1, &s2);
-            }
+    for(i32 i = 0; i < font->glyph_count; i++) {
+        const u8* rows = font->rows + (size_t) i * font->glyph_size.y;
+        bool empty = true;
 
-            for(i32 x = s1; x <= s2; x++) {
-                silkDrawPixel(buffer, buf_size, buf_stride, (vec2i) { x, y }, pix);
-            }
+        for(i32 y = 0; y < font->glyph_size.y; y++) {
+            empty = empty && rows[y] == 0;
         }
-    }
 
-    for(i32 y = point_b.y; y < point_c.y; y++) {
-        if(y > 0 && y < SILK_PIXELBUFFER_HEIGHT) {
-            i32 s1 = delta_vector_cb.y != 0 ?
-                (y - point_c.y) * delta_vector_cb.x / delta_vector_cb.y + point_c.x :
-                point_c.x;
+        // Glyphs are one cell apart, like the text drawn with the 'font_spacing' of 1
+        result.glyphs[i].advance = (f32) ((font->glyph_size.x + 1) * cell);
 
-            i32 s2 = delta_vector_ca.y != 0 ?
-                (y - point_c.y) * delta_vector_ca.x / delta_vector_ca.y + point_c.x :
-                point_c.x;
+        if(empty) {
+            continue;
+        }
 
-            if(s1 > s2) {
-                silkIntSwap(&s1, &s2);
-            }
+        result.glyphs[i].size = field_size;
+        result.glyphs[i].offset = (vec2f) { (f32) -SILK_SDF_SPREAD, (f32) -SILK_SDF_SPREAD };
+        fields[i] = (u8*) SILK_MALLOC((size_t) field_size.x * field_size.y);
 
-            for(i32 x = s1; x <= s2; x++) {
-                silkDrawPixel(buffer, buf_size, buf_stride, (vec2i) { x, y }, pix);
-            }
+        if(fields[i] != NULL) {
+            silkSDFFromBitmap(rows, font->glyph_size, cell, fields[i], field_size);
         }
     }
 
-    return SILK_SUCCESS;
-}
-
-SILK_API i32 silkDrawTriangleLines(pixel* buffer, vec2i buf_size, i32 buf_stride, vec2i point_a, vec2i point_b, vec2i point_c, pixel pix) {
-    if(point_a.y > point_b.y) silkVectorSwap(&point_a, &point_b);
-    if(point_a.y > point_c.y) silkVectorSwap(&point_a, &point_c);
-    if(point_b.y > point_c.y) silkVectorSwap(&point_b, &point_c);
+    i32 packed = silkSDFPackAtlas(&result, fields);
+    SILK_FREE(fields);
 
-    silkDrawLine(buffer, buf_size, buf_stride, point_a, point_b, pix);
-    silkDrawLine(buffer, buf_size, buf_stride, point_b, point_c, pix);
-    silkDrawLine(buffer, buf_size, buf_stride, point_a, point_c, pix);
+    if(packed != SILK_SUCCESS) {
+        silkUnloadSDFFont(&result);
+    }
 
-    return SILK_SUCCESS;
+    return result;
 }
 
-SILK_API i32 silkDrawTriangleEquilateral(pixel* buffer, vec2i buf_size, i32 buf_stride, vec2i position, i32 radius, i32 angle, pixel pix) {
-    // Source:
-    // https://www.quora.com/How-do-you-calculate-the-triangle-vertices-coordinates-on-a-circumcircle-triangle-with-a-given-centre-point-and-radius-Assuming-the-triangle-is-acute-with-all-equal-length-sides-and-that-one-point-is-straight-up
-
-    if(buffer == NULL) {
-        silkAssignErrorMessage(SILK_ERR_BUF_INVALID);
-
-        return SILK_FAILURE;
-    }
+SILK_API silk_sdf_font silkLoadSDFFont(silk_font* font, u32 first, i32 count) {
+#if defined(SILK_INCLUDE_MODULE_STB_TRUETYPE)
 
-    vec2i points[3] = {
-        { position.x, position.y - radius },                                // point: 0 (top)
-        { position.x - sqrt(3) * radius / 2, position.y + radius / 2 },     // point: 1 (left)
-        { position.x + sqrt(3) * radius / 2, position.y + radius / 2 },     // point: 2 (bottom)
-    };
+    silk_sdf_font result = { 0 };
 
-    // Big thanks to @zet23t for help:
-    // https://twitter.com/zet23t
+    if(font == NULL || font->info == NULL) {
+        silkAssignErrorMessage(SILK_ERR_FONT_INVALID);
 
-    f32 angle_to_radians = angle * 3.14f / 180.0f;
-    f32 x_right = cos(angle_to_radians);
-    f32 y_right = sin(angle_to_radians);
-    f32 x_up = -y_right;
-    f32 y_up = x_right;
+        return result;
+    }
 
-    for(i32 i = 0; i < 3; i++) {
-        f32 dx = points[i].x - position.x;
-        f32 dy = points[i].y - position.y;
+    if(count <= 0 || first > 0x10ffff || (u32) count > 0x110000 - first) {
+        silkAssignErrorMessage(SILK_ERR_OUT_OF_BOUNDS);
 
-        points[i].x = position.x + (x_right * dx + x_up * dy);
-        points[i].y = position.y + (y_right * dx + y_up * dy);
+        return result;
     }
 
-    silkDrawTriangle(buffer, buf_size, buf_stride, points[0], points[1], points[2], pix);
+    const stbtt_fontinfo* info = (const stbtt_fontinfo*) font->info;
+    f32 scale = stbtt_ScaleForPixelHeight(info, (f32) SILK_SDF_GLYPH_SIZE);
 
-    return SILK_SUCCESS;
-}
+    result.glyphs = (silk_sdf_glyph*) SILK_CALLOC((size_t) count, sizeof(silk_sdf_glyph));
+    u8** fields = (u8**) SILK_CALLOC((size_t) count, sizeof(u8*));
 
-SILK_API i32 silkDrawTriangleEquilateralLines(pixel* buffer, vec2i buf_size, i32 buf_stride, vec2i position, i32 radius, i32 angle, pixel pix) {
-    vec2i points[3] = {
-        { position.x, position.y - radius },                                // point: 0 (top)
-        { position.x - sqrt(3) * radius / 2, position.y + radius / 2 },     // point: 1 (left)
-        { position.x + sqrt(3) * radius / 2, position.y + radius / 2 },     // point: 2 (bottom)
-    };
+    if(result.glyphs == NULL || fields == NULL) {
+        silkAssignErrorMessage(SILK_ERR_ALLOCATION_FAIL);
+        SILK_FREE(result.glyphs);
+        SILK_FREE(fields);
 
-    // Big thanks to @zet23t for help:
-    // https://twitter.com/zet23t
+        return (silk_sdf_font) { 0 };
+    }
 
-    f32 angle_to_radians = angle * 3.14f / 180.0f;
-    f32 x_right = cos(angle_to_radians);
-    f32 y_right = sin(angle_to_radians);
-    f32 x_up = -y_right;
-    f32 y_up = x_right;
+    result.first = first;
+    result.glyph_count = count;
+    result.em = (f32) SILK_SDF_GLYPH_SIZE;
+    result.ascent = (f32) font->ascent * scale;
+    result.line_height = (f32) (font->ascent - font->descent + font->line_gap) * scale;
 
-    for(i32 i = 0; i < 3; i++) {
-        f32 dx = points[i].x - position.x;
-        f32 dy = points[i].y - position.y;
+    for(i32 i = 0; i < count; i++) {
+        i32 glyph = stbtt_FindGlyphIndex(info, (int) (first + (u32) i));
+        i32 advance = 0, bearing = 0;
+        i32 width = 0, height = 0, offset_x = 0, offset_y = 0;
 
-        points[i].x = position.x + (x_right * dx + x_up * dy);
-        points[i].y = position.y + (y_right * dx + y_up * dy);
-    }
+        stbtt_GetGlyphHMetrics(info, glyph, &advance, &bearing);
+        result.glyphs[i].advance = (f32) advance * scale;
 
-    silkDrawTriangleLines(buffer, buf_size, buf_stride, points[0], points[1], points[2], pix);
+        // Fields are generated by stb_truetype in the same units: 128 on the edge, 'SILK_SDF_SPREAD' pixels to saturate
+        u8* field = stbtt_GetGlyphSDF(info, scale, glyph, SILK_SDF_SPREAD, 128, 128.0f / SILK_SDF_SPREAD, &width, &height, &offset_x, &offset_y);
 
-    return SILK_SUCCESS;
-}
+        // Glyphs wider than the atlas are left out (they're still advanced over)
+        if(field == NULL || width > SILK_SDF_ATLAS_WIDTH) {
+            stbtt_FreeSDF(field, NULL);
 
-SILK_API i32 silkDrawPolygon(pixel* buffer, vec2i buf_size, i32 buf_stride, vec2i position, i32 radius, i32 angle, i32 n, pixel pix) {
-    if(n < 3) {
-        n = 3;
-    }
-	else if (n > 360) {
-		n = 360;
-	}
+            continue;
+        }
 
-    i32 theta = 360 / n;
-    vec2i points[360];
+        // Copied, as the atlas frees the fields with 'SILK_FREE'
+        result.glyphs[i].size = (vec2i) { width, height };
+        result.glyphs[i].offset = (vec2f) { (f32) offset_x, (f32) offset_y };
+        fields[i] = (u8*) SILK_MALLOC((size_t) width * height);
 
-    // Calculating the positions of each point of our polygon
-    for(i32 i = 0; i < n; i++) {
-        // Equation: https://www.wyzant.com/resources/answers/601887/calculate-point-given-x-y-angle-and-distance
-        points[i] = (vec2i) {
-            .x = position.x + radius * cos(((theta * i) + angle) * 3.14 / 180),
-            .y = position.y + radius * sin(((theta * i) + angle) * 3.14 / 180)
-        };
-    }
+        if(fields[i] != NULL) {
+            memcpy(fields[i], field, (size_t) width * height);
+        }
 
-    // Drawing triangles based on the points
-    for(i32 i = 0; i < n; i++) {
-        silkDrawTriangle(
-            buffer,
-            buf_size,
-            buf_stride,
-            position,                               // First point is always position
-            points[i],                              // second point is based on the current 'i'
-            i < n - 1 ? points[i + 1] : points[0],  // third point is based on the next index from 'i' OR the very first point of the array if we reach it's end
-            pix
-        );
+        stbtt_FreeSDF(field, NULL);
     }
 
-    return SILK_SUCCESS;
-}
+    i32 packed = silkSDFPackAtlas(&result, fields);
+    SILK_FREE(fields);
 
-SILK_API i32 silkDrawStar(pixel* buffer, vec2i buf_size, i32 buf_stride, vec2i position, i32 radius, i32 angle, i32 n, pixel pix) {
-    if(n < 3) {
-        n = 3;
+    if(packed != SILK_SUCCESS) {
+        silkUnloadSDFFont(&result);
     }
 
-    i32 theta = 360 / n;
+    return result;
 
-    // Calculating the positions of each point of our star and rendering it to the screen
-    for(i32 i = 0; i < n; i++) {
-        // Equation: https://www.wyzant.com/resources/answers/601887/calculate-point-given-x-y-angle-and-distance
-        vec2i point_a;
-        vec2i point_b;
-        vec2i point_c;
+#else
 
-        point_a.x = position.x + radius * cos(((theta * i) + angle) * 3.14 / 180);
-        point_a.y = position.y + radius * sin(((theta * i) + angle) * 3.14 / 180);
+    SILK_UNUSED(font)
+    SILK_UNUSED(first)
+    SILK_UNUSED(count)
+    silkAssignErrorMessage(SILK_ERR_MODULE_NOT_INCLUDED);
 
-        point_b.x = position.x + (radius / n * 2) * cos(((theta * i) - 90 + angle) * 3.14 / 180);
-        point_b.y = position.y + (radius / n * 2) * sin(((theta * i) - 90 + angle) * 3.14 / 180);
+    return (silk_sdf_font) { 0 };
 
-        point_c.x = position.x + (radius / n * 2) * cos(((theta * i) + 90 + angle) * 3.14 / 180);
-        point_c.y = position.y + (radius / n * 2) * sin(((theta * i) + 90 + angle) * 3.14 / 180);
+#endif // SILK_INCLUDE_MODULE_STB_TRUETYPE
+}
 
-        silkDrawTriangle(
-            buffer,
-            buf_size,
-            buf_stride,
-            point_a,
-            point_b,
-            point_c,
-            pix
-        );
+SILK_API i32 silkUnloadSDFFont(silk_sdf_font* font) {
+    if(font == NULL) {
+        silkAssignErrorMessage(SILK_ERR_BUF_INVALID);
+
+        return SILK_FAILURE;
     }
 
+    SILK_FREE(font->atlas);
+    SILK_FREE(font->glyphs);
+
+    *font = (silk_sdf_font) { 0 };
 
     return SILK_SUCCESS;
 }
 
-SILK_API i32 silkDrawImage(pixel* buffer, vec2i buf_size, i32 buf_stride, image* img, vec2i position) {
-    if(!img) {
-        silkAssignErrorMessage(SILK_ERR_BUF_IMG_INVALID);
+SILK_API i32 silkDrawTextSDF(silk_canvas* canvas, const silk_sdf_font* font, const char* text, vec2f position, f32 font_size, pixel pix) {
+    if(canvas != NULL && canvas->recording != NULL && font != NULL && text != NULL) {
+        silk_command command = silkCommandInit(SILK_COMMAND_TEXT_SDF, pix);
+        command.args.text_sdf.font = font;
+        command.args.text_sdf.position = position;
+        command.args.text_sdf.font_size = font_size;
 
-        return SILK_FAILURE;
+        return silkRecordCommand(canvas, command, text, (i64) strlen(text) + 1, NULL, 0);
     }
 
-    silkDrawImagePro(
-        buffer,
-        buf_size,
-        buf_stride,
-        img,
-        position,
-        (vec2i) { 0 },
-        img->size,
-        0xffffffff
-    );
+    if(canvas == NULL || canvas->data == NULL || font == NULL || font->atlas == NULL || text == NULL) {
+        silkAssignErrorMessage(SILK_ERR_BUF_INVALID);
 
-    return SILK_SUCCESS;
-}
+        return SILK_FAILURE;
+    }
 
-SILK_API i32 silkDrawImageScaled(pixel* buffer, vec2i buf_size, i32 buf_stride, image* img, vec2i position, vec2i size_dest) {
-    if(!img) {
-        silkAssignErrorMessage(SILK_ERR_BUF_IMG_INVALID);
+    // Text scaled below 1/65536 of the atlas is smaller than a pixel (and out of the sampler's fixed-point range)
+    f32 scale = font_size / font->em;
 
-        return SILK_FAILURE;
+    if(!(scale >= 1.0f / 65536.0f) || scale > 65536.0f || silkPixelTransparent(canvas, pix)) {
+        return SILK_SUCCESS;
     }
 
-    silkDrawImagePro(
-        buffer,
-        buf_size,
-        buf_stride,
-        img,
-        position,
-        (vec2i) { 0 },
-        size_dest,
-        0xffffffff
-    );
+    silk_rect clip = silkCanvasClip(canvas);
+    vec2f pen = { position.x, position.y + font->ascent * scale };
 
-    return SILK_SUCCESS;
-}
+    // Cost of a glyph only depends on the pixels it covers: the field is sampled once per pixel, at any scale
+    for(i32 i = 0; text[i] != '\0'; ) {
+        i32 length = 1;
+        u32 code = silkDecodeUTF8(text + i, &length);
 
-SILK_API i32 silkDrawImagePro(pixel* buffer, vec2i buf_size, i32 buf_stride, image* img, vec2i position, vec2i offset, vec2i size_dest, pixel tint) {
-    if(!img) {
-        silkAssignErrorMessage(SILK_ERR_BUF_IMG_INVALID);
+        i += length;
 
-        return SILK_FAILURE;
-    }
+        if(code == '\n') {
+            pen = (vec2f) { position.x, pen.y + font->line_height * scale };
 
-    for(i32 y = 0; y < size_dest.y; y++) {
-        for(i32 x = 0; x < size_dest.x; x++) {
-            vec2i new_position = {
-                x * img->size.x / size_dest.x,
-                y * img->size.y / size_dest.y
-            };
+            continue;
+        }
 
-            silkDrawPixel(
-                buffer,
-                buf_size,
-                buf_stride,
-                (vec2i) { (position.x - offset.x) + x, (position.y - offset.y) + y },
-                silkPixelTint(
-                    silkGetPixel(
-                        img->data,
-                        new_position,
-                        img->size.x
-                    ),
-                    tint
-                )
-            );
+        if(code < font->first || code - font->first >= (u32) font->glyph_count) {
+            continue;
         }
+
+        const silk_sdf_glyph* glyph = &font->glyphs[code - font->first];
+
+        if(glyph->size.x > 0 && glyph->size.y > 0) {
+            vec2f corner = { pen.x + glyph->offset.x * scale, pen.y + glyph->offset.y * scale };
+
+            silkBlitSDFGlyph(canvas, clip, font, glyph, corner, scale, pix);
+        }
+
+        pen.x += glyph->advance * scale;
     }
 
     return SILK_SUCCESS;
 }
 
-SILK_API i32 silkDrawTextDefault(pixel* buffer, vec2i buf_size, i32 buf_stride, const char* text, vec2i position, i32 font_size, i32 font_spacing, pixel pix) {
-    vec2i glyph_position = {
-        position.x / font_size,
-        position.y / font_size
-    };
+SILK_API vec2f silkMeasureTextSDF(const silk_sdf_font* font, const char* text, f32 font_size) {
+    if(font == NULL || font->glyphs == NULL || text == NULL || !(font->em > 0.0f)) {
+        return (vec2f) { 0 };
+    }
 
-    for(i32 glyph_index = 0; text[glyph_index] != '\0'; glyph_index++) {
-        const char current_char = text[glyph_index];
+    f32 width = 0.0f;
+    f32 pen = 0.0f;
+    i32 lines = 1;
 
-        for(i32 y = 0; y < SILK_DEFAULT_FONT_CHAR_HEIGHT; y++) {
-            for(i32 x = 0; x < SILK_DEFAULT_FONT_CHAR_WIDTH; x++) {
-                if(silk_charset[(size_t)current_char][y][x] == 0) {
-                    continue;
-                }
+    for(i32 i = 0; text[i] != '\0'; ) {
+        i32 length = 1;
+        u32 code = silkDecodeUTF8(text + i, &length);
 
-                silkDrawRect(
-                    buffer,
-                    buf_size,
-                    buf_stride, 
-                    (vec2i) { (glyph_position.x + x) * font_size, (glyph_position.y + y) * font_size }, 
-                    (vec2i) { font_size, font_size }, 
-                    pix
-                );
-            }
-        }
+        i += length;
 
-        glyph_position.x += SILK_DEFAULT_FONT_CHAR_WIDTH + font_spacing;
+        if(code == '\n') {
+            width = pen > width ? pen : width;
+            pen = 0.0f;
+            lines++;
+        } else if(code >= font->first && code - font->first < (u32) font->glyph_count) {
+            pen += font->glyphs[code - font->first].advance;
+        }
     }
 
-    return SILK_SUCCESS;
-}
-
-// --------------------------------------------------------------------------------------------------------------------------------
-// SECTION MODULE: Text Measurements
-// --------------------------------------------------------------------------------------------------------------------------------
+    width = pen > width ? pen : width;
 
-SILK_API vec2i silkMeasureText(const char* text, i32 font_size, i32 font_spacing) {
-    i32 column_count = strlen(text);
-    i32 row_count = 1;
+    f32 scale = font_size / font->em;
 
-    return (vec2i) {
-        SILK_DEFAULT_FONT_CHAR_WIDTH * font_size * column_count + font_size * font_spacing * (column_count - 1),
-        SILK_DEFAULT_FONT_CHAR_HEIGHT * font_size * row_count
-    };
+    return (vec2f) { width * scale, (f32) lines * font->line_height * scale };
 }
 
 // --------------------------------------------------------------------------------------------------------------------------------
@@ -2064,6 +9679,24 @@ SILK_API i32 silkLogAlphaBlendStatus(void) {
     return SILK_SUCCESS;
 }
 
+SILK_API i32 silkLogSimdStatus(void) {
+    u32 features = silkGetSimdFeatures();
+
+    if(features & SILK_SIMD_AVX512) {
+        silkLogInfo("SIMD: AVX-512");
+    } else if(features & SILK_SIMD_AVX2) {
+        silkLogInfo("SIMD: AVX2");
+    } else if(features & SILK_SIMD_SSE2) {
+        silkLogInfo("SIMD: SSE2");
+    } else if(features & SILK_SIMD_NEON) {
+        silkLogInfo("SIMD: NEON");
+    } else {
+        silkLogInfo("SIMD: DISABLED");
+    }
+
+    return SILK_SUCCESS;
+}
+
 SILK_API i32 silkLogByteOrderStatus(void) {
 #if defined(SILK_BYTEORDER_LITTLE_ENDIAN)
 
@@ -2084,6 +9717,20 @@ SILK_API i32 silkLogByteOrderStatus(void) {
     return SILK_SUCCESS;
 }
 
+// --------------------------------------------------------------------------------------------------------------------------------
+// SECTION MODULE: CPU Features
+// --------------------------------------------------------------------------------------------------------------------------------
+
+SILK_API u32 silkGetSimdFeatures(void) {
+    return silkGetKernels()->features;
+}
+
+SILK_API i32 silkSetSimdFeatures(u32 features) {
+    // Features that the CPU doesn't support are simply dropped, so it's safe to pass 'SILK_SIMD_ALL' here.
+    // Useful for benchmarking the kernels against each other (i.e. 'silkSetSimdFeatures(0)' forces the scalar code-paths).
+    return silkInitKernels(features);
+}
+
 // --------------------------------------------------------------------------------------------------------------------------------
 // SECTION MODULE: Math
 // --------------------------------------------------------------------------------------------------------------------------------
@@ -2131,11 +9778,14 @@ SILK_API image silkGenImageColor(vec2i size, pixel pix) {
     result.size = size;
     result.data = (pixel*) SILK_MALLOC(size.x * size.y * sizeof(pixel));
     result.channels = 4;
-    
-    for(i32 i = 0; i < size.x * size.y; i++) {
-        result.data[i] = pix;
+
+    if(result.data == NULL) {
+        silkAssignErrorMessage(SILK_ERR_ALLOCATION_FAIL);
+        return (image) { 0 };
     }
 
+    silkGetKernels()->fill(result.data, size.x * size.y, pix);
+
     return result;
 }
 
@@ -2150,6 +9800,8 @@ SILK_API image silkGenImageCheckerboard(vec2i size, i32 checker_size, pixel a, p
         return (image) { 0 };
     }
 
+    silk_canvas target = silkCanvasFromBuffer(result.data, size, size.x * sizeof(pixel));
+
     for(i32 y = 0; y < size.y; y += checker_size) {
         for(i32 x = 0; x < size.x; x+= checker_size) {
             pixel color = 0;
@@ -2161,9 +9813,7 @@ SILK_API image silkGenImageCheckerboard(vec2i size, i32 checker_size, pixel a, p
             }
 
             silkDrawRect(
-                result.data, 
-                size, 
-                size.x, 
+                &target, 
                 (vec2i) { x, y }, 
                 (vec2i) { checker_size, checker_size }, 
                 color
@@ -2208,6 +9858,79 @@ SILK_API image silkScaleImage(image* source, vec2i dest_size) {
     return result;
 }
 
+SILK_API image silkScaleImageFiltered(image* source, vec2i dest_size) {
+    if(source == NULL || source->data == NULL || source->size.x <= 0 || source->size.y <= 0 || dest_size.x <= 0 || dest_size.y <= 0) {
+        silkAssignErrorMessage(SILK_ERR_BUF_IMG_INVALID);
+
+        return (image) { 0 };
+    }
+
+    image result;
+    result.size = dest_size;
+    result.data = (pixel*) SILK_MALLOC((size_t) dest_size.x * dest_size.y * sizeof(pixel));
+    result.channels = 4;
+
+    if(result.data == NULL) {
+        silkAssignErrorMessage(SILK_ERR_ALLOCATION_FAIL);
+        return (image) { 0 };
+    }
+
+    // Bilinear filtering: the center of every destination pixel is mapped onto the source (16.16 fixed-point) and the four nearest
+    // source pixels are mixed by their distance (8-bit weights). Mixing the straight colors would bleed the color of the transparent
+    // pixels into the edges (the dark fringes), so without 'SILK_PREMULTIPLIED_ALPHA' they're premultiplied here and converted back.
+    for(i32 y = 0; y < dest_size.y; y++) {
+        i64 fy = (((i64) y * 2 + 1) * source->size.y << 16) / ((i64) dest_size.y * 2) - 32768;
+        fy = fy < 0 ? 0 : (fy > (i64) (source->size.y - 1) << 16 ? (i64) (source->size.y - 1) << 16 : fy);
+
+        i32 y0 = (i32) (fy >> 16);
+        i32 y1 = y0 + 1 < source->size.y ? y0 + 1 : y0;
+        u32 weight_y = (u32) (fy >> 8) & 0xff;
+
+        for(i32 x = 0; x < dest_size.x; x++) {
+            i64 fx = (((i64) x * 2 + 1) * source->size.x << 16) / ((i64) dest_size.x * 2) - 32768;
+            fx = fx < 0 ? 0 : (fx > (i64) (source->size.x - 1) << 16 ? (i64) (source->size.x - 1) << 16 : fx);
+
+            i32 x0 = (i32) (fx >> 16);
+            i32 x1 = x0 + 1 < source->size.x ? x0 + 1 : x0;
+            u32 weight_x = (u32) (fx >> 8) & 0xff;
+
+            pixel corners[4] = {
+                source->data[y0 * source->size.x + x0],
+                source->data[y0 * source->size.x + x1],
+                source->data[y1 * source->size.x + x0],
+                source->data[y1 * source->size.x + x1]
+            };
+
+#if !defined(SILK_PREMULTIPLIED_ALPHA)
+
+            for(i32 i = 0; i < 4; i++) {
+                corners[i] = silkPixelPremultiply(corners[i]);
+            }
+
+#endif // SILK_PREMULTIPLIED_ALPHA
+
+            pixel mixed = 0;
+
+            for(i32 shift = 0; shift < 32; shift += 8) {
+                u32 top = ((corners[0] >> shift) & 0xff) * (256 - weight_x) + ((corners[1] >> shift) & 0xff) * weight_x;
+                u32 bottom = ((corners[2] >> shift) & 0xff) * (256 - weight_x) + ((corners[3] >> shift) & 0xff) * weight_x;
+
+                mixed |= ((top * (256 - weight_y) + bottom * weight_y + 32768) >> 16) << shift;
+            }
+
+#if !defined(SILK_PREMULTIPLIED_ALPHA)
+
+            mixed = silkPixelUnpremultiply(mixed);
+
+#endif // SILK_PREMULTIPLIED_ALPHA
+
+            result.data[y * dest_size.x + x] = mixed;
+        }
+    }
+
+    return result;
+}
+
 SILK_API image silkBufferToImage(pixel* buf, vec2i size) {
     if(buf == NULL) {
         silkAssignErrorMessage(SILK_ERR_BUF_INVALID);
@@ -2256,6 +9979,15 @@ SILK_API image silkLoadImage(const string path) {
         return (image) { 0 };
     }
 
+#if defined(SILK_PREMULTIPLIED_ALPHA)
+
+    // Converted once, so the drawing never has to
+    for(i32 i = 0; i < result.size.x * result.size.y; i++) {
+        result.data[i] = silkPixelPremultiply(result.data[i]);
+    }
+
+#endif // SILK_PREMULTIPLIED_ALPHA
+
     silkLogInfo("Image path: %s", path);
     silkLogInfo("Image resolution: x.%i, y.%i", result.size.x, result.size.y);
     silkLogInfo("Image memory size: %i", result.size.x * result.size.y * sizeof(pixel));
@@ -2281,6 +10013,23 @@ SILK_API i32 silkSaveImage(const string path, image* img) {
 #elif defined(SILK_INCLUDE_MODULE_STB_IMAGE_WRITE)
 
     i32 result = 0;
+    pixel* data = img->data;
+
+#if defined(SILK_PREMULTIPLIED_ALPHA)
+
+    // Image files hold the straight colors, so the premultiplied ones are converted into a temporary copy
+    data = (pixel*) SILK_MALLOC((size_t) img->size.x * img->size.y * sizeof(pixel));
+
+    if(data == NULL) {
+        silkAssignErrorMessage(SILK_ERR_ALLOCATION_FAIL);
+        return SILK_FAILURE;
+    }
+
+    for(i32 i = 0; i < img->size.x * img->size.y; i++) {
+        data[i] = silkPixelUnpremultiply(img->data[i]);
+    }
+
+#endif // SILK_PREMULTIPLIED_ALPHA
 
     if(strcmp(silkGetFilePathExtension(path), ".png") == 0) {
         result = stbi_write_png(
@@ -2288,7 +10037,7 @@ SILK_API i32 silkSaveImage(const string path, image* img) {
             img->size.x,
             img->size.y,
             img->channels,
-            img->data,
+            data,
             img->size.x * sizeof(pixel)
         );
     } else if(strcmp(silkGetFilePathExtension(path), ".jpg") == 0) {
@@ -2297,7 +10046,7 @@ SILK_API i32 silkSaveImage(const string path, image* img) {
             img->size.x,
             img->size.y,
             img->channels,
-            img->data,
+            data,
             100
         );
     } else if(strcmp(silkGetFilePathExtension(path), ".bmp") == 0) {
@@ -2306,7 +10055,7 @@ SILK_API i32 silkSaveImage(const string path, image* img) {
             img->size.x,
             img->size.y,
             img->channels,
-            img->data
+            data
         );
     } else if(strcmp(silkGetFilePathExtension(path), ".tga") == 0) {
         result = stbi_write_tga(
@@ -2314,11 +10063,15 @@ SILK_API i32 silkSaveImage(const string path, image* img) {
             img->size.x,
             img->size.y,
             img->channels,
-            img->data
+            data
         );
     } else if(strcmp(silkGetFilePathExtension(path), ".ppm") == 0) {
         FILE* file = fopen(path, "w");
         if(!file) {
+            if(data != img->data) {
+                SILK_FREE(data);
+            }
+
             silkAssignErrorMessage(SILK_ERR_FILE_OPEN_FAIL);
             return SILK_FAILURE;
         }
@@ -2336,6 +10089,11 @@ SILK_API i32 silkSaveImage(const string path, image* img) {
 
         if(ferror(file)) {
             fclose(file);
+
+            if(data != img->data) {
+                SILK_FREE(data);
+            }
+
             return SILK_FAILURE;
         }
 
@@ -2355,6 +10113,11 @@ SILK_API i32 silkSaveImage(const string path, image* img) {
 
             if(ferror(file)) {
                 fclose(file);
+
+                if(data != img->data) {
+                    SILK_FREE(data);
+                }
+
                 return SILK_FAILURE;
             }
         }
@@ -2366,6 +10129,10 @@ SILK_API i32 silkSaveImage(const string path, image* img) {
         result = 0;
     }
 
+    if(data != img->data) {
+        SILK_FREE(data);
+    }
+
     if(result == 0) {
         silkAssignErrorMessage(SILK_ERR_IMAGE_INVALID_FILE_EXT);
         return SILK_FAILURE;